@@ -86,6 +86,7 @@ typedef DELEGATE_S3(void, uint8_t const *, unsigned, unsigned)
 typedef DELEGATE_S3(void, uint16_t, int, uint16_t *) DELEGATE_T3(void, uint16, int, uint16p);
 typedef DELEGATE_S2(void, uint16_t, uint8_t) DELEGATE_T2(void, uint16, uint8);
 typedef DELEGATE_S1(void, uint32_t) DELEGATE_T1(void, uint32);
+typedef DELEGATE_S3(void, uint32_t, int, uint16_t *) DELEGATE_T3(void, uint32, int, uint16p);
 typedef DELEGATE_S1(void, float) DELEGATE_T1(void, float);
 typedef DELEGATE_S2(void, float, float) DELEGATE_T2(void, float, float);
 typedef DELEGATE_S1(void *, void *) DELEGATE_T1(voidp, voidp);
@@ -97,6 +98,8 @@ typedef DELEGATE_S0(unsigned) DELEGATE_T0(unsigned);
 typedef DELEGATE_S1(unsigned, int) DELEGATE_T1(unsigned, int);
 typedef DELEGATE_S1(unsigned, unsigned) DELEGATE_T1(unsigned, unsigned);
 typedef DELEGATE_S1(unsigned, void *) DELEGATE_T1(unsigned, voidp);
+typedef DELEGATE_S5(unsigned, uint16_t, int, uint16_t, int, unsigned)
+	DELEGATE_T5(unsigned, uint16, int, uint16, int, unsigned);
 typedef DELEGATE_S0(uint8_t) DELEGATE_T0(uint8);
 typedef DELEGATE_S2(uint8_t, uint8_t, bool) DELEGATE_T2(uint8, uint8, bool);
 typedef DELEGATE_S1(uint8_t, uint16_t) DELEGATE_T1(uint8, uint16);
@@ -0,0 +1,57 @@
+/** \file
+ *
+ *  \brief Vectorisable kernels.
+ *
+ *  \copyright Copyright 2026 agent
+ *
+ *  \licenseblock This file is part of Portalib.
+ *
+ *  Portalib is free software; you can redistribute it and/or modify it under
+ *  the terms of the GNU Lesser General Public License as published by the Free
+ *  Software Foundation; either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  See COPYING.LGPL and COPYING.GPL for redistribution conditions.
+ *
+ *  \endlicenseblock
+ *
+ *  A "kernel" here is a simple loop over contiguous arrays that is worth
+ *  vectorising.  GCC's default cost model at -O2 leaves most such loops
+ *  scalar, so kernels are built with vectorisation explicitly enabled.
+ *
+ *  Where configure finds that the compiler supports runtime-dispatched
+ *  function clones (which it tests using an AVX2 clone, so in practice only on
+ *  x86), an AVX2 variant of each kernel is also built and selected at runtime.
+ *  Elsewhere, a kernel is compiled once for the baseline target: on AArch64,
+ *  that will use NEON, but on other targets it may well be scalar.
+ *
+ *  Kernels shouldn't depend on either for correctness.  Those using floating
+ *  point may be built without trapping maths, so must not rely on exceptions.
+ */
+
+#ifndef PORTALIB_SIMD_H_
+#define PORTALIB_SIMD_H_
+
+#include "top-config.h"
+
+#ifdef HAVE_FUNC_ATTRIBUTE_TARGET_CLONES
+#define SIMD_KERNEL_CLONES __attribute__((target_clones("avx2","default")))
+#else
+#define SIMD_KERNEL_CLONES
+#endif
+
+// Clang ignores the optimize attribute, but vectorises at -O2 anyway.
+
+#if defined(__GNUC__) && !defined(__clang__)
+#define SIMD_KERNEL_OPTIMIZE __attribute__((optimize("tree-vectorize","vect-cost-model=dynamic","no-trapping-math")))
+#else
+#define SIMD_KERNEL_OPTIMIZE
+#endif
+
+// Declare a (static) kernel function.  Small helpers inlined into kernels
+// should be declared SIMD_KERNEL_OPTIMIZE, as GCC won't inline across
+// differing optimisation options.
+
+#define SIMD_KERNEL static SIMD_KERNEL_CLONES SIMD_KERNEL_OPTIMIZE
+
+#endif
@@ -14,6 +14,9 @@
  *  See COPYING.GPL for redistribution conditions.
  *
  *  \endlicenseblock
+ *
+ *  Where threads are available, a separate thread makes the blocking writes to
+ *  the device, fetching audio from the sound interface's ring.
  */
 
 #include "top-config.h"
@@ -23,6 +26,9 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#ifdef HAVE_PTHREADS
+#include <pthread.h>
+#endif
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -54,10 +60,20 @@ struct ao_alsa_interface {
 	snd_pcm_t *pcm_handle;
 	snd_pcm_uframes_t fragment_nframes;
 	void *audio_buffer;
+
+#ifdef HAVE_PTHREADS
+	bool have_thread;
+	pthread_t thread;
+	pthread_mutex_t mt;
+	bool quit;
+#endif
 };
 
 static void ao_alsa_free(void *sptr);
 static void *ao_alsa_write_buffer(void *sptr, void *buffer);
+#ifdef HAVE_PTHREADS
+static void *writer_thread(void *sptr);
+#endif
 
 static void *new(void *cfg) {
 	(void)cfg;
@@ -242,16 +258,30 @@ static void *new(void *cfg) {
 		errstr = "XRoar internal error";
 		goto failed;
 	}
-	ao->sound_interface->write_buffer = DELEGATE_AS1(voidp, voidp, ao_alsa_write_buffer, ao);
 	LOG_DEBUG(1, "\t%u frags * %ld frames/frag = %ld frames buffer (%ldms)\n", nfragments, aoalsa->fragment_nframes, buffer_nframes, (buffer_nframes * 1000) / rate);
 
-	/* snd_pcm_writei(aoalsa->pcm_handle, buffer, aoalsa->fragment_nframes); */
+#ifdef HAVE_PTHREADS
+	if (sound_ring_enable(ao->sound_interface)) {
+		pthread_mutex_init(&aoalsa->mt, NULL);
+		if (pthread_create(&aoalsa->thread, NULL, writer_thread, aoalsa) != 0) {
+			pthread_mutex_destroy(&aoalsa->mt);
+			errstr = "failed to create writer thread";
+			goto failed;
+		}
+		aoalsa->have_thread = 1;
+		return aoalsa;
+	}
+#endif
+
+	ao->sound_interface->write_buffer = DELEGATE_AS1(voidp, voidp, ao_alsa_write_buffer, ao);
 	return aoalsa;
 
 failed:
 	if (!errstr)
 		errstr = snd_strerror(err);
 	LOG_MOD_ERROR("alsa", "failed to initialise: %s\n", errstr);
+	if (ao->sound_interface)
+		sound_interface_free(ao->sound_interface);
 	if (aoalsa->audio_buffer) {
 		free(aoalsa->audio_buffer);
 	}
@@ -262,6 +292,16 @@ failed:
 static void ao_alsa_free(void *sptr) {
 	struct ao_alsa_interface *aoalsa = sptr;
 
+#ifdef HAVE_PTHREADS
+	if (aoalsa->have_thread) {
+		pthread_mutex_lock(&aoalsa->mt);
+		aoalsa->quit = 1;
+		pthread_mutex_unlock(&aoalsa->mt);
+		pthread_join(aoalsa->thread, NULL);
+		pthread_mutex_destroy(&aoalsa->mt);
+	}
+#endif
+
 	snd_pcm_close(aoalsa->pcm_handle);
 	snd_config_update_free_global();
 	sound_interface_free(aoalsa->public.sound_interface);
@@ -269,14 +309,38 @@ static void ao_alsa_free(void *sptr) {
 	free(aoalsa);
 }
 
-static void *ao_alsa_write_buffer(void *sptr, void *buffer) {
-	struct ao_alsa_interface *aoalsa = sptr;
+// Write a fragment, recovering once from underrun.
 
-	if (!aoalsa->public.sound_interface->ratelimit)
-		return buffer;
+static void write_fragment(struct ao_alsa_interface *aoalsa, void *buffer) {
 	if (snd_pcm_writei(aoalsa->pcm_handle, buffer, aoalsa->fragment_nframes) < 0) {
 		snd_pcm_prepare(aoalsa->pcm_handle);
 		snd_pcm_writei(aoalsa->pcm_handle, buffer, aoalsa->fragment_nframes);
 	}
+}
+
+static void *ao_alsa_write_buffer(void *sptr, void *buffer) {
+	struct ao_alsa_interface *aoalsa = sptr;
+
+	if (!aoalsa->public.sound_interface->ratelimit)
+		return buffer;
+	write_fragment(aoalsa, buffer);
 	return buffer;
 }
+
+#ifdef HAVE_PTHREADS
+
+static void *writer_thread(void *sptr) {
+	struct ao_alsa_interface *aoalsa = sptr;
+	for (;;) {
+		pthread_mutex_lock(&aoalsa->mt);
+		bool quit = aoalsa->quit;
+		pthread_mutex_unlock(&aoalsa->mt);
+		if (quit)
+			break;
+		sound_ring_read(aoalsa->public.sound_interface, aoalsa->audio_buffer, aoalsa->fragment_nframes);
+		write_fragment(aoalsa, aoalsa->audio_buffer);
+	}
+	return NULL;
+}
+
+#endif
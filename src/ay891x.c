@@ -24,6 +24,7 @@
 
 #include "top-config.h"
 
+#include <limits.h>
 #include <stdint.h>
 #include <stdlib.h>
 
@@ -445,6 +446,173 @@ void ay891x_cycle(struct AY891X *psg, bool BDIR, bool BC1, uint8_t *D) {
 	update_reg(psg_, psg_->address);
 }
 
+// Audio is generated in runs.  Most of the time, the output level is constant
+// for many reference ticks: tone periods are long, and channels that are
+// silent or disabled don't contribute changes.  We find the number of ticks
+// until the next state change that can affect the output, feed that constant
+// level through the filter for the whole run, then advance all the generators
+// by the number of ticks elapsed in one step.  Generators that can't affect
+// the output (e.g. noise when no audible channel has it enabled) are still
+// advanced, so their state is exactly as if they'd been stepped per-tick.
+
+// Effectively "never" for run length purposes.
+
+#define NO_EVENT (INT_MAX)
+
+// Number of ticks until a generator counter triggers.  Tone counters trigger
+// when decremented to zero, so a counter already at or below zero (only
+// possible from a bad snapshot) never triggers.
+
+static int tone_event_ticks(int counter) {
+	return (counter >= 1) ? counter : NO_EVENT;
+}
+
+// Noise & envelope counters trigger when decremented to zero or below.
+
+static int counter_event_ticks(int counter) {
+	return (counter >= 1) ? counter : 1;
+}
+
+// Advance a counter by 'nticks', returning the number of times it triggered.
+// 'first' is the number of ticks until it first triggers, as returned by one
+// of the above functions.
+
+static unsigned counter_advance(int *counter, int period, int first, int nticks) {
+	if (nticks < first) {
+		*counter -= nticks;
+		return 0;
+	}
+	int rem = nticks - first;
+	if (period <= 0) {
+		*counter = period;
+		return 1 + rem;
+	}
+	*counter = period - (rem % period);
+	return 1 + (rem / period);
+}
+
+// True if further envelope steps won't change its state.
+
+static bool envelope_is_steady(struct AY891X_ *psg_) {
+	if (psg_->envelope_att) {
+		return psg_->envelope_level == 15 &&
+		       (!psg_->envelope_cont || (psg_->envelope_hold && !psg_->envelope_alt));
+	}
+	return psg_->envelope_level == 0 &&
+	       (!psg_->envelope_cont || (psg_->envelope_hold && !psg_->envelope_alt));
+}
+
+static void envelope_step(struct AY891X_ *psg_) {
+	if (psg_->envelope_att) {
+		if (psg_->envelope_level == 15) {
+			if (psg_->envelope_cont) {
+				if (psg_->envelope_hold) {
+					if (psg_->envelope_alt) {
+						psg_->envelope_level = 0;
+						psg_->envelope_att = 0;
+					} else {
+						psg_->envelope_level = 15;
+					}
+				} else {
+					if (psg_->envelope_alt) {
+						psg_->envelope_att = 0;
+					} else {
+						psg_->envelope_level = 0;
+					}
+				}
+			}
+		} else {
+			psg_->envelope_level++;
+		}
+	} else {
+		if (psg_->envelope_level == 0) {
+			if (psg_->envelope_cont) {
+				if (psg_->envelope_hold) {
+					if (psg_->envelope_alt) {
+						psg_->envelope_level = 15;
+						psg_->envelope_att = 1;
+					} else {
+						psg_->envelope_level = 0;
+					}
+				} else {
+					if (psg_->envelope_alt) {
+						psg_->envelope_att = 1;
+					} else {
+						psg_->envelope_level = 15;
+					}
+				}
+			} else {
+				psg_->envelope_level = 0;
+			}
+		} else {
+			psg_->envelope_level--;
+		}
+	}
+}
+
+// Advance noise and tone generators by 'nticks'.
+
+static void advance_tone_noise(struct AY891X_ *psg_, int nticks) {
+	// noise generator
+	unsigned nsteps = counter_advance(&psg_->noise_counter, psg_->noise_period,
+					  counter_event_ticks(psg_->noise_counter), nticks);
+	if (nsteps > 0) {
+		unsigned lfsr = psg_->noise_lfsr;
+		for (unsigned i = 0; i < nsteps; i++) {
+			// 17-bit LFSR.  According to [deathsoft], shift in bit
+			// is bits 16 and 13 XORed, ORed with what looks like a
+			// parity calculation.  Including the parity gives it
+			// way too short a period, so I've omitted it here, and
+			// the result seems...  noisy.
+			unsigned shift_in = ((lfsr ^ (lfsr >> 3)) & 1) << 16;
+			lfsr = shift_in | (lfsr >> 1);
+		}
+		psg_->noise_lfsr = lfsr;
+		psg_->noise_state = lfsr & 1;
+	}
+
+	// tone generators A, B, C
+	for (int c = 0; c < 3; c++) {
+		int first = tone_event_ticks(psg_->tone_counter[c]);
+		if (first == NO_EVENT) {
+			psg_->tone_counter[c] -= nticks;
+			continue;
+		}
+		unsigned ntoggles = counter_advance(&psg_->tone_counter[c], psg_->tone_period[c],
+						    first, nticks);
+		if (ntoggles & 1) {
+			psg_->tone_state[c] = !psg_->tone_state[c];
+		}
+	}
+}
+
+// Advance envelope generator by 'nticks'.
+
+static void advance_envelope(struct AY891X_ *psg_, int nticks) {
+	unsigned nsteps = counter_advance(&psg_->envelope_counter, psg_->envelope_period,
+					  counter_event_ticks(psg_->envelope_counter), nticks);
+	for (unsigned i = 0; i < nsteps && !envelope_is_steady(psg_); i++) {
+		envelope_step(psg_);
+	}
+}
+
+// Compute channel levels from current state, returning their sum.
+
+static float update_levels(struct AY891X_ *psg_) {
+	for (int c = 0; c < 3; c++) {
+		// mix tone with noise
+		bool state = (psg_->tone_enable[c] && psg_->tone_state[c]) ||
+			      (psg_->noise_state && psg_->noise_enable[c]);
+		if (psg_->envelope_mode[c]) {
+			unsigned level = state ? psg_->envelope_level : 0;
+			psg_->level[c] = amplitude[level];
+		} else {
+			psg_->level[c] = psg_->amplitude[c][state];
+		}
+	}
+	return psg_->level[0] + psg_->level[1] + psg_->level[2];
+}
+
 float ay891x_get_audio(void *sptr, uint32_t tick, int nframes, float *buf) {
 	struct AY891X_ *psg_ = sptr;
 
@@ -463,117 +631,105 @@ float ay891x_get_audio(void *sptr, uint32_t tick, int nframes, float *buf) {
 		psg_->overrun = 0;
 	}
 
-	while (nticks > 0) {
+	// Registers can't change during this call, so determine up front
+	// which generators are able to affect the output.  A channel is
+	// audible if its two states (or the envelope) produce different
+	// levels.
 
-		// framerate will *always* be less than refrate, so this is a
-		// simple test.  allow for 1 overrun sample.
-		psg_->frameerror += psg_->framerate;
-		if (psg_->frameerror >= psg_->refrate) {
-			psg_->frameerror -= psg_->refrate;
-			if (nframes > 0) {
-				if (buf) {
-					*(buf++) = output;
-				}
-				nframes--;
-			} else {
-				psg_->overrun = 1;
-			}
-		}
+	bool tone_audible[3];
+	bool noise_audible = 0;
+	bool envelope_audible = 0;
+	for (int c = 0; c < 3; c++) {
+		bool audible = psg_->envelope_mode[c] || (psg_->amplitude[c][0] != psg_->amplitude[c][1]);
+		tone_audible[c] = audible && psg_->tone_enable[c];
+		noise_audible |= audible && psg_->noise_enable[c];
+		envelope_audible |= psg_->envelope_mode[c];
+	}
 
-		// tickrate may be higher than refrate: calculate remainder.
-		psg_->tickerror += psg_->tickrate;
-		int dtick = psg_->tickerror / psg_->refrate;
-		if (dtick > 0) {
-			nticks -= dtick;
-			psg_->tickerror -= (dtick * psg_->refrate);
-		}
+	// System ticks per reference tick, as whole part & remainder
+	int dtick_base = psg_->tickrate / psg_->refrate;
+	int dtick_rem = psg_->tickrate % psg_->refrate;
 
-		// noise generator
-		psg_->noise_counter--;
-		if (psg_->noise_counter <= 0) {
-			psg_->noise_counter = psg_->noise_period;
-			// 17-bit LFSR.  According to [deathsoft], shift in bit
-			// is bits 16 and 13 XORed, ORed with what looks like a
-			// parity calculation.  Including the parity gives it
-			// way too short a period, so I've omitted it here, and
-			// the result seems...  noisy.
-			unsigned shift_in = ((psg_->noise_lfsr ^ (psg_->noise_lfsr >> 3)) & 1) << 16;
-			psg_->noise_lfsr = shift_in | (psg_->noise_lfsr >> 1);
-			psg_->noise_state = psg_->noise_lfsr & 1;
-		}
+	while (nticks > 0) {
 
-		// tone generators A, B, C
+		// Find run length.  Noise and tone changes affect output on
+		// the tick they occur, envelope changes on the following tick.
+
+		int run = NO_EVENT;
+		if (noise_audible) {
+			run = counter_event_ticks(psg_->noise_counter) - 1;
+		}
 		for (int c = 0; c < 3; c++) {
-			if (--psg_->tone_counter[c] == 0) {
-				psg_->tone_counter[c] = psg_->tone_period[c];
-				psg_->tone_state[c] = !psg_->tone_state[c];
-			}
-			// mix tone with noise
-			bool state = (psg_->tone_enable[c] && psg_->tone_state[c]) ||
-			              (psg_->noise_state && psg_->noise_enable[c]);
-			if (psg_->envelope_mode[c]) {
-				unsigned level = state ? psg_->envelope_level : 0;
-				psg_->level[c] = amplitude[level];
-			} else {
-				psg_->level[c] = psg_->amplitude[c][state];
+			if (tone_audible[c]) {
+				int t = tone_event_ticks(psg_->tone_counter[c]);
+				if (t != NO_EVENT && t - 1 < run)
+					run = t - 1;
 			}
 		}
+		if (envelope_audible && !envelope_is_steady(psg_)) {
+			int t = counter_event_ticks(psg_->envelope_counter);
+			if (t < run)
+				run = t;
+		}
 
-		// envelope
-		psg_->envelope_counter--;
-		if (psg_->envelope_counter <= 0) {
-			psg_->envelope_counter = psg_->envelope_period;
-			if (psg_->envelope_att) {
-				if (psg_->envelope_level == 15) {
-					if (psg_->envelope_cont) {
-						if (psg_->envelope_hold) {
-							if (psg_->envelope_alt) {
-								psg_->envelope_level = 0;
-								psg_->envelope_att = 0;
-							} else {
-								psg_->envelope_level = 15;
-							}
-						} else {
-							if (psg_->envelope_alt) {
-								psg_->envelope_att = 0;
-							} else {
-								psg_->envelope_level = 0;
-							}
-						}
-					}
-				} else {
-					psg_->envelope_level++;
+		bool stepped = (run == 0);
+		if (stepped) {
+			// Change on the very next tick: output level is
+			// computed between tone/noise and envelope updates.
+			run = 1;
+			advance_tone_noise(psg_, 1);
+			new_output = update_levels(psg_);
+			advance_envelope(psg_, 1);
+		} else {
+			new_output = update_levels(psg_);
+		}
+
+		// Filter is only stepped when an output sample is needed, or
+		// at the end of the run.
+
+		int nrun = 0;
+		int nfilter = 0;
+		while (nrun < run && nticks > 0) {
+
+			// framerate will *always* be less than refrate, so
+			// this is a simple test.  allow for 1 overrun sample.
+			psg_->frameerror += psg_->framerate;
+			if (psg_->frameerror >= psg_->refrate) {
+				psg_->frameerror -= psg_->refrate;
+				if (nfilter > 0) {
+					output = filter_iir_apply_n(psg_->filter, new_output, nfilter);
+					nfilter = 0;
 				}
-			} else {
-				if (psg_->envelope_level == 0) {
-					if (psg_->envelope_cont) {
-						if (psg_->envelope_hold) {
-							if (psg_->envelope_alt) {
-								psg_->envelope_level = 15;
-								psg_->envelope_att = 1;
-							} else {
-								psg_->envelope_level = 0;
-							}
-						} else {
-							if (psg_->envelope_alt) {
-								psg_->envelope_att = 1;
-							} else {
-								psg_->envelope_level = 15;
-							}
-						}
-					} else {
-						psg_->envelope_level = 0;
+				if (nframes > 0) {
+					if (buf) {
+						*(buf++) = output;
 					}
+					nframes--;
 				} else {
-					psg_->envelope_level--;
+					psg_->overrun = 1;
 				}
 			}
-		}
 
-		// sum the output channels
-		new_output = psg_->level[0] + psg_->level[1] + psg_->level[2];
+			// tickrate may be higher than refrate: track
+			// remainder.
+			nticks -= dtick_base;
+			psg_->tickerror += dtick_rem;
+			if (psg_->tickerror >= psg_->refrate) {
+				psg_->tickerror -= psg_->refrate;
+				nticks--;
+			}
+
+			nfilter++;
+			nrun++;
+		}
+		if (nfilter > 0) {
+			output = filter_iir_apply_n(psg_->filter, new_output, nfilter);
+		}
 
-		output = filter_iir_apply(psg_->filter, new_output);
+		if (!stepped) {
+			advance_tone_noise(psg_, nrun);
+			advance_envelope(psg_, nrun);
+		}
 	}
 
 	psg_->nticks = nticks;
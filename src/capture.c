@@ -0,0 +1,478 @@
+/** \file
+ *
+ *  \brief Video & audio capture.
+ *
+ *  \copyright Copyright 2026 agent
+ *
+ *  \licenseblock This file is part of XRoar, a Dragon/Tandy CoCo emulator.
+ *
+ *  XRoar is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation, either version 3 of the License, or (at your option) any later
+ *  version.
+ *
+ *  See COPYING.GPL for redistribution conditions.
+ *
+ *  \endlicenseblock
+ */
+
+#include "top-config.h"
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef HAVE_PTHREADS
+#include <pthread.h>
+#endif
+
+#include "delegate.h"
+#include "xalloc.h"
+
+#include "capture.h"
+#include "events.h"
+#include "logging.h"
+#include "sndfile_compat.h"
+#include "sound.h"
+#include "vo.h"
+#include "vo_render.h"
+#include "xconfig.h"
+
+struct xconfig_enum capture_video_fmt_list[] = {
+	{ XC_ENUM_INT("y4m", CAPTURE_VIDEO_Y4M, "YUV4MPEG2") },
+	{ XC_ENUM_INT("rgba", CAPTURE_VIDEO_RGBA, "Raw RGBA") },
+	{ XC_ENUM_END() }
+};
+
+// Number of buffers in the ring.  Video frames and audio chunks share the
+// ring, so this is about a third of a second of data.
+
+#define CAPTURE_NSLOTS (32)
+
+enum capture_slot_type {
+	CAPTURE_SLOT_FRAME,   // video frame, RGB
+	CAPTURE_SLOT_REPEAT,  // repeat previous video frame
+	CAPTURE_SLOT_AUDIO,   // audio chunk, interleaved float
+};
+
+struct capture_slot {
+	enum capture_slot_type type;
+	unsigned nframes;  // audio frames in chunk
+	size_t size;       // allocated size of data
+	void *data;
+};
+
+struct capture {
+	// Video.  Fields used only by the emulator thread:
+	struct vo_interface *vo;
+	event_ticks last_tick;
+	bool have_last_tick;
+	bool have_frame;
+	uint8_t *line;  // scratch line, used if viewport changes size
+	size_t line_size;
+
+	// Video.  Fixed once the first frame is queued:
+	int video_fmt;
+	unsigned w, h;
+	event_ticks frame_ticks;
+	bool is_60hz;
+
+	// Video.  Used only by the writer:
+	FILE *video_file;
+	uint8_t *video_out;  // last frame, converted for output
+	size_t video_out_size;
+
+	// Audio
+	struct sound_interface *snd;
+	char *audio_filename;
+	int audio_rate;
+	int audio_nchannels;
+	SNDFILE *audio_file;  // opened by writer on first chunk
+
+	// Ring.  Slots are filled at 'head' by the emulator and written out
+	// from 'tail' by the writer.
+	struct capture_slot slot[CAPTURE_NSLOTS];
+	unsigned head;
+	unsigned tail;
+	unsigned ndropped;
+
+#ifdef HAVE_PTHREADS
+	bool have_thread;
+	pthread_t thread;
+	pthread_mutex_t mt;
+	pthread_cond_t cv;
+	bool quit;
+	bool writer_waiting;
+#endif
+};
+
+static void capture_frame(void *sptr, bool repeat);
+static void capture_audio(void *sptr, int nframes, int nchannels, const void *data);
+static void write_slot(struct capture *cap, struct capture_slot *s);
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HAVE_PTHREADS
+
+static void *capture_thread(void *sptr) {
+	struct capture *cap = sptr;
+	pthread_mutex_lock(&cap->mt);
+	for (;;) {
+		while (cap->tail == cap->head && !cap->quit) {
+			cap->writer_waiting = 1;
+			pthread_cond_wait(&cap->cv, &cap->mt);
+			cap->writer_waiting = 0;
+		}
+		if (cap->tail == cap->head) {
+			break;
+		}
+		struct capture_slot *s = &cap->slot[cap->tail % CAPTURE_NSLOTS];
+		pthread_mutex_unlock(&cap->mt);
+		write_slot(cap, s);
+		pthread_mutex_lock(&cap->mt);
+		cap->tail++;
+	}
+	pthread_mutex_unlock(&cap->mt);
+	return NULL;
+}
+
+#endif
+
+// Get the slot at 'head' for filling.  Returns NULL if the ring is full, in
+// which case the data is dropped.
+
+static struct capture_slot *claim_slot(struct capture *cap) {
+#ifdef HAVE_PTHREADS
+	if (cap->have_thread) {
+		pthread_mutex_lock(&cap->mt);
+		bool full = (cap->head - cap->tail) >= CAPTURE_NSLOTS;
+		pthread_mutex_unlock(&cap->mt);
+		if (full) {
+			cap->ndropped++;
+			return NULL;
+		}
+	}
+#endif
+	return &cap->slot[cap->head % CAPTURE_NSLOTS];
+}
+
+// Hand a filled slot to the writer.  Without a writer thread, just write it
+// out now.
+
+static void queue_slot(struct capture *cap, struct capture_slot *s) {
+#ifdef HAVE_PTHREADS
+	if (cap->have_thread) {
+		pthread_mutex_lock(&cap->mt);
+		cap->head++;
+		if (cap->writer_waiting) {
+			pthread_cond_signal(&cap->cv);
+		}
+		pthread_mutex_unlock(&cap->mt);
+		return;
+	}
+#endif
+	write_slot(cap, s);
+}
+
+static void *reserve(void *data, size_t *size, size_t nbytes) {
+	if (*size < nbytes) {
+		data = xrealloc(data, nbytes);
+		*size = nbytes;
+	}
+	return data;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+struct capture *capture_new(struct vo_interface *vo, const char *video_filename, int video_fmt,
+			    struct sound_interface *snd, const char *audio_filename) {
+	struct capture *cap = xmalloc(sizeof(*cap));
+	*cap = (struct capture){0};
+
+	if (video_filename) {
+		if (!vo || !vo->renderer) {
+			LOG_MOD_WARN("capture", "no video renderer: not capturing video\n");
+		} else if (!(cap->video_file = fopen(video_filename, "wb"))) {
+			LOG_MOD_WARN("capture", "%s: %s\n", video_filename, strerror(errno));
+		} else {
+			cap->vo = vo;
+			cap->video_fmt = video_fmt;
+		}
+	}
+
+	if (audio_filename) {
+		if (!snd) {
+			LOG_MOD_WARN("capture", "no audio: not capturing audio\n");
+		} else {
+			cap->snd = snd;
+			cap->audio_filename = xstrdup(audio_filename);
+			cap->audio_rate = snd->framerate;
+		}
+	}
+
+	if (!cap->vo && !cap->snd) {
+		if (cap->video_file) {
+			fclose(cap->video_file);
+		}
+		free(cap);
+		return NULL;
+	}
+
+#ifdef HAVE_PTHREADS
+	pthread_mutex_init(&cap->mt, NULL);
+	pthread_cond_init(&cap->cv, NULL);
+	if (pthread_create(&cap->thread, NULL, capture_thread, cap) == 0) {
+		cap->have_thread = 1;
+	} else {
+		LOG_MOD_WARN("capture", "failed to create writer thread\n");
+	}
+#endif
+
+	if (cap->vo) {
+		vo->capture_frame = DELEGATE_AS1(void, bool, capture_frame, cap);
+	}
+	if (cap->snd) {
+		snd->capture = DELEGATE_AS3(void, int, int, cvoidp, capture_audio, cap);
+	}
+
+	return cap;
+}
+
+void capture_free(struct capture *cap) {
+	if (!cap)
+		return;
+
+	if (cap->vo) {
+		cap->vo->capture_frame = DELEGATE_AS1(void, bool, NULL, NULL);
+	}
+	if (cap->snd) {
+		cap->snd->capture = DELEGATE_AS3(void, int, int, cvoidp, NULL, NULL);
+	}
+
+#ifdef HAVE_PTHREADS
+	// Writer drains the ring before exiting
+	if (cap->have_thread) {
+		pthread_mutex_lock(&cap->mt);
+		cap->quit = 1;
+		pthread_cond_signal(&cap->cv);
+		pthread_mutex_unlock(&cap->mt);
+		pthread_join(cap->thread, NULL);
+	}
+	pthread_cond_destroy(&cap->cv);
+	pthread_mutex_destroy(&cap->mt);
+#endif
+
+	if (cap->ndropped > 0) {
+		LOG_MOD_WARN("capture", "%u buffers dropped: output not keeping up\n", cap->ndropped);
+	}
+	if (cap->video_file) {
+		fclose(cap->video_file);
+	}
+	if (cap->audio_file) {
+		sf_close(cap->audio_file);
+	}
+	for (unsigned i = 0; i < CAPTURE_NSLOTS; i++) {
+		free(cap->slot[i].data);
+	}
+	free(cap->line);
+	free(cap->video_out);
+	free(cap->audio_filename);
+	free(cap);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+// Called from vo_vsync() with the frame complete in the renderer's buffer.
+// If the frame was skipped, just ask for the previous one to be repeated.
+
+static void capture_frame(void *sptr, bool repeat) {
+	struct capture *cap = sptr;
+	struct vo_render *vr = cap->vo->renderer;
+
+	// Frame rate is measured from the first two vsyncs
+	event_ticks frame_ticks = event_current_tick - cap->last_tick;
+	cap->last_tick = event_current_tick;
+	if (!cap->have_last_tick) {
+		cap->have_last_tick = 1;
+		return;
+	}
+
+	struct capture_slot *s = claim_slot(cap);
+	if (!s) {
+		return;
+	}
+
+	if (!cap->w) {
+		cap->w = vr->viewport.w;
+		cap->h = vr->viewport.h;
+		cap->frame_ticks = frame_ticks;
+		cap->is_60hz = vr->is_60hz;
+	}
+
+	if (repeat && cap->have_frame) {
+		s->type = CAPTURE_SLOT_REPEAT;
+		queue_slot(cap, s);
+		return;
+	}
+
+	// Frame dimensions are fixed, so if the viewport has changed size,
+	// crop or pad each line.
+	unsigned pitch = cap->w * 3;
+	s->type = CAPTURE_SLOT_FRAME;
+	s->data = reserve(s->data, &s->size, pitch * cap->h);
+	uint8_t *dest = s->data;
+	unsigned vw = vr->viewport.w;
+	unsigned vh = vr->viewport.h;
+	if (vw != cap->w) {
+		cap->line = reserve(cap->line, &cap->line_size, vw * 3);
+	}
+	for (unsigned j = 0; j < cap->h; j++, dest += pitch) {
+		if (j >= vh) {
+			memset(dest, 0, pitch);
+		} else if (vw == cap->w) {
+			vr->line_to_rgb(vr, j, dest);
+		} else {
+			vr->line_to_rgb(vr, j, cap->line);
+			unsigned n = (vw < cap->w) ? vw * 3 : pitch;
+			memcpy(dest, cap->line, n);
+			memset(dest + n, 0, pitch - n);
+		}
+	}
+	cap->have_frame = 1;
+	queue_slot(cap, s);
+}
+
+// Called from the sound module with each buffer of mixed audio
+
+static void capture_audio(void *sptr, int nframes, int nchannels, const void *data) {
+	struct capture *cap = sptr;
+	struct capture_slot *s = claim_slot(cap);
+	if (!s) {
+		return;
+	}
+	cap->audio_nchannels = nchannels;
+	unsigned nsamples = nframes * nchannels;
+	s->type = CAPTURE_SLOT_AUDIO;
+	s->nframes = nframes;
+	s->data = reserve(s->data, &s->size, nsamples * sizeof(float));
+	const float *src = data;
+	float *dest = s->data;
+	for (unsigned i = 0; i < nsamples; i++) {
+		float v = src[i];
+		dest[i] = (v < -1.0f) ? -1.0f : ((v > 1.0f) ? 1.0f : v);
+	}
+	queue_slot(cap, s);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+// Writer.  Runs in the writer thread if available.
+
+static event_ticks gcd(event_ticks a, event_ticks b) {
+	while (b) {
+		event_ticks t = a % b;
+		a = b;
+		b = t;
+	}
+	return a;
+}
+
+// Converts an RGB frame to the output format, doubling lines.  YUV4MPEG2
+// frames are BT.601 limited range, 4:4:4.
+
+static void convert_frame(struct capture *cap, const uint8_t *src) {
+	unsigned w = cap->w;
+	unsigned h = cap->h;
+	unsigned npixels = w * h * 2;
+
+	if (cap->video_fmt == CAPTURE_VIDEO_RGBA) {
+		cap->video_out = reserve(cap->video_out, &cap->video_out_size, npixels * 4);
+		uint8_t *dest = cap->video_out;
+		for (unsigned j = 0; j < h; j++) {
+			uint8_t *line = dest;
+			for (unsigned i = 0; i < w; i++) {
+				*(dest++) = *(src++);
+				*(dest++) = *(src++);
+				*(dest++) = *(src++);
+				*(dest++) = 0xff;
+			}
+			memcpy(dest, line, w * 4);
+			dest += w * 4;
+		}
+		return;
+	}
+
+	cap->video_out = reserve(cap->video_out, &cap->video_out_size, npixels * 3);
+	uint8_t *py = cap->video_out;
+	uint8_t *pu = py + npixels;
+	uint8_t *pv = pu + npixels;
+	for (unsigned j = 0; j < h; j++) {
+		for (unsigned i = 0; i < w; i++) {
+			int r = *(src++);
+			int g = *(src++);
+			int b = *(src++);
+			py[i] = ((66 * r + 129 * g + 25 * b + 128) >> 8) + 16;
+			pu[i] = (-38 * r - 74 * g + 112 * b + 128 + (128 << 8)) >> 8;
+			pv[i] = (112 * r - 94 * g - 18 * b + 128 + (128 << 8)) >> 8;
+		}
+		memcpy(py + w, py, w);
+		memcpy(pu + w, pu, w);
+		memcpy(pv + w, pv, w);
+		py += w * 2;
+		pu += w * 2;
+		pv += w * 2;
+	}
+}
+
+static void write_frame(struct capture *cap) {
+	if (!cap->video_out)
+		return;
+	size_t npixels = (size_t)cap->w * cap->h * 2;
+	if (cap->video_fmt == CAPTURE_VIDEO_RGBA) {
+		fwrite(cap->video_out, 4, npixels, cap->video_file);
+		return;
+	}
+	fputs("FRAME\n", cap->video_file);
+	fwrite(cap->video_out, 3, npixels, cap->video_file);
+}
+
+static void write_slot(struct capture *cap, struct capture_slot *s) {
+	switch (s->type) {
+	case CAPTURE_SLOT_FRAME:
+		if (!cap->video_out && cap->video_fmt == CAPTURE_VIDEO_Y4M) {
+			event_ticks d = gcd(EVENT_TICK_RATE, cap->frame_ticks);
+			fprintf(cap->video_file, "YUV4MPEG2 W%u H%u F%u:%u Ip A%s C444\n",
+				cap->w, cap->h * 2,
+				(unsigned)(EVENT_TICK_RATE / d), (unsigned)(cap->frame_ticks / d),
+				cap->is_60hz ? "6:5" : "1:1");
+		}
+		convert_frame(cap, s->data);
+		write_frame(cap);
+		break;
+
+	case CAPTURE_SLOT_REPEAT:
+		write_frame(cap);
+		break;
+
+	case CAPTURE_SLOT_AUDIO:
+		if (!cap->audio_file && cap->audio_filename) {
+			SF_INFO info = {
+				.samplerate = cap->audio_rate,
+				.channels = cap->audio_nchannels,
+				.format = SF_FORMAT_WAV | SF_FORMAT_PCM_16,
+			};
+			cap->audio_file = sf_open(cap->audio_filename, SFM_WRITE, &info);
+			if (!cap->audio_file) {
+				LOG_MOD_WARN("capture", "%s: %s\n", cap->audio_filename, sf_strerror(NULL));
+			}
+			free(cap->audio_filename);
+			cap->audio_filename = NULL;
+		}
+		if (cap->audio_file) {
+			sf_writef_float(cap->audio_file, s->data, s->nframes);
+		}
+		break;
+	}
+}
@@ -0,0 +1,53 @@
+/** \file
+ *
+ *  \brief Video & audio capture.
+ *
+ *  \copyright Copyright 2026 agent
+ *
+ *  \licenseblock This file is part of XRoar, a Dragon/Tandy CoCo emulator.
+ *
+ *  XRoar is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation, either version 3 of the License, or (at your option) any later
+ *  version.
+ *
+ *  See COPYING.GPL for redistribution conditions.
+ *
+ *  \endlicenseblock
+ *
+ *  Streams every frame from the video renderer to a file (or named pipe) as
+ *  YUV4MPEG2 or raw RGBA, and the audio mix as a WAV file.  Data is copied out
+ *  at vertical sync or audio flush into a bounded ring of buffers, and written
+ *  by a separate thread, so the emulator never waits on the disk.  If the ring
+ *  fills, data is dropped rather than blocking.
+ */
+
+#ifndef XROAR_CAPTURE_H_
+#define XROAR_CAPTURE_H_
+
+#include "xconfig.h"
+
+struct sound_interface;
+struct vo_interface;
+
+enum {
+	CAPTURE_VIDEO_Y4M,
+	CAPTURE_VIDEO_RGBA,
+};
+
+extern struct xconfig_enum capture_video_fmt_list[];
+
+struct capture;
+
+// Start capturing.  Video is captured from 'vo' into 'video_filename', audio
+// from 'snd' into 'audio_filename'.  Either filename may be NULL.  Returns
+// NULL if there is nothing to capture.
+
+struct capture *capture_new(struct vo_interface *vo, const char *video_filename, int video_fmt,
+			    struct sound_interface *snd, const char *audio_filename);
+
+// Flush outstanding data, close files and free capture.
+
+void capture_free(struct capture *);
+
+#endif
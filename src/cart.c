@@ -606,6 +606,7 @@ static struct part *cart_rom_allocate(void) {
 	*c = (struct cart){0};
 
 	cart_rom_init(c);
+	c->decode_only = 1;
 
 	return p;
 }
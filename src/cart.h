@@ -77,6 +77,11 @@ struct cart {
 	// Cartridge asserts this to inhibit usual address decode by host.
 	bool EXTMEM;
 
+	// Set if read() and write() do nothing unless P2 or R2 are asserted,
+	// and EXTMEM is never asserted.  Allows the host to skip the per-cycle
+	// calls for accesses it can resolve itself.
+	bool decode_only;
+
 	// Ways for the cartridge to signal interrupt events to the host.
 	DELEGATE_T1(void, bool) signal_firq;
 	DELEGATE_T1(void, bool) signal_nmi;
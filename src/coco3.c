@@ -142,16 +142,27 @@ struct coco3 {
 	struct ram *RAM;
 
 	struct vo_interface *vo;
-	int frame;  // track frameskip
 	struct sound_interface *snd;
 
 	bool inverted_text;
 	struct cart *cart;
-	unsigned configured_frameskip;
-	unsigned frameskip;
 
 	int cycles;
 
+	// Idle loop detection.  Optional: a known side-effect free delay loop
+	// is fast-forwarded in whole iterations up to the next event.  The
+	// loop period is measured rather than assumed.  'skipped' accumulates
+	// the emulated time saved.
+	struct {
+		bool enabled;
+		uint16_t last_pc[2];
+		uint16_t pc;
+		uint16_t count;
+		event_ticks tick;
+		event_ticks period;
+		event_ticks skipped;
+	} idle_loop;
+
 	// Debug
 	bool single_step;
 	int stop_signal;
@@ -300,7 +311,6 @@ static void coco3_ui_set_picture(void *, int tag, void *smsg);
 static void coco3_ui_set_tv_input(void *, int tag, void *smsg);
 static void coco3_ui_set_text_invert(void *, int tag, void *smsg);
 static void *coco3_get_interface(struct machine *m, const char *ifname);
-static void coco3_ui_set_frameskip(void *, int tag, void *smsg);
 static void coco3_ui_set_ratelimit(void *, int tag, void *smsg);
 
 static uint8_t coco3_read_byte(struct machine *m, unsigned A, uint8_t D);
@@ -336,8 +346,14 @@ static void coco3_print_byte(void *, bool RnW, uint32_t A);
 
 static void cpu_cycle(void *sptr, int ncycles, bool RnW, uint16_t A);
 static void cpu_cycle_noclock(void *sptr, int ncycles, bool RnW, uint16_t A);
+static void cpu_idle_cycles(void *sptr);
+static unsigned cpu_block_transfer(void *sptr, uint16_t src, int src_mod,
+				   uint16_t dest, int dest_mod, unsigned count);
+static void cpu_idle_loop(void *sptr, uint32_t A);
+static void update_instruction_hook(struct coco3 *mcc3);
 static void coco3_instruction_posthook(void *sptr);
 static uint16_t fetch_vram(void *sptr, uint32_t A);
+static void fetch_vram_n(void *sptr, uint32_t A, int nwords, uint16_t *dest);
 
 static void pia0a_data_preread(void *sptr);
 #define pia0a_data_postwrite keyboard_update
@@ -516,7 +532,6 @@ static bool coco3_finish(struct part *p) {
 	ui_messenger_preempt_group(mcc3->msgr_client_id, ui_tag_tv_input, MESSENGER_NOTIFY_DELEGATE(coco3_ui_set_tv_input, mcc3));
 	ui_messenger_preempt_group(mcc3->msgr_client_id, ui_tag_vdg_inverse, MESSENGER_NOTIFY_DELEGATE(coco3_ui_set_text_invert, mcc3));
 	ui_messenger_preempt_group(mcc3->msgr_client_id, ui_tag_keymap, MESSENGER_NOTIFY_DELEGATE(coco3_ui_set_keymap, mcc3));
-	ui_messenger_join_group(mcc3->msgr_client_id, ui_tag_frameskip, MESSENGER_NOTIFY_DELEGATE(coco3_ui_set_frameskip, mcc3));
 	ui_messenger_join_group(mcc3->msgr_client_id, ui_tag_ratelimit, MESSENGER_NOTIFY_DELEGATE(coco3_ui_set_ratelimit, mcc3));
 
 	memcpy(&m->debug.cpu, &mcc3->CPU->debug.cpu, sizeof(m->debug.cpu));
@@ -558,6 +573,7 @@ static bool coco3_finish(struct part *p) {
 
 	mcc3->GIME->cpu_cycle = DELEGATE_AS3(void, int, bool, uint16, cpu_cycle, mcc3);
 	mcc3->GIME->fetch_vram = DELEGATE_AS1(uint16, uint32, fetch_vram, mcc3);
+	mcc3->GIME->fetch_vram_n = DELEGATE_AS3(void, uint32, int, uint16p, fetch_vram_n, mcc3);
 
 	// GIME reports changes in active area
 	mcc3->GIME->set_active_area = mcc3->vo->set_active_area;
@@ -639,6 +655,10 @@ static bool coco3_finish(struct part *p) {
 	// CPU
 
 	mcc3->CPU->mem_cycle = DELEGATE_AS2(void, bool, uint16, tcc1014_mem_cycle, mcc3->GIME);
+	mcc3->CPU->idle_cycles = DELEGATE_AS0(void, cpu_idle_cycles, mcc3);
+	mcc3->CPU->block_transfer = DELEGATE_AS5(unsigned, uint16, int, uint16, int, unsigned, cpu_block_transfer, mcc3);
+	mcc3->idle_loop.enabled = xroar.cfg.idle_skip;
+	update_instruction_hook(mcc3);
 	mcc3->GIME->CPUD = &mcc3->CPU->D;
 
 	// PIAs
@@ -712,6 +732,9 @@ static void coco3_free(struct part *p) {
 	// Stop receiving any UI state updates
 	messenger_client_unregister(mcc3->msgr_client_id);
 	machine_remove_breakpoint_all(&mcc3->public, NULL);
+	if (mcc3->idle_loop.skipped) {
+		LOG_MOD_DEBUG(1, p->partdb->name, "idle loop: skipped %.3fs\n", (double)mcc3->idle_loop.skipped / EVENT_TICK_RATE);
+	}
 	debug_target_free(mcc3->public.debug.target);
 #ifdef WANT_GDB_TARGET
 	if (mcc3->gdb_interface) {
@@ -1065,23 +1088,11 @@ static void *coco3_get_interface(struct machine *m, const char *ifname) {
 	return NULL;
 }
 
-static void coco3_ui_set_frameskip(void *sptr, int tag, void *smsg) {
-	(void)tag;
-	struct coco3 *mp = sptr;
-	struct ui_state_message *uimsg = smsg;
-	mp->configured_frameskip = mp->frameskip = uimsg->value;
-}
-
 static void coco3_ui_set_ratelimit(void *sptr, int tag, void *smsg) {
 	(void)tag;
 	struct coco3 *mp = sptr;
 	struct ui_state_message *uimsg = smsg;
 	sound_set_ratelimit(mp->snd, uimsg->value);
-	if (uimsg->value) {
-		mp->frameskip = mp->configured_frameskip;
-	} else {
-		mp->frameskip = 10;
-	}
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1273,6 +1284,166 @@ static void cpu_cycle_noclock(void *sptr, int ncycles, bool RnW, uint16_t A) {
 	}
 }
 
+// True if CPU cycles can be accounted for in bulk: no cartridge or watchpoint
+// could notice them, and no change in interrupt state is waiting to be picked
+// up by the next cycle.
+
+static bool cpu_cycles_quiet(struct coco3 *mcc3) {
+	if (mcc3->cart && !mcc3->cart->decode_only)
+		return 0;
+#ifdef WANT_GDB_TARGET
+	if (mcc3->watchpoint_set.list[0] || mcc3->watchpoint_set.list[1])
+		return 0;
+#endif
+	return mcc3->CPU->irq == (mcc3->PIA0->a.irq || mcc3->PIA0->b.irq || mcc3->GIME->IRQ) &&
+	       mcc3->CPU->firq == (mcc3->PIA1->a.irq || mcc3->PIA1->b.irq || mcc3->GIME->FIRQ) &&
+	       mcc3->GIME->IL1 == ((PIA_VALUE_A(mcc3->PIA0) | 0x80) != 0xff) &&
+	       tcc1014_il_settled(mcc3->GIME);
+}
+
+// Called by the CPU before each dummy cycle while idle.  Those cycles read the
+// vector ROM, so unless a cartridge or watchpoint might notice, skip straight
+// to the last one before the next event, or before the end of this run.
+
+static void cpu_idle_cycles(void *sptr) {
+	struct coco3 *mcc3 = sptr;
+	if (!cpu_cycles_quiet(mcc3))
+		return;
+	const event_ticks cycle = tcc1014_cycle_ticks(mcc3->GIME);
+	event_ticks next_tick = MACHINE_EVENT_LIST->next_tick;
+	if (next_tick <= event_current_tick + cycle || mcc3->cycles <= (int)cycle)
+		return;
+	event_ticks n = (next_tick - event_current_tick - 1) / cycle;
+	event_ticks nmax = (mcc3->cycles - 1) / cycle;
+	if (n > nmax)
+		n = nmax;
+	mcc3->cycles -= (int)(n * cycle);
+	event_run_queue(MACHINE_EVENT_LIST, n * cycle);
+}
+
+// HD6309 TFM in bulk.  Source and destination must both be plain RAM (no DAT
+// board), as each cycle then takes the same time and has no side effects.
+// Bytes are still copied one at a time in order, so overlapping ranges
+// behave exactly as they would through the CPU.
+
+static unsigned cpu_block_transfer(void *sptr, uint16_t src, int src_mod,
+				   uint16_t dest, int dest_mod, unsigned count) {
+	struct coco3 *mcc3 = sptr;
+	if (mcc3->dat.enabled || !cpu_cycles_quiet(mcc3))
+		return 0;
+	// Read, dummy cycle, write
+	const event_ticks ticks = 3 * tcc1014_cycle_ticks(mcc3->GIME);
+	event_ticks next_tick = MACHINE_EVENT_LIST->next_tick;
+	if (next_tick <= event_current_tick + ticks || mcc3->cycles <= (int)ticks)
+		return 0;
+	event_ticks nmax = (next_tick - event_current_tick - 1) / ticks;
+	event_ticks cmax = (mcc3->cycles - 1) / ticks;
+	if (nmax > cmax)
+		nmax = cmax;
+	if (nmax > count)
+		nmax = count;
+
+	unsigned n;
+	for (n = 0; n < nmax; n++) {
+		unsigned Zs, Zd;
+		if (!tcc1014_decode_ram(mcc3->GIME, src, &Zs) ||
+		    !tcc1014_decode_ram(mcc3->GIME, dest, &Zd))
+			break;
+		uint8_t *ps = ram_a8(mcc3->RAM, 0, Zs, Zs >> 9);
+		uint8_t *pd = ram_a8(mcc3->RAM, 0, Zd, Zd >> 9);
+		if (!ps || !pd)
+			break;
+		mcc3->CPU->D = *pd = *ps;
+		src += src_mod;
+		dest += dest_mod;
+	}
+	if (n) {
+		mcc3->cycles -= (int)(n * ticks);
+		event_run_queue(MACHINE_EVENT_LIST, n * ticks);
+	}
+	return n;
+}
+
+// Idle loop detection, called before each instruction fetch.  Two-instruction
+// loops are checked against the delay loop "LEAX -1,X / BNE *-2" (or using
+// Y), as used by BASIC while it waits in the keyboard scan.  The loop must
+// be fetched from RAM or ROM with no cartridge or watchpoint that might
+// notice.  Once two consecutive iterations have taken the same time, whole
+// iterations are skipped up to the next event, adjusting the count register
+// to match.
+
+static uint16_t *idle_loop_register(struct coco3 *mcc3, uint16_t pc) {
+	if (mcc3->cart && !mcc3->cart->decode_only)
+		return NULL;
+#ifdef WANT_GDB_TARGET
+	if (mcc3->watchpoint_set.list[1])
+		return NULL;
+#endif
+	if (pc > 0xfefc)
+		return NULL;
+	for (unsigned i = 0; i < 4; i++) {
+		unsigned S = tcc1014_decode(mcc3->GIME, pc + i);
+		if (S != 0 && S != 7)
+			return NULL;
+	}
+	uint8_t op[4];
+	uint8_t D = mcc3->CPU->D;
+	for (unsigned i = 0; i < 4; i++) {
+		op[i] = coco3_read_byte(&mcc3->public, pc + i, 0);
+	}
+	mcc3->CPU->D = D;
+	if (op[2] != 0x26 || op[3] != 0xfc)
+		return NULL;
+	if (op[0] == 0x30 && op[1] == 0x1f)
+		return &mcc3->CPU->reg_x;
+	if (op[0] == 0x31 && op[1] == 0x3f)
+		return &mcc3->CPU->reg_y;
+	return NULL;
+}
+
+static void cpu_idle_loop(void *sptr, uint32_t A) {
+	struct coco3 *mcc3 = sptr;
+	struct MC6809 *cpu = mcc3->CPU;
+	uint16_t pc = A;
+	uint16_t pc1 = mcc3->idle_loop.last_pc[0];
+	uint16_t pc2 = mcc3->idle_loop.last_pc[1];
+	mcc3->idle_loop.last_pc[0] = pc;
+	mcc3->idle_loop.last_pc[1] = pc1;
+	if (pc != pc2 || pc1 != (uint16_t)(pc + 2))
+		return;
+	uint16_t *reg = idle_loop_register(mcc3, pc);
+	if (!reg)
+		return;
+
+	uint16_t count = *reg;
+	event_ticks period = event_current_tick - mcc3->idle_loop.tick;
+	bool steady = mcc3->idle_loop.pc == pc && period == mcc3->idle_loop.period &&
+	              count == (uint16_t)(mcc3->idle_loop.count - 1);
+	mcc3->idle_loop.pc = pc;
+	mcc3->idle_loop.period = period;
+
+	if (steady && !logging.trace_cpu && cpu_cycles_quiet(mcc3) &&
+	    !(cpu->nmi || cpu->firq || cpu->irq)) {
+		event_ticks next_tick = MACHINE_EVENT_LIST->next_tick;
+		if (next_tick > event_current_tick + period && mcc3->cycles > (int)period) {
+			event_ticks n = (next_tick - event_current_tick - 1) / period;
+			event_ticks nmax = (mcc3->cycles - 1) / period;
+			if (n > nmax)
+				n = nmax;
+			// Last iteration (count reaching zero) is left to the CPU
+			if (n > (uint16_t)(count - 1))
+				n = (uint16_t)(count - 1);
+			*reg = count - n;
+			mcc3->cycles -= (int)(n * period);
+			event_run_queue(MACHINE_EVENT_LIST, n * period);
+			mcc3->idle_loop.skipped += n * period;
+		}
+	}
+
+	mcc3->idle_loop.count = *reg;
+	mcc3->idle_loop.tick = event_current_tick;
+}
+
 /* Read a byte without advancing clock.  Used for debugging & breakpoints. */
 
 static uint8_t coco3_read_byte(struct machine *m, unsigned A, uint8_t D) {
@@ -1329,16 +1500,24 @@ static void coco3_add_breakpoint(struct machine *m, uint32_t A,
 	if (!bp_breakpoint_add(&mcc3->breakpoint_set, A, handler)) {
 		LOG_MOD_WARN(p->partdb->name, "failed to add breakpoint @ 0x%04x\n", A);
 	}
-	if (mcc3->breakpoint_set.nbreakpoints) {
-		mcc3->CPU->instruction_hook = DELEGATE_AS1(void, uint32, bp_instruction_hook, &mcc3->breakpoint_set);
-	}
+	update_instruction_hook(mcc3);
 }
 
 static void coco3_remove_breakpoint(struct machine *m, int32_t A,
 				    DELEGATE_T2(void, bool, uint32) handler) {
 	struct coco3 *mcc3 = (struct coco3 *)m;
 	bp_breakpoint_remove(&mcc3->breakpoint_set, A, handler);
-	if (!mcc3->breakpoint_set.nbreakpoints) {
+	update_instruction_hook(mcc3);
+}
+
+// Breakpoints take precedence over idle loop detection.
+
+static void update_instruction_hook(struct coco3 *mcc3) {
+	if (mcc3->breakpoint_set.nbreakpoints) {
+		mcc3->CPU->instruction_hook = DELEGATE_AS1(void, uint32, bp_instruction_hook, &mcc3->breakpoint_set);
+	} else if (mcc3->idle_loop.enabled) {
+		mcc3->CPU->instruction_hook = DELEGATE_AS1(void, uint32, cpu_idle_loop, mcc3);
+	} else {
 		mcc3->CPU->instruction_hook.func = NULL;
 	}
 }
@@ -1373,6 +1552,24 @@ static uint16_t fetch_vram(void *sptr, uint32_t A) {
 	return D;
 }
 
+// Video data is contiguous within a RAM row, so copy it a row at a time.  Only
+// a missing bank falls back to fetch_vram() per word.
+
+static void fetch_vram_n(void *sptr, uint32_t A, int nwords, uint16_t *dest) {
+	struct coco3 *mcc3 = sptr;
+	unsigned bank = mcc3->dat.vram_bank >> 6;
+	while (nwords > 0) {
+		unsigned n = ram_read_row_be16(mcc3->RAM, bank, A & ~1, A >> 9, nwords, dest);
+		if (n == 0) {
+			*dest = fetch_vram(sptr, A);
+			n = 1;
+		}
+		A += n * 2;
+		dest += n;
+		nwords -= n;
+	}
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 static void keyboard_update(void *sptr) {
@@ -1465,16 +1662,13 @@ static void gime_fs(void *sptr, bool level) {
 	mc6821_set_cx1(&mcc3->PIA0->b, level);
 	if (level) {
 		sound_update(mcc3->snd);
-		mcc3->frame--;
-		if (mcc3->frame < 0)
-			mcc3->frame = mcc3->frameskip;
-		vo_vsync(mcc3->vo, mcc3->frame == 0);
+		vo_vsync(mcc3->vo);
 	}
 }
 
 static void gime_render_line(void *sptr, unsigned burst, unsigned npixels, uint8_t const *data) {
 	struct coco3 *mcc3 = sptr;
-	DELEGATE_CALL(mcc3->vo->render_line, burst, npixels, data);
+	vo_render_line(mcc3->vo, burst, npixels, data);
 }
 
 // CoCo serial printing ROM hook.
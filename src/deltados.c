@@ -111,6 +111,7 @@ static struct part *deltados_allocate(void) {
 	*d = (struct deltados){0};
 
 	cart_rom_init(c);
+	c->decode_only = 1;
 
 	c->detach = deltados_detach;
 	c->read = deltados_read;
@@ -221,7 +221,6 @@ static void dragon_ui_set_picture(void *, int tag, void *smsg);
 static void dragon_ui_set_tv_input(void *, int tag, void *smsg);
 static void dragon_ui_set_text_invert(void *, int tag, void *smsg);
 static void *dragon_get_interface(struct machine *m, const char *ifname);
-static void dragon_ui_set_frameskip(void *, int tag, void *smsg);
 static void dragon_ui_set_ratelimit(void *, int tag, void *smsg);
 
 static uint8_t dragon_read_byte(struct machine *m, unsigned A, uint8_t D);
@@ -252,6 +251,11 @@ static void vdg_render_line(void *sptr, unsigned burst, unsigned npixels, uint8_
 static void printer_ack(void *sptr, bool ack);
 
 static void cpu_cycle(void *sptr, bool RnW, uint16_t A);
+static void cpu_idle_cycles(void *sptr);
+static unsigned cpu_block_transfer(void *sptr, uint16_t src, int src_mod,
+				   uint16_t dest, int dest_mod, unsigned count);
+static void cpu_idle_loop(void *sptr, uint32_t A);
+static void update_instruction_hook(struct dragon *md);
 static void dragon_instruction_posthook(void *sptr);
 static void vdg_fetch_handler(void *sptr, uint16_t A, int nbytes, uint16_t *dest);
 static void vdg_fetch_handler_chargen(void *sptr, uint16_t A, int nbytes, uint16_t *dest);
@@ -405,7 +409,6 @@ bool dragon_finish_common(struct dragon *md) {
 	ui_messenger_preempt_group(md->msgr_client_id, ui_tag_tv_input, MESSENGER_NOTIFY_DELEGATE(dragon_ui_set_tv_input, md));
 	ui_messenger_preempt_group(md->msgr_client_id, ui_tag_vdg_inverse, MESSENGER_NOTIFY_DELEGATE(dragon_ui_set_text_invert, md));
 	ui_messenger_preempt_group(md->msgr_client_id, ui_tag_keymap, MESSENGER_NOTIFY_DELEGATE(dragon_ui_set_keymap, md));
-	ui_messenger_join_group(md->msgr_client_id, ui_tag_frameskip, MESSENGER_NOTIFY_DELEGATE(dragon_ui_set_frameskip, md));
 	ui_messenger_join_group(md->msgr_client_id, ui_tag_ratelimit, MESSENGER_NOTIFY_DELEGATE(dragon_ui_set_ratelimit, md));
 
 	bool is_dragon32 = strcmp(mc->architecture, "dragon32") == 0;
@@ -463,11 +466,19 @@ bool dragon_finish_common(struct dragon *md) {
 		md->CPU->mem_cycle = DELEGATE_AS2(void, bool, uint16, immunity_cpu_cycle, md->immunity);
 	} else {
 		md->CPU->mem_cycle = DELEGATE_AS2(void, bool, uint16, cpu_cycle, md);
+		md->CPU->idle_cycles = DELEGATE_AS0(void, cpu_idle_cycles, md);
+		md->CPU->block_transfer = DELEGATE_AS5(unsigned, uint16, int, uint16, int, unsigned, cpu_block_transfer, md);
+		md->idle_loop.enabled = xroar.cfg.idle_skip;
 	}
+	update_instruction_hook(md);
 
 	// SAM VDG update handler
 	md->SAM->vdg_update = DELEGATE_AS0(void, mc6847_update, md->VDG);
 
+	// SAM address translation changes invalidate the direct page map
+	md->SAM->map_update = DELEGATE_AS0(void, dragon_page_map_invalidate, md);
+	dragon_page_map_invalidate(md);
+
 	// PIAs
 	md->PIA0->a.data_preread = DELEGATE_AS0(void, pia0a_data_preread, md);
 	md->PIA0->a.data_postwrite = DELEGATE_AS0(void, pia0a_data_postwrite, md);
@@ -645,6 +656,9 @@ void dragon_free_common(struct part *p) {
 	messenger_client_unregister(md->msgr_client_id);
 	bp_breakpoint_remove(&md->breakpoint_set, -1, DELEGATE_AS2(void, bool, uint32, NULL, NULL));  // remove all breakpoints
 	debug_target_free(md->public.debug.target);
+	if (md->idle_loop.skipped) {
+		LOG_MOD_DEBUG(1, p->partdb->name, "idle loop: skipped %.3fs\n", (double)md->idle_loop.skipped / EVENT_TICK_RATE);
+	}
 #ifdef WANT_GDB_TARGET
 	if (md->gdb_interface) {
 		gdb_interface_free(md->gdb_interface);
@@ -788,6 +802,7 @@ static void dragon_connect_cart(struct part *p) {
 	c->signal_firq = DELEGATE_AS1(void, bool, cart_firq, md);
 	c->signal_nmi = DELEGATE_AS1(void, bool, cart_nmi, md);
 	c->signal_halt = DELEGATE_AS1(void, bool, cart_halt, md);
+	dragon_page_map_invalidate(md);
 }
 
 static void dragon_insert_cart(struct machine *m, struct cart *c) {
@@ -800,6 +815,7 @@ static void dragon_remove_cart(struct machine *m) {
 	struct dragon *md = (struct dragon *)m;
 	part_free((struct part *)md->cart);
 	md->cart = NULL;
+	dragon_page_map_invalidate(md);
 }
 
 void dragon_reset(struct machine *m, bool hard) {
@@ -1005,23 +1021,11 @@ static void *dragon_get_interface(struct machine *m, const char *ifname) {
 	return NULL;
 }
 
-static void dragon_ui_set_frameskip(void *sptr, int tag, void *smsg) {
-	(void)tag;
-	struct dragon *md = sptr;
-	struct ui_state_message *uimsg = smsg;
-	md->configured_frameskip = md->frameskip = uimsg->value;
-}
-
 static void dragon_ui_set_ratelimit(void *sptr, int tag, void *smsg) {
 	(void)tag;
 	struct dragon *md = sptr;
 	struct ui_state_message *uimsg = smsg;
 	sound_set_ratelimit(md->snd, uimsg->value);
-	if (uimsg->value) {
-		md->frameskip = md->configured_frameskip;
-	} else {
-		md->frameskip = 10;
-	}
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1039,6 +1043,7 @@ static void dragon_instruction_posthook(void *sptr) {
 
 static void read_byte(struct dragon *md, unsigned A);
 static void write_byte(struct dragon *md, unsigned A);
+static void page_map_update(struct dragon *md, bool RnW, unsigned page);
 
 // Advance clock and run scheduled events
 extern inline void dragon_advance_clock(struct dragon *md, int ncycles);
@@ -1051,6 +1056,20 @@ extern inline void dragon_advance_clock(struct dragon *md, int ncycles);
 static void cpu_cycle(void *sptr, bool RnW, uint16_t A) {
 	struct dragon *md = sptr;
 
+	// Directly mapped page: fixed slow cycle, plain RAM or ROM access
+	uint8_t *p = md->page_map.page[RnW][A >> DRAGON_PAGE_SHIFT];
+	if (p && !md->clock_inhibit) {
+		dragon_advance_clock(md, EVENT_TICKS_14M31818(16));
+		MC6809_IRQ_SET(md->CPU, md->PIA0->a.irq || md->PIA0->b.irq);
+		MC6809_FIRQ_SET(md->CPU, md->PIA1->a.irq || md->PIA1->b.irq);
+		if (RnW) {
+			md->CPU->D = p[A & (DRAGON_PAGE_SIZE - 1)];
+		} else {
+			p[A & (DRAGON_PAGE_SIZE - 1)] = md->CPU->D;
+		}
+		return;
+	}
+
 	// Check watchpoints
 	bp_check_watchpoints(&md->watchpoint_set, RnW, A);
 
@@ -1066,6 +1085,246 @@ static void cpu_cycle(void *sptr, bool RnW, uint16_t A) {
 
 	// Common cycle handling
 	dragon_cpu_cycle(md, RnW, A, md->SAM->Zrow, md->SAM->Zcol);
+
+	// Consider mapping this page if not already done
+	unsigned page = A >> DRAGON_PAGE_SHIFT;
+	if (md->page_map.enabled && md->page_map.page_generation[RnW][page] != md->page_map.generation) {
+		page_map_update(md, RnW, page);
+	}
+}
+
+// True if the CPU's interrupt inputs already reflect the PIAs, i.e. nothing
+// is waiting to be picked up by the next cycle.
+
+static bool cpu_irqs_current(struct dragon *md) {
+	return md->CPU->irq == (md->PIA0->a.irq || md->PIA0->b.irq) &&
+	       md->CPU->firq == (md->PIA1->a.irq || md->PIA1->b.irq);
+}
+
+// Called by the CPU before each dummy cycle while idle.  If those cycles are
+// page mapped (fixed slow rate, no watchpoint), skip straight to the last one
+// before the next event, or before the end of this run.
+
+static void cpu_idle_cycles(void *sptr) {
+	struct dragon *md = sptr;
+	if (!md->page_map.page[1][0xffff >> DRAGON_PAGE_SHIFT] || md->clock_inhibit)
+		return;
+	if (!cpu_irqs_current(md))
+		return;
+	const event_ticks cycle = EVENT_TICKS_14M31818(16);
+	event_ticks next_tick = MACHINE_EVENT_LIST->next_tick;
+	if (next_tick <= event_current_tick + cycle || md->cycles <= (int)cycle)
+		return;
+	event_ticks n = (next_tick - event_current_tick - 1) / cycle;
+	event_ticks nmax = (md->cycles - 1) / cycle;
+	if (n > nmax)
+		n = nmax;
+	dragon_advance_clock(md, (int)(n * cycle));
+}
+
+// HD6309 TFM in bulk.  Source, destination and dummy cycle must all be page
+// mapped, as each cycle then takes a fixed time and has no side effects (nor
+// hits a watchpoint).  Bytes are still copied one at a time in order, so
+// overlapping ranges behave exactly as they would through the CPU.
+
+static unsigned page_run(uint16_t A, int mod, unsigned n) {
+	unsigned left = n;
+	if (mod > 0)
+		left = DRAGON_PAGE_SIZE - (A & (DRAGON_PAGE_SIZE - 1));
+	else if (mod < 0)
+		left = (A & (DRAGON_PAGE_SIZE - 1)) + 1;
+	return (left < n) ? left : n;
+}
+
+static unsigned cpu_block_transfer(void *sptr, uint16_t src, int src_mod,
+				   uint16_t dest, int dest_mod, unsigned count) {
+	struct dragon *md = sptr;
+	if (!md->page_map.page[1][0xffff >> DRAGON_PAGE_SHIFT] || md->clock_inhibit)
+		return 0;
+	if (!cpu_irqs_current(md))
+		return 0;
+	// Read, dummy cycle, write
+	const event_ticks ticks = 3 * EVENT_TICKS_14M31818(16);
+	event_ticks next_tick = MACHINE_EVENT_LIST->next_tick;
+	if (next_tick <= event_current_tick + ticks || md->cycles <= (int)ticks)
+		return 0;
+	event_ticks nmax = (next_tick - event_current_tick - 1) / ticks;
+	event_ticks cmax = (md->cycles - 1) / ticks;
+	if (nmax > cmax)
+		nmax = cmax;
+	if (nmax > count)
+		nmax = count;
+
+	unsigned n = 0;
+	uint8_t D = md->CPU->D;
+	while (n < nmax) {
+		uint8_t *ps = md->page_map.page[1][src >> DRAGON_PAGE_SHIFT];
+		uint8_t *pd = md->page_map.page[0][dest >> DRAGON_PAGE_SHIFT];
+		if (!ps || !pd)
+			break;
+		ps += src & (DRAGON_PAGE_SIZE - 1);
+		pd += dest & (DRAGON_PAGE_SIZE - 1);
+		unsigned run = page_run(src, src_mod, page_run(dest, dest_mod, nmax - n));
+		for (int i = 0; i < (int)run; i++) {
+			D = ps[i * src_mod];
+			pd[i * dest_mod] = D;
+		}
+		src += run * src_mod;
+		dest += run * dest_mod;
+		n += run;
+	}
+	if (n) {
+		md->CPU->D = D;
+		dragon_advance_clock(md, (int)(n * ticks));
+	}
+	return n;
+}
+
+// Idle loop detection, called before each instruction fetch.  Two-instruction
+// loops are checked against the delay loop "LEAX -1,X / BNE *-2" (or using
+// Y), as used by BASIC while it waits in the keyboard scan.  Only fetches
+// from mapped pages are considered, so the loop has no side effects.  Once
+// two consecutive iterations have taken the same time, whole iterations are
+// skipped up to the next event, adjusting the count register to match.  The
+// PIA reads and IRQs that follow happen at exactly the same time.
+
+static uint16_t *idle_loop_register(struct dragon *md, uint16_t pc) {
+	uint8_t op[4];
+	for (unsigned i = 0; i < 4; i++) {
+		uint16_t A = pc + i;
+		uint8_t *p = md->page_map.page[1][A >> DRAGON_PAGE_SHIFT];
+		if (!p)
+			return NULL;
+		op[i] = p[A & (DRAGON_PAGE_SIZE - 1)];
+	}
+	if (op[2] != 0x26 || op[3] != 0xfc)
+		return NULL;
+	if (op[0] == 0x30 && op[1] == 0x1f)
+		return &md->CPU->reg_x;
+	if (op[0] == 0x31 && op[1] == 0x3f)
+		return &md->CPU->reg_y;
+	return NULL;
+}
+
+static void cpu_idle_loop(void *sptr, uint32_t A) {
+	struct dragon *md = sptr;
+	struct MC6809 *cpu = md->CPU;
+	uint16_t pc = A;
+	uint16_t pc1 = md->idle_loop.last_pc[0];
+	uint16_t pc2 = md->idle_loop.last_pc[1];
+	md->idle_loop.last_pc[0] = pc;
+	md->idle_loop.last_pc[1] = pc1;
+	if (pc != pc2 || pc1 != (uint16_t)(pc + 2))
+		return;
+	uint16_t *reg = idle_loop_register(md, pc);
+	if (!reg)
+		return;
+
+	uint16_t count = *reg;
+	event_ticks period = event_current_tick - md->idle_loop.tick;
+	bool steady = md->idle_loop.pc == pc && period == md->idle_loop.period &&
+	              count == (uint16_t)(md->idle_loop.count - 1);
+	md->idle_loop.pc = pc;
+	md->idle_loop.period = period;
+
+	if (steady && !logging.trace_cpu && !md->clock_inhibit &&
+	    md->page_map.page[1][0xffff >> DRAGON_PAGE_SHIFT] &&
+	    cpu_irqs_current(md) && !(cpu->nmi || cpu->firq || cpu->irq)) {
+		event_ticks next_tick = MACHINE_EVENT_LIST->next_tick;
+		if (next_tick > event_current_tick + period && md->cycles > (int)period) {
+			event_ticks n = (next_tick - event_current_tick - 1) / period;
+			event_ticks nmax = (md->cycles - 1) / period;
+			if (n > nmax)
+				n = nmax;
+			// Last iteration (count reaching zero) is left to the CPU
+			if (n > (uint16_t)(count - 1))
+				n = (uint16_t)(count - 1);
+			*reg = count - n;
+			dragon_advance_clock(md, (int)(n * period));
+			md->idle_loop.skipped += n * period;
+		}
+	}
+
+	md->idle_loop.count = *reg;
+	md->idle_loop.tick = event_current_tick;
+}
+
+// Host pointer for a CPU access to one address, if it is a plain RAM or ROM
+// access with no other side effects, else NULL.
+
+static uint8_t *page_map_a8(struct dragon *md, bool RnW, uint16_t A) {
+	struct MC6883_decode d;
+	if (!md->SAM->map_decode(md->SAM, RnW, A, &d))
+		return NULL;
+	if (d.RAS0 == d.RAS1)
+		return NULL;
+	if (RnW) {
+		if (d.S == 0 && d.nWE) {
+			return ram_a8(md->RAM, d.RAS1 ? 1 : 0, d.Zrow, d.Zcol);
+		}
+		return NULL;
+	}
+	// Writes that end up only in RAM: write_byte() does nothing for S=7,
+	// nor for S<4 unless unexpanded
+	if (!d.nWE && (d.S == 7 || (!(d.S & 4) && !md->unexpanded_dragon32))) {
+		return ram_a8(md->RAM, d.RAS1 ? 1 : 0, d.Zrow, d.Zcol);
+	}
+	return NULL;
+}
+
+static uint8_t *page_map_rom_a8(struct dragon *md, uint16_t A) {
+	struct MC6883_decode d;
+	if (!md->SAM->map_decode(md->SAM, 1, A, &d))
+		return NULL;
+	if (d.RAS0 || d.RAS1 || (d.S != 1 && d.S != 2))
+		return NULL;
+	struct rombank *rom = md->ROM0;
+	if (md->read_byte) {
+		rom = md->map_rom ? md->map_rom(md) : NULL;
+	}
+	return rom ? rombank_a8(rom, A) : NULL;
+}
+
+// Try to map a page.  Only succeeds if every address within it resolves to
+// consecutive host memory and no watchpoint covers any of it.
+
+static void page_map_update(struct dragon *md, bool RnW, unsigned page) {
+	md->page_map.page_generation[RnW][page] = md->page_map.generation;
+
+	uint16_t Abase = page << DRAGON_PAGE_SHIFT;
+	uint16_t Aend = Abase + DRAGON_PAGE_SIZE - 1;
+	for (struct bp_watchpoint *wp = md->watchpoint_set.list[RnW]; wp; wp = wp->next) {
+		if (wp->Astart <= Aend && wp->Aend >= Abase)
+			return;
+	}
+
+	uint8_t *(*a8)(struct dragon *, uint16_t) = NULL;
+	uint8_t *p = page_map_a8(md, RnW, Abase);
+	if (!p && RnW) {
+		p = page_map_rom_a8(md, Abase);
+		a8 = page_map_rom_a8;
+	}
+	if (!p)
+		return;
+
+	for (unsigned i = 1; i < DRAGON_PAGE_SIZE; i++) {
+		uint16_t A = Abase + i;
+		uint8_t *pi = a8 ? a8(md, A) : page_map_a8(md, RnW, A);
+		if (pi != p + i)
+			return;
+	}
+	md->page_map.page[RnW][page] = p;
+}
+
+void dragon_page_map_invalidate(void *sptr) {
+	struct dragon *md = sptr;
+	memset(md->page_map.page, 0, sizeof(md->page_map.page));
+	if (++md->page_map.generation == 0) {
+		memset(md->page_map.page_generation, 0, sizeof(md->page_map.page_generation));
+		md->page_map.generation = 1;
+	}
+	md->page_map.enabled = md->SAM && md->SAM->map_decode &&
+		(!md->cart || md->cart->decode_only);
 }
 
 // Common routine called by cpu_cycle() (or override) to access RAM and devices
@@ -1308,16 +1567,24 @@ static void dragon_add_breakpoint(struct machine *m, uint32_t A,
 	if (!bp_breakpoint_add(&md->breakpoint_set, A, handler)) {
 		LOG_MOD_WARN(p->partdb->name, "failed to add breakpoint @ 0x%04x\n", A);
 	}
-	if (md->breakpoint_set.nbreakpoints) {
-		md->CPU->instruction_hook = DELEGATE_AS1(void, uint32, bp_instruction_hook, &md->breakpoint_set);
-	}
+	update_instruction_hook(md);
 }
 
 static void dragon_remove_breakpoint(struct machine *m, int32_t A,
 				     DELEGATE_T2(void, bool, uint32) handler) {
 	struct dragon *md = (struct dragon *)m;
 	bp_breakpoint_remove(&md->breakpoint_set, A, handler);
-	if (!md->breakpoint_set.nbreakpoints) {
+	update_instruction_hook(md);
+}
+
+// Breakpoints take precedence over idle loop detection.
+
+static void update_instruction_hook(struct dragon *md) {
+	if (md->breakpoint_set.nbreakpoints) {
+		md->CPU->instruction_hook = DELEGATE_AS1(void, uint32, bp_instruction_hook, &md->breakpoint_set);
+	} else if (md->idle_loop.enabled) {
+		md->CPU->instruction_hook = DELEGATE_AS1(void, uint32, cpu_idle_loop, md);
+	} else {
 		md->CPU->instruction_hook.func = NULL;
 	}
 }
@@ -1330,6 +1597,7 @@ static void dragon_add_watchpoint(struct machine *m, bool RnW,
 	if (!bp_watchpoint_add(&md->watchpoint_set, RnW, Astart, Aend, handler)) {
 		LOG_MOD_WARN(p->partdb->name, "failed to add watchpoint @ 0x%04x-0x%04x\n", Astart, Aend);
 	}
+	dragon_page_map_invalidate(md);
 }
 
 static void dragon_remove_watchpoint(struct machine *m, int RnW,
@@ -1337,6 +1605,7 @@ static void dragon_remove_watchpoint(struct machine *m, int RnW,
 				     DELEGATE_T2(void, bool, uint32) handler) {
 	struct dragon *md = (struct dragon *)m;
 	bp_watchpoint_remove(&md->watchpoint_set, RnW, Astart, Aend, handler);
+	dragon_page_map_invalidate(md);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1451,17 +1720,14 @@ void dragon_vdg_fs(void *sptr, bool level) {
 	md->SAM->vdg_fsync(md->SAM, level);
 	if (level) {
 		sound_update(md->snd);
-		md->frame--;
-		if (md->frame < 0)
-			md->frame = md->frameskip;
-		vo_vsync(md->vo, md->frame == 0);
+		vo_vsync(md->vo);
 	}
 }
 
 static void vdg_render_line(void *sptr, unsigned burst, unsigned npixels, uint8_t const *data) {
 	struct dragon *md = sptr;
 	burst = (burst | md->ntsc_burst_mod) & 3;
-	DELEGATE_CALL(md->vo->render_line, burst, npixels, data);
+	vo_render_line(md->vo, burst, npixels, data);
 }
 
 /* Dragon parallel printer line delegate. */
@@ -40,6 +40,13 @@ struct sound_interface;
 struct tape_interface;
 struct vo_interface;
 
+// Direct page map granularity.  32 bytes matches the SAM's finest decode
+// (e.g. FFE0-FFFF, the interrupt vectors, decode to ROM).
+
+#define DRAGON_PAGE_SHIFT (5)
+#define DRAGON_PAGE_SIZE  (1 << DRAGON_PAGE_SHIFT)
+#define DRAGON_NPAGES     (0x10000 >> DRAGON_PAGE_SHIFT)
+
 enum dragon_sam_variant {
 	DRAGON_SAM_74LS783,
 	DRAGON_SAM_74LS785,
@@ -58,7 +65,6 @@ struct dragon {
 	struct ram *RAM;
 
 	struct vo_interface *vo;
-	int frame;  // track frameskip
 	struct sound_interface *snd;
 
 	// Optional iMMUnity memory expansion
@@ -72,10 +78,14 @@ struct dragon {
 	bool (*read_byte)(struct dragon *, unsigned A);
 	bool (*write_byte)(struct dragon *, unsigned A);
 
+	// Derived machines that override read_byte() can provide this to
+	// report which ROM bank currently appears where the SAM selects
+	// internal ROM (S=1,2), allowing those pages to be mapped.  Call
+	// dragon_page_map_invalidate() if the answer changes.
+	struct rombank *(*map_rom)(struct dragon *);
+
 	bool inverted_text;
 	struct cart *cart;
-	unsigned configured_frameskip;
-	unsigned frameskip;
 
 	int cycles;
 
@@ -86,6 +96,33 @@ struct dragon {
 	// RAM read buffer.  Driven to data bus only when SAM S == 0.
 	uint8_t Dread;
 
+	// Direct page map.  While the SAM runs at a fixed slow rate, a CPU
+	// cycle to plain RAM or ROM needs no more than a pointer dereference
+	// and a fixed clock advance.  Entries are host pointers to the start
+	// of each page (NULL if not mapped), indexed by [RnW][A >> shift].
+	// They are filled in lazily after a full cycle to the page, and the
+	// generation stamp records that a page has already been considered.
+	struct {
+		bool enabled;
+		unsigned generation;
+		uint8_t *page[2][DRAGON_NPAGES];
+		unsigned page_generation[2][DRAGON_NPAGES];
+	} page_map;
+
+	// Idle loop detection.  Optional: a known side-effect free delay loop
+	// running from mapped pages is fast-forwarded in whole iterations up
+	// to the next event.  The loop period is measured rather than assumed.
+	// 'skipped' accumulates the emulated time saved.
+	struct {
+		bool enabled;
+		uint16_t last_pc[2];
+		uint16_t pc;
+		uint16_t count;
+		event_ticks tick;
+		event_ticks period;
+		event_ticks skipped;
+	} idle_loop;
+
 	// Debug
 	bool single_step;
 	int stop_signal;
@@ -156,6 +193,14 @@ extern const struct ser_struct_data dragon_ser_struct_data;
 // Possibly modify address presented to RAM.
 //
 // Calls dragon_cpu_cycle() to access RAM and devices common to the arch.
+//
+// The standard delegate also short-circuits all of that for cycles to pages
+// in the direct page map (see above).  Such cycles see no read_byte() or
+// write_byte() overrides and no cartridge read() or write() calls, so the map
+// is only enabled if any cartridge present is flagged decode_only.
+
+// Discard all direct page map entries.
+void dragon_page_map_invalidate(void *sptr);
 
 // Advance clock and run scheduled events.
 inline void dragon_advance_clock(struct dragon *md, int ncycles) {
@@ -63,6 +63,7 @@ static void dragon64_reset(struct machine *, bool hard);
 
 static bool dragon64_read_byte(struct dragon *, unsigned A);
 static bool dragon64_write_byte(struct dragon *, unsigned A);
+static struct rombank *dragon64_map_rom(struct dragon *);
 
 static void dragon64_pia1b_data_postwrite(void *);
 
@@ -103,6 +104,7 @@ static struct part *dragon64_allocate(void) {
 
 	md->read_byte = dragon64_read_byte;
 	md->write_byte = dragon64_write_byte;
+	md->map_rom = dragon64_map_rom;
 
 	return p;
 }
@@ -273,12 +275,18 @@ static bool dragon64_write_byte(struct dragon *md, unsigned A) {
 	return 0;
 }
 
+static struct rombank *dragon64_map_rom(struct dragon *md) {
+	struct dragon64 *mdp = (struct dragon64 *)md;
+	return mdp->rom;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 static void dragon64_pia1b_data_postwrite(void *sptr) {
 	struct dragon64 *mdp = sptr;
 	struct dragon *md = &mdp->dragon;
 
+	struct rombank *old_rom = mdp->rom;
 	bool is_32k = PIA_VALUE_B(md->PIA1) & 0x04;
 	if (is_32k) {
 		mdp->rom = mdp->dragon.ROM0;
@@ -287,5 +295,8 @@ static void dragon64_pia1b_data_postwrite(void *sptr) {
 		mdp->rom = mdp->ROM1;
 		keyboard_set_chord_mode(md->keyboard.interface, keyboard_chord_mode_dragon_64k_basic);
 	}
+	if (mdp->rom != old_rom) {
+		dragon_page_map_invalidate(md);
+	}
 	dragon_pia1b_data_postwrite(sptr);
 }
@@ -117,6 +117,7 @@ static struct part *dragondos_allocate(void) {
 	*d = (struct dragondos){0};
 
 	cart_rom_init(c);
+	c->decode_only = 1;
 
 	c->detach = dragondos_detach;
 	c->read = dragondos_read;
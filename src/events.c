@@ -25,7 +25,7 @@
 #include "events.h"
 #include "logging.h"
 
-extern inline int event_tick_delta(event_ticks t0, event_ticks t1);
+extern inline int64_t event_tick_delta(event_ticks t0, event_ticks t1);
 extern inline bool event_pending(struct event_list *, event_ticks to_time);
 extern inline void event_dispatch_next(struct event_list *);
 extern inline void event_run_queue(struct event_list *, event_ticks dt);
@@ -33,6 +33,9 @@ extern inline void event_run_queue(struct event_list *, event_ticks dt);
 
 event_ticks event_current_tick = 0;
 
+static void update_next_tick(struct event_list *list);
+static void heap_dequeue(struct event_list *list, unsigned i);
+
 struct event_list *event_list_new(void) {
 	struct event_list *list = xmalloc(sizeof(*list));
 	event_list_init(list);
@@ -41,6 +44,37 @@ struct event_list *event_list_new(void) {
 
 void event_list_init(struct event_list *list) {
 	*list = (struct event_list){0};
+	update_next_tick(list);
+}
+
+static void update_next_tick(struct event_list *list) {
+	if (list->is_heap) {
+		list->next_tick = list->heap[0]->at_tick;
+	} else if (list->events) {
+		list->next_tick = list->events->at_tick;
+	} else {
+		list->next_tick = UINT64_MAX;
+	}
+}
+
+struct event *event_list_pop(struct event_list *list) {
+	struct event *e;
+	if (list->is_heap) {
+		e = list->heap[0];
+		heap_dequeue(list, 0);
+	} else {
+		e = list->events;
+		list->events = e->next;
+		list->nevents--;
+	}
+	update_next_tick(list);
+	return e;
+}
+
+void event_run_until(struct event_list *list, event_ticks to_time) {
+	while (event_pending(list, to_time)) {
+		event_dispatch_next(list);
+	}
 }
 
 struct event *event_new(struct event_list *list, DELEGATE_T0(void) delegate) {
@@ -62,24 +96,164 @@ void event_free(struct event *event) {
 	free(event);
 }
 
-void event_queue(struct event *event) {
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+// Usually only a handful of events are queued, and then a sorted list is
+// fastest: the next event is always at its head, and the search for where to
+// queue an event is short.  That search grows with the number of events,
+// though, so if more than EVENT_LIST_SORTED_MAX are queued, they move to a
+// binary min-heap instead, and back to a list once no more than
+// EVENT_LIST_SORTED_MIN remain.
+
+#define EVENT_LIST_SORTED_MAX (32)
+#define EVENT_LIST_SORTED_MIN (16)
+
+static bool event_before(const struct event *a, const struct event *b) {
+	if (a->at_tick != b->at_tick)
+		return a->at_tick < b->at_tick;
+	return a->seq < b->seq;
+}
+
+// Sorted list maintenance.  Queueing after any events due on the same tick
+// keeps them in order of queueing.
+
+static void sorted_insert(struct event_list *list, struct event *event) {
 	struct event **entry;
+	for (entry = &list->events; *entry; entry = &(*entry)->next) {
+		if (event->at_tick < (*entry)->at_tick)
+			break;
+	}
+	event->next = *entry;
+	*entry = event;
+	list->nevents++;
+}
+
+static bool sorted_remove(struct event_list *list, struct event *event) {
+	for (struct event **entry = &list->events; *entry; entry = &(*entry)->next) {
+		if (*entry == event) {
+			*entry = event->next;
+			list->nevents--;
+			return 1;
+		}
+	}
+	return 0;
+}
+
+// Heap maintenance.  Each event records its own index so that it can be
+// removed from anywhere in the heap.
+
+static void heap_set(struct event_list *list, unsigned i, struct event *e) {
+	list->heap[i] = e;
+	e->heap_index = i;
+}
+
+static void heap_sift_up(struct event_list *list, unsigned i) {
+	struct event *e = list->heap[i];
+	while (i > 0) {
+		unsigned parent = (i - 1) / 2;
+		if (!event_before(e, list->heap[parent]))
+			break;
+		heap_set(list, i, list->heap[parent]);
+		i = parent;
+	}
+	heap_set(list, i, e);
+}
+
+static void heap_sift_down(struct event_list *list, unsigned i) {
+	struct event *e = list->heap[i];
+	for (;;) {
+		unsigned child = i * 2 + 1;
+		if (child >= list->nevents)
+			break;
+		if (child + 1 < list->nevents && event_before(list->heap[child + 1], list->heap[child]))
+			child++;
+		if (!event_before(list->heap[child], e))
+			break;
+		heap_set(list, i, list->heap[child]);
+		i = child;
+	}
+	heap_set(list, i, e);
+}
+
+static void heap_insert(struct event_list *list, struct event *event) {
+	heap_set(list, list->nevents++, event);
+	heap_sift_up(list, event->heap_index);
+}
+
+static void heap_remove(struct event_list *list, unsigned i) {
+	struct event *last = list->heap[--list->nevents];
+	if (i < list->nevents) {
+		heap_set(list, i, last);
+		heap_sift_down(list, i);
+		heap_sift_up(list, last->heap_index);
+	}
+}
+
+// Events copied in order from the sorted list already form a valid heap.
+
+static void make_heap(struct event_list *list) {
+	unsigned i = 0;
+	for (struct event *e = list->events; e; e = e->next) {
+		heap_set(list, i++, e);
+	}
+	list->events = NULL;
+	list->is_heap = 1;
+}
+
+static void make_list(struct event_list *list) {
+	unsigned nevents = list->nevents;
+	struct event **tail = &list->events;
+	while (list->nevents) {
+		struct event *e = list->heap[0];
+		heap_remove(list, 0);
+		*tail = e;
+		tail = &e->next;
+	}
+	*tail = NULL;
+	list->nevents = nevents;
+	list->is_heap = 0;
+}
+
+static void heap_dequeue(struct event_list *list, unsigned i) {
+	heap_remove(list, i);
+	if (list->nevents <= EVENT_LIST_SORTED_MIN) {
+		make_list(list);
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void event_queue(struct event *event) {
+	struct event_list *list = event->list;
 	if (event->queued)
 		event_dequeue(event);
 	event->queued = 1;
-	for (entry = &event->list->events; *entry; entry = &((*entry)->next)) {
-		if (event_tick_delta(event->at_tick, (*entry)->at_tick) < 0) {
-			event->next = *entry;
-			*entry = event;
-			return;
-		}
-	}
-	*entry = event;
 	event->next = NULL;
+	if (list->nevents >= list->nallocated) {
+		list->nallocated = list->nallocated ? list->nallocated * 2 : 16;
+		list->heap = xrealloc(list->heap, list->nallocated * sizeof(*list->heap));
+	}
+	event->seq = list->seq++;
+	if (!list->is_heap && list->nevents >= EVENT_LIST_SORTED_MAX) {
+		make_heap(list);
+	}
+	if (list->is_heap) {
+		heap_insert(list, event);
+	} else {
+		sorted_insert(list, event);
+	}
+	update_next_tick(list);
 }
 
 void event_queue_auto(struct event_list *list, DELEGATE_T0(void) delegate, int dt) {
-	struct event *e = event_new(list, delegate);
+	struct event *e = list->free_events;
+	if (e) {
+		list->free_events = e->next;
+		event_init(e, list, delegate);
+	} else {
+		e = event_new(list, delegate);
+		list->nauto_allocated++;
+	}
 	e->at_tick += dt;
 	e->autofree = 1;
 	event_queue(e);
@@ -89,13 +263,19 @@ void event_dequeue(struct event *event) {
 	if (!event->queued)
 		return;
 	event->queued = 0;
-	struct event **entp;
-	for (entp = &event->list->events; *entp; entp = &(*entp)->next) {
-		if (*entp == event)
-			break;
+	struct event_list *list = event->list;
+	bool found;
+	if (list->is_heap) {
+		unsigned i = event->heap_index;
+		found = (i < list->nevents && list->heap[i] == event);
+		if (found) {
+			heap_dequeue(list, i);
+		}
+	} else {
+		found = sorted_remove(list, event);
 	}
-	if (*entp) {
-		*entp = event->next;
+	if (found) {
+		update_next_tick(list);
 	} else {
 		LOG_MOD_ERROR("events", "internal error: queued event not found in list\n");
 	}
@@ -27,7 +27,11 @@
 /* Maintains queues of events.  Each event has a tick number at which its
  * delegate is scheduled to run.  */
 
-typedef uint32_t event_ticks;
+// Ticks are counted from startup in 64 bits, so never wrap in practice and
+// can be compared directly.  Code that only needs short intervals (e.g. sound
+// chip delegates) may still take a uint32_t view and use modular differences.
+
+typedef uint64_t event_ticks;
 
 /* Event tick frequency */
 #define EVENT_TICK_RATE ((uintmax_t)14318180)
@@ -42,8 +46,30 @@ extern event_ticks event_current_tick;
 
 struct event;
 
+// Queued events are ordered by at_tick, then by order of queueing, so events
+// due on the same tick still run FIFO.  While there are few of them, they are
+// held in a sorted list, otherwise in a binary min-heap.
+
 struct event_list {
+	// Sorted list of events, if not using the heap
 	struct event *events;
+	// Binary min-heap of events, if is_heap is set
+	struct event **heap;
+	bool is_heap;
+	unsigned nevents;
+	unsigned nallocated;
+	// Incremented for each event queued, used to order equal ticks
+	uint64_t seq;
+	// Cached at_tick of the first event, so that event_run_queue() needs
+	// only one comparison when nothing is due.  All ones if the list is
+	// empty.
+	event_ticks next_tick;
+	// Auto-freed events are returned here after dispatch for reuse by
+	// event_queue_auto(), chained through their "next" member.
+	struct event *free_events;
+	// Number of auto events ever allocated from the system for this list.
+	// Stays constant in steady state.
+	unsigned nauto_allocated;
 };
 
 struct event {
@@ -52,6 +78,12 @@ struct event {
 	bool queued;
 	bool autofree;
 	struct event_list *list;
+	// Position in list's heap, and queueing order, while queued
+	unsigned heap_index;
+	uint64_t seq;
+	// Links the sorted list while queued.  Otherwise, deserialisation
+	// sets this to point to the event to flag that it should be queued
+	// once read, and the list's pool of auto events is chained through it.
 	struct event *next;
 };
 
@@ -93,38 +125,46 @@ void event_dequeue(struct event *event);
 	} while (0)
 
 // Allocate an event and queue it, flagged to autofree.  Event will be
-// scheduled for current time + dt.
+// scheduled for current time + dt.  Events are taken from the list's pool
+// where possible, and returned to it once dispatched.
 void event_queue_auto(struct event_list *list, DELEGATE_T0(void), int dt);
 
 #define event_queued(e) ((e)->queued)
 
-/* In theory, C99 6.5:7 combined with the fact that fixed width integers are
- * guaranteed 2s complement should make this safe.  Kinda hard to tell, though.
- */
+// Signed difference between two times.  Tick counts never approach 2^63, so
+// this is exact.
 
-inline int event_tick_delta(event_ticks t0, event_ticks t1) {
-	uint32_t dt = t0 - t1;
-	return *(int32_t *)&dt;
+inline int64_t event_tick_delta(event_ticks t0, event_ticks t1) {
+	return (int64_t)t0 - (int64_t)t1;
 }
 
 inline bool event_pending(struct event_list *list, event_ticks to_time) {
-	return list->events && event_tick_delta(to_time, list->events->at_tick) >= 0;
+	return list->nevents && to_time >= list->next_tick;
 }
 
+// Out of line helpers for the below
+
+struct event *event_list_pop(struct event_list *list);
+void event_run_until(struct event_list *list, event_ticks to_time);
+
 inline void event_dispatch_next(struct event_list *list) {
-	struct event *e = list->events;
-	list->events = e->next;
+	struct event *e = event_list_pop(list);
 	e->queued = 0;
 	event_current_tick = e->at_tick;
 	DELEGATE_CALL(e->delegate);
-	if (e->autofree)
-		free(e);
+	if (e->autofree) {
+		e->next = list->free_events;
+		list->free_events = e;
+	}
 }
 
+// Advance time by dt, dispatching any events that fall due.  Called for every
+// CPU cycle, so only the cached deadline is tested inline.
+
 inline void event_run_queue(struct event_list *list, event_ticks dt) {
 	event_ticks to_time = event_current_tick + dt;
-	while (event_pending(list, to_time)) {
-		event_dispatch_next(list);
+	if (to_time >= list->next_tick) {
+		event_run_until(list, to_time);
 	}
 	event_current_tick = to_time;
 }
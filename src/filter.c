@@ -191,6 +191,7 @@ static double complex eval(const double complex *coeffs, int npz, double complex
 }
 
 extern inline float filter_iir_apply(struct filter_iir *filter, float value);
+extern inline float filter_iir_apply_n(struct filter_iir *filter, float value, int n);
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
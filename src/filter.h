@@ -65,6 +65,48 @@ inline float filter_iir_apply(struct filter_iir *filter, float value) {
 	return output;
 }
 
+// Apply filter to a run of 'n' identical input values, returning the final
+// output.  Once the zero delay line is filled with the same value, its
+// contribution is constant, so only the poles need to be stepped.  Results
+// are identical to calling filter_iir_apply() 'n' times.
+
+inline float filter_iir_apply_n(struct filter_iir *filter, float value, int n) {
+	float scaled = value / filter->dc_gain;
+	float output = filter->output;
+	while (n > 0) {
+		int i;
+		for (i = 0; i < filter->nz && filter->zv[i] == scaled; i++)
+			;
+		if (i == filter->nz)
+			break;
+		output = filter_iir_apply(filter, value);
+		n--;
+	}
+	if (n <= 0)
+		return output;
+
+	float zsum = 0.0;
+	for (int i = 0; i < filter->nz; i++)
+		zsum += filter->z[i] * filter->zv[i];
+
+	const float *p = filter->p;
+	float *pv = filter->pv;
+	int np = filter->np;
+	output = filter->output;
+	for ( ; n > 0; n--) {
+		for (int i = 0; i < np-1; i++)
+			pv[i] = pv[i+1];
+		pv[np-1] = output;
+
+		output = zsum;
+		for (int i = 0; i < np; i++)
+			output += p[i] * pv[i];
+	}
+	filter->output = output;
+
+	return output;
+}
+
 // FIR filters
 
 // This is only being added to support experimental code, and for now we're
@@ -101,6 +101,7 @@ static struct part *gmc_allocate(void) {
 	*gmc = (struct gmc){0};
 
 	cart_rom_init(c);
+	c->decode_only = 1;
 
 	c->attach = gmc_attach;
 	c->detach = gmc_detach;
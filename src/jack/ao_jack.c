@@ -15,23 +15,21 @@
  *
  *  \endlicenseblock
  *
- *  Currently only nfragments == 1 is supported.  The architecture of JACK is
- *  sufficiently different that new code will be needed to properly support
- *  stereo, so nchannels == 1 too.
+ *  The process callback fetches audio from the sound interface's ring, so
+ *  never waits on the emulator.  Where the ring isn't available, the callback
+ *  instead passes its buffer to the emulator and waits for it to be filled.
+ *  The architecture of JACK is sufficiently different that new code will be
+ *  needed to properly support stereo, so nchannels == 1.
  */
 
 #include "top-config.h"
 
-// for struct timespec, gettimeofday
-#define _POSIX_C_SOURCE 200112L
-
 #include <errno.h>
 #include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
-#include <unistd.h>
 #include <sys/time.h>
 
 #include <jack/jack.h>
@@ -57,22 +55,22 @@ struct ao_jack_interface {
 	jack_client_t *client;
 	jack_port_t *output_port;
 
-	float *callback_buffer;
-	bool shutting_down;
-
-	unsigned nfragments;
+	bool use_ring;
 
+	// Without the audio ring, buffers are passed between the callback and
+	// the emulator.
+	bool shutting_down;
 	pthread_mutex_t fragment_mutex;
 	pthread_cond_t fragment_cv;
+	float *callback_buffer;
 	float *fragment_buffer;
 	unsigned fragment_queue_length;
-	unsigned write_fragment;
-
 	unsigned timeout_us;
 };
 
 static int callback_1(jack_nframes_t nframes, void *arg);
 
+static void close_client(struct ao_jack_interface *aojack);
 static void ao_jack_free(void *sptr);
 static void *ao_jack_write_buffer(void *sptr, void *buffer);
 
@@ -84,6 +82,9 @@ static void *new(void *cfg) {
 
 	ao->free = DELEGATE_AS0(void, ao_jack_free, ao);
 
+	pthread_mutex_init(&aojack->fragment_mutex, NULL);
+	pthread_cond_init(&aojack->fragment_cv, NULL);
+
 	const char **ports;
 
 	if ((aojack->client = jack_client_open("XRoar", 0, NULL)) == 0) {
@@ -91,19 +92,33 @@ static void *new(void *cfg) {
 		goto failed;
 	}
 
-	unsigned buffer_nframes;
 	enum sound_fmt sample_fmt = SOUND_FMT_FLOAT;
 
 	jack_set_process_callback(aojack->client, callback_1, aojack);
 	aojack->output_port = jack_port_register(aojack->client, "output0", JACK_DEFAULT_AUDIO_TYPE, JackPortIsOutput, 0);
+
+	jack_nframes_t rate = jack_get_sample_rate(aojack->client);
+	jack_nframes_t fragment_nframes = jack_get_buffer_size(aojack->client);
+
+	// Sound interface must exist before the callback can run
+	ao->sound_interface = sound_interface_new(NULL, sample_fmt, rate, 1, fragment_nframes);
+	if (!ao->sound_interface) {
+		LOG_MOD_ERROR("jack", "failed to initialise: XRoar internal error\n");
+		goto failed;
+	}
+	aojack->use_ring = sound_ring_enable(ao->sound_interface);
+	if (!aojack->use_ring) {
+		aojack->timeout_us = (fragment_nframes * 1500000) / rate;
+		ao->sound_interface->write_buffer = DELEGATE_AS1(voidp, voidp, ao_jack_write_buffer, ao);
+	}
+	LOG_DEBUG(1, "\t%u frames/frag (%.1fms)\n", fragment_nframes, (float)(fragment_nframes * 1000) / rate);
+
 	if (jack_activate(aojack->client)) {
 		LOG_MOD_ERROR("jack", "initialisation failed: cannot activate client\n");
-		jack_client_close(aojack->client);
 		goto failed;
 	}
 	if ((ports = jack_get_ports(aojack->client, NULL, NULL, JackPortIsPhysical|JackPortIsInput)) == NULL) {
 		LOG_MOD_ERROR("jack", "cannot find any physical playback ports\n");
-		jack_client_close(aojack->client);
 		goto failed;
 	}
 	/* connect up to 2 ports (stereo output) */
@@ -111,49 +126,26 @@ static void *new(void *cfg) {
 		if (jack_connect(aojack->client, jack_port_name(aojack->output_port), ports[i])) {
 			LOG_MOD_ERROR("jack", "cannot connect output ports\n");
 			free(ports);
-			jack_client_close(aojack->client);
 			goto failed;
 		}
 	}
 	free(ports);
-	jack_nframes_t rate = jack_get_sample_rate(aojack->client);
-	jack_nframes_t fragment_nframes = jack_get_buffer_size(aojack->client);
-
-	aojack->nfragments = 1;
-	if (xroar.cfg.ao.fragments > 0 && xroar.cfg.ao.fragments <= 64)
-		aojack->nfragments = xroar.cfg.ao.fragments;
-
-	aojack->timeout_us = (fragment_nframes * 1500000) / rate;
-
-	buffer_nframes = fragment_nframes * aojack->nfragments;
-
-	pthread_mutex_init(&aojack->fragment_mutex, NULL);
-	pthread_cond_init(&aojack->fragment_cv, NULL);
-
-	aojack->shutting_down = 0;
-	aojack->fragment_queue_length = 0;
-	aojack->write_fragment = 0;
-	aojack->callback_buffer = NULL;
-
-	aojack->fragment_buffer = NULL;
-
-	ao->sound_interface = sound_interface_new(aojack->fragment_buffer, sample_fmt, rate, 1, fragment_nframes);
-	if (!ao->sound_interface) {
-		LOG_MOD_ERROR("jack", "failed to initialise: XRoar internal error\n");
-		goto failed;
-	}
-	ao->sound_interface->write_buffer = DELEGATE_AS1(voidp, voidp, ao_jack_write_buffer, ao);
-	LOG_DEBUG(1, "\t%u frags * %u frames/frag = %u frames buffer (%.1fms)\n", aojack->nfragments, fragment_nframes, buffer_nframes, (float)(buffer_nframes * 1000) / rate);
 
 	return aojack;
 
 failed:
+	close_client(aojack);
+	if (ao->sound_interface)
+		sound_interface_free(ao->sound_interface);
+	pthread_cond_destroy(&aojack->fragment_cv);
+	pthread_mutex_destroy(&aojack->fragment_mutex);
 	free(aojack);
 	return NULL;
 }
 
-static void ao_jack_free(void *sptr) {
-	struct ao_jack_interface *aojack = sptr;
+static void close_client(struct ao_jack_interface *aojack) {
+	if (!aojack->client)
+		return;
 
 	aojack->shutting_down = 1;
 
@@ -163,9 +155,15 @@ static void ao_jack_free(void *sptr) {
 	pthread_cond_signal(&aojack->fragment_cv);
 	pthread_mutex_unlock(&aojack->fragment_mutex);
 
-	if (aojack->client)
-		jack_client_close(aojack->client);
+	// stops the process callback
+	jack_client_close(aojack->client);
 	aojack->client = NULL;
+}
+
+static void ao_jack_free(void *sptr) {
+	struct ao_jack_interface *aojack = sptr;
+
+	close_client(aojack);
 
 	pthread_cond_destroy(&aojack->fragment_cv);
 	pthread_mutex_destroy(&aojack->fragment_mutex);
@@ -173,13 +171,14 @@ static void ao_jack_free(void *sptr) {
 	free(aojack);
 }
 
+// Only used without the audio ring.
+
 static void *ao_jack_write_buffer(void *sptr, void *buffer) {
 	struct ao_jack_interface *aojack = sptr;
 
 	pthread_mutex_lock(&aojack->fragment_mutex);
 
 	if (buffer) {
-		aojack->write_fragment = (aojack->write_fragment + 1) % aojack->nfragments;
 		aojack->fragment_queue_length++;
 		pthread_cond_signal(&aojack->fragment_cv);
 	}
@@ -198,7 +197,7 @@ static void *ao_jack_write_buffer(void *sptr, void *buffer) {
 	ts.tv_sec = tv.tv_sec;
 	ts.tv_nsec = tv.tv_usec * 1000;
 
-	// for nfragments == 1, wait for callback to send buffer
+	// wait for callback to send buffer
 	while (aojack->callback_buffer == NULL) {
 		if (pthread_cond_timedwait(&aojack->fragment_cv, &aojack->fragment_mutex, &ts) == ETIMEDOUT) {
 			pthread_mutex_unlock(&aojack->fragment_mutex);
@@ -209,12 +208,18 @@ static void *ao_jack_write_buffer(void *sptr, void *buffer) {
 	aojack->callback_buffer = NULL;
 
 	pthread_mutex_unlock(&aojack->fragment_mutex);
-	return aojack->fragment_buffer;;
+	return aojack->fragment_buffer;
 }
 
 static int callback_1(jack_nframes_t nframes, void *arg) {
 	struct ao_jack_interface *aojack = arg;
 
+	if (aojack->use_ring) {
+		float *buffer = jack_port_get_buffer(aojack->output_port, nframes);
+		sound_ring_read(aojack->public.sound_interface, buffer, nframes);
+		return 0;
+	}
+
 	if (aojack->shutting_down)
 		return -1;
 	pthread_mutex_lock(&aojack->fragment_mutex);
@@ -70,15 +70,12 @@ struct mc10 {
 	struct ram *RAM1;
 
 	struct vo_interface *vo;
-	int frame;  // track frameskip
 	struct sound_interface *snd;
 
 	unsigned ram0_inhibit_bit;
 
 	bool inverted_text;
 	struct mc10_cart *cart;
-	unsigned configured_frameskip;
-	unsigned frameskip;
 	unsigned video_mode;
 	uint16_t video_attr;
 
@@ -226,7 +223,6 @@ static void mc10_ui_set_picture(void *, int tag, void *smsg);
 static void mc10_ui_set_tv_input(void *, int tag, void *smsg);
 static void mc10_ui_set_text_invert(void *, int tag, void *smsg);
 static void *mc10_get_interface(struct machine *m, const char *ifname);
-static void mc10_ui_set_frameskip(void *, int tag, void *smsg);
 static void mc10_ui_set_ratelimit(void *, int tag, void *smsg);
 
 static void mc10_print_byte(void *, bool RnW, uint32_t A);
@@ -404,7 +400,6 @@ static bool mc10_finish(struct part *p) {
 	ui_messenger_preempt_group(mp->msgr_client_id, ui_tag_tv_input, MESSENGER_NOTIFY_DELEGATE(mc10_ui_set_tv_input, mp));
 	ui_messenger_preempt_group(mp->msgr_client_id, ui_tag_vdg_inverse, MESSENGER_NOTIFY_DELEGATE(mc10_ui_set_text_invert, mp));
 	ui_messenger_preempt_group(mp->msgr_client_id, ui_tag_keymap, MESSENGER_NOTIFY_DELEGATE(mc10_ui_set_keymap, mp));
-	ui_messenger_join_group(mp->msgr_client_id, ui_tag_frameskip, MESSENGER_NOTIFY_DELEGATE(mc10_ui_set_frameskip, mp));
 	ui_messenger_join_group(mp->msgr_client_id, ui_tag_ratelimit, MESSENGER_NOTIFY_DELEGATE(mc10_ui_set_ratelimit, mp));
 
 	memcpy(&m->debug.cpu, &mp->CPU->debug.cpu, sizeof(m->debug.cpu));
@@ -1010,16 +1005,13 @@ static void mc10_vdg_fs(void *sptr, bool level) {
 	struct mc10 *mp = sptr;
 	if (level) {
 		sound_update(mp->snd);
-		mp->frame--;
-		if (mp->frame < 0)
-			mp->frame = mp->frameskip;
-		vo_vsync(mp->vo, mp->frame == 0);
+		vo_vsync(mp->vo);
 	}
 }
 
 static void mc10_vdg_render_line(void *sptr, unsigned burst, unsigned npixels, uint8_t const *data) {
 	struct mc10 *mp = sptr;
-	DELEGATE_CALL(mp->vo->render_line, burst, npixels, data);
+	vo_render_line(mp->vo, burst, npixels, data);
 }
 
 static void mc10_vdg_fetch_handler(void *sptr, uint16_t A, int nbytes, uint16_t *dest) {
@@ -1088,23 +1080,11 @@ static void mc10_mem_cycle(void *sptr, bool RnW, uint16_t A) {
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-static void mc10_ui_set_frameskip(void *sptr, int tag, void *smsg) {
-	(void)tag;
-	struct mc10 *mp = sptr;
-	struct ui_state_message *uimsg = smsg;
-	mp->configured_frameskip = mp->frameskip = uimsg->value;
-}
-
 static void mc10_ui_set_ratelimit(void *sptr, int tag, void *smsg) {
 	(void)tag;
 	struct mc10 *mp = sptr;
 	struct ui_state_message *uimsg = smsg;
 	sound_set_ratelimit(mp->snd, uimsg->value);
-	if (uimsg->value) {
-		mp->frameskip = mp->configured_frameskip;
-	} else {
-		mp->frameskip = 10;
-	}
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
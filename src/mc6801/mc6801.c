@@ -204,6 +204,7 @@ static void instruction_posthook(struct MC6801 *cpu);
 
 #define STRUCT_CPU struct MC6801
 
+#include "mc680x/mc680x_dispatch.h"
 #include "mc680x/mc680x_ops.c"
 
 // Internal memory-mapped registers
@@ -366,6 +367,75 @@ static void mc6801_reset(struct MC6801 *cpu) {
 // Run CPU while cpu->running is true.
 
 static void mc6801_run(struct MC6801 *cpu) {
+#ifdef WANT_COMPUTED_GOTO
+	static void *const op_table[0x100] = {
+		[0x00] = &&op_0x00, &&op_0x01, &&op_0x02, &&op_0x03,
+		[0x04] = &&op_0x04, &&op_0x05, &&op_0x06, &&op_0x07,
+		[0x08] = &&op_0x08, &&op_0x09, &&op_0x0a, &&op_0x0b,
+		[0x0c] = &&op_0x0c, &&op_0x0d, &&op_0x0e, &&op_0x0f,
+		[0x10] = &&op_0x10, &&op_0x11, &&op_0x12, &&op_0x13,
+		[0x14] = &&op_0x14, &&op_0x15, &&op_0x16, &&op_0x17,
+		[0x18] = &&op_0x18, &&op_0x19, &&op_0x1a, &&op_0x1b,
+		[0x1c] = &&op_0x1c, &&op_0x1d, &&op_0x1e, &&op_0x1f,
+		[0x20] = &&op_0x20, &&op_0x21, &&op_0x22, &&op_0x23,
+		[0x24] = &&op_0x24, &&op_0x25, &&op_0x26, &&op_0x27,
+		[0x28] = &&op_0x28, &&op_0x29, &&op_0x2a, &&op_0x2b,
+		[0x2c] = &&op_0x2c, &&op_0x2d, &&op_0x2e, &&op_0x2f,
+		[0x30] = &&op_0x30, &&op_0x31, &&op_0x32, &&op_0x33,
+		[0x34] = &&op_0x34, &&op_0x35, &&op_0x36, &&op_0x37,
+		[0x38] = &&op_0x38, &&op_0x39, &&op_0x3a, &&op_0x3b,
+		[0x3c] = &&op_0x3c, &&op_0x3d, &&op_0x3e, &&op_0x3f,
+		[0x40] = &&op_0x40, &&op_0x41, &&op_0x42, &&op_0x43,
+		[0x44] = &&op_0x44, &&op_0x45, &&op_0x46, &&op_0x47,
+		[0x48] = &&op_0x48, &&op_0x49, &&op_0x4a, &&op_0x4b,
+		[0x4c] = &&op_0x4c, &&op_0x4d, &&op_0x4e, &&op_0x4f,
+		[0x50] = &&op_0x50, &&op_0x51, &&op_0x52, &&op_0x53,
+		[0x54] = &&op_0x54, &&op_0x55, &&op_0x56, &&op_0x57,
+		[0x58] = &&op_0x58, &&op_0x59, &&op_0x5a, &&op_0x5b,
+		[0x5c] = &&op_0x5c, &&op_0x5d, &&op_0x5e, &&op_0x5f,
+		[0x60] = &&op_0x60, &&op_0x61, &&op_0x62, &&op_0x63,
+		[0x64] = &&op_0x64, &&op_0x65, &&op_0x66, &&op_0x67,
+		[0x68] = &&op_0x68, &&op_0x69, &&op_0x6a, &&op_0x6b,
+		[0x6c] = &&op_0x6c, &&op_0x6d, &&op_0x6e, &&op_0x6f,
+		[0x70] = &&op_0x70, &&op_0x71, &&op_0x72, &&op_0x73,
+		[0x74] = &&op_0x74, &&op_0x75, &&op_0x76, &&op_0x77,
+		[0x78] = &&op_0x78, &&op_0x79, &&op_0x7a, &&op_0x7b,
+		[0x7c] = &&op_0x7c, &&op_0x7d, &&op_0x7e, &&op_0x7f,
+		[0x80] = &&op_0x80, &&op_0x81, &&op_0x82, &&op_0x83,
+		[0x84] = &&op_0x84, &&op_0x85, &&op_0x86, &&op_0x87,
+		[0x88] = &&op_0x88, &&op_0x89, &&op_0x8a, &&op_0x8b,
+		[0x8c] = &&op_0x8c, &&op_0x8d, &&op_0x8e, &&op_0x8f,
+		[0x90] = &&op_0x90, &&op_0x91, &&op_0x92, &&op_0x93,
+		[0x94] = &&op_0x94, &&op_0x95, &&op_0x96, &&op_0x97,
+		[0x98] = &&op_0x98, &&op_0x99, &&op_0x9a, &&op_0x9b,
+		[0x9c] = &&op_0x9c, &&op_0x9d, &&op_0x9e, &&op_0x9f,
+		[0xa0] = &&op_0xa0, &&op_0xa1, &&op_0xa2, &&op_0xa3,
+		[0xa4] = &&op_0xa4, &&op_0xa5, &&op_0xa6, &&op_0xa7,
+		[0xa8] = &&op_0xa8, &&op_0xa9, &&op_0xaa, &&op_0xab,
+		[0xac] = &&op_0xac, &&op_0xad, &&op_0xae, &&op_0xaf,
+		[0xb0] = &&op_0xb0, &&op_0xb1, &&op_0xb2, &&op_0xb3,
+		[0xb4] = &&op_0xb4, &&op_0xb5, &&op_0xb6, &&op_0xb7,
+		[0xb8] = &&op_0xb8, &&op_0xb9, &&op_0xba, &&op_0xbb,
+		[0xbc] = &&op_0xbc, &&op_0xbd, &&op_0xbe, &&op_0xbf,
+		[0xc0] = &&op_0xc0, &&op_0xc1, &&op_0xc2, &&op_0xc3,
+		[0xc4] = &&op_0xc4, &&op_0xc5, &&op_0xc6, &&op_0xc7,
+		[0xc8] = &&op_0xc8, &&op_0xc9, &&op_0xca, &&op_0xcb,
+		[0xcc] = &&op_0xcc, &&op_0xcd, &&op_0xce, &&op_0xcf,
+		[0xd0] = &&op_0xd0, &&op_0xd1, &&op_0xd2, &&op_0xd3,
+		[0xd4] = &&op_0xd4, &&op_0xd5, &&op_0xd6, &&op_0xd7,
+		[0xd8] = &&op_0xd8, &&op_0xd9, &&op_0xda, &&op_0xdb,
+		[0xdc] = &&op_0xdc, &&op_0xdd, &&op_0xde, &&op_0xdf,
+		[0xe0] = &&op_0xe0, &&op_0xe1, &&op_0xe2, &&op_0xe3,
+		[0xe4] = &&op_0xe4, &&op_0xe5, &&op_0xe6, &&op_0xe7,
+		[0xe8] = &&op_0xe8, &&op_0xe9, &&op_0xea, &&op_0xeb,
+		[0xec] = &&op_0xec, &&op_0xed, &&op_0xee, &&op_0xef,
+		[0xf0] = &&op_0xf0, &&op_0xf1, &&op_0xf2, &&op_0xf3,
+		[0xf4] = &&op_0xf4, &&op_0xf5, &&op_0xf6, &&op_0xf7,
+		[0xf8] = &&op_0xf8, &&op_0xf9, &&op_0xfa, &&op_0xfb,
+		[0xfc] = &&op_0xfc, &&op_0xfd, &&op_0xfe, &&op_0xff,
+	};
+#endif
+
 
 	do {
 
@@ -414,6 +484,10 @@ static void mc6801_run(struct MC6801 *cpu) {
 			cpu->trace_pc = cpu->trace_next_pc = REG_PC;
 			cpu->trace_nbytes = 0;
 #endif
+			// Straight on to the fetch unless that hook (or the clock)
+			// stopped the CPU.
+			if (cpu->running)
+				goto next_instruction;
 			continue;
 
 		case mc6801_state_wai:
@@ -461,52 +535,54 @@ static void mc6801_run(struct MC6801 *cpu) {
 			continue;
 
 		case mc6801_state_next_instruction:
+		next_instruction:
 			{
 			unsigned op;
 			cpu->state = mc6801_state_label_a;
 			// Fetch op-code and process
 			op = byte_immediate(cpu);
+			DISPATCH_OP(op_table, op);
 			switch (op) {
 
 			// 0x00 CLB illegal - clear, no flags
-			case 0x00:
+			OP(0x00):
 				REG_B = 0;
 				peek_byte(cpu, REG_PC);
 				break;
 
 			// 0x01 NOP inherent
-			case 0x01:
+			OP(0x01):
 				peek_byte(cpu, REG_PC);
 				break;
 
 			// 0x02 SEXA illegal
-			case 0x02:
+			OP(0x02):
 				REG_A = (REG_CC & CC_C) ? 0xff : 0;
 				peek_byte(cpu, REG_PC);
 				break;
 
 			// 0x03 SETA illegal
-			case 0x03:
+			OP(0x03):
 				REG_A = 0xff;
 				peek_byte(cpu, REG_PC);
 				break;
 
 			// 0x04 LSRD inherent
-			case 0x04:
+			OP(0x04):
 				REG_D = op_lsr16_v(cpu, REG_D);
 				peek_byte(cpu, REG_PC);
 				NVMA_CYCLE;
 				break;
 
 			// 0x05 LSLD inherent
-			case 0x05:
+			OP(0x05):
 				REG_D = op_lsl16(cpu, REG_D);
 				peek_byte(cpu, REG_PC);
 				NVMA_CYCLE;
 				break;
 
 			// 0x06 TAP inherent
-			case 0x06:
+			OP(0x06):
 				REG_CC = 0xc0 | REG_A | CC_I;
 				cpu->itmp = REG_A & CC_I;
 				if (cpu->itmp) {
@@ -516,13 +592,13 @@ static void mc6801_run(struct MC6801 *cpu) {
 				break;
 
 			// 0x07 TPA inherent
-			case 0x07:
+			OP(0x07):
 				REG_A = 0xc0 | REG_CC;
 				peek_byte(cpu, REG_PC);
 				break;
 
 			// 0x08 INX inherent
-			case 0x08:
+			OP(0x08):
 				REG_X++;
 				CLR_Z;
 				SET_Z16(REG_X);
@@ -531,7 +607,7 @@ static void mc6801_run(struct MC6801 *cpu) {
 				break;
 
 			// 0x09 DEX inherent
-			case 0x09:
+			OP(0x09):
 				REG_X--;
 				CLR_Z;
 				SET_Z16(REG_X);
@@ -540,37 +616,37 @@ static void mc6801_run(struct MC6801 *cpu) {
 				break;
 
 			// 0x0a CLV inherent
-			case 0x0a:
+			OP(0x0a):
 				REG_CC &= ~CC_V;
 				peek_byte(cpu, REG_PC);
 				break;
 
 			// 0x0b SEV inherent
-			case 0x0b:
+			OP(0x0b):
 				REG_CC |= CC_V;
 				peek_byte(cpu, REG_PC);
 				break;
 
 			// 0x0c CLC inherent
-			case 0x0c:
+			OP(0x0c):
 				REG_CC &= ~CC_C;
 				peek_byte(cpu, REG_PC);
 				break;
 
 			// 0x0d SEC inherent
-			case 0x0d:
+			OP(0x0d):
 				REG_CC |= CC_C;
 				peek_byte(cpu, REG_PC);
 				break;
 
 			// 0x0e CLI inherent
-			case 0x0e:
+			OP(0x0e):
 				cpu->itmp = 0;
 				peek_byte(cpu, REG_PC);
 				break;
 
 			// 0x0f SEI inherent
-			case 0x0f:
+			OP(0x0f):
 				REG_CC |= CC_I;
 				cpu->itmp = CC_I;
 				cpu->irq1_latch = cpu->irq2_latch = 0;
@@ -578,25 +654,25 @@ static void mc6801_run(struct MC6801 *cpu) {
 				break;
 
 			// 0x10 SBA inherent
-			case 0x10:
+			OP(0x10):
 				REG_A = op_sub(cpu, REG_A, REG_B);
 				peek_byte(cpu, REG_PC);
 				break;
 
 			// 0x11 CBA inherent
-			case 0x11:
+			OP(0x11):
 				(void)op_sub(cpu, REG_A, REG_B);
 				peek_byte(cpu, REG_PC);
 				break;
 
 			// 0x12 SCBA inherent, illegal; A = A - B - C
-			case 0x12:
+			OP(0x12):
 				REG_A = op_sbc(cpu, REG_A, REG_B);
 				peek_byte(cpu, REG_PC);
 				break;
 
 			// 0x13 S1BA inherent, illegal; A = A - B - 1
-			case 0x13:
+			OP(0x13):
 				{
 					unsigned out = REG_A - REG_B - 1;
 					CLR_NZVC;
@@ -608,8 +684,8 @@ static void mc6801_run(struct MC6801 *cpu) {
 
 			// 0x14 TCAB inherent, illegal; B = A - 1
 			// 0x1c TCAB inherent, illegal; B = A - 1
-			case 0x14:
-			case 0x1c:
+			OP(0x14):
+			OP(0x1c):
 				{
 					unsigned out = REG_A - 1;
 					CLR_NZV;
@@ -621,7 +697,7 @@ static void mc6801_run(struct MC6801 *cpu) {
 				break;
 
 			// 0x15 TCBA inherent, illegal; A = B - 1
-			case 0x15:
+			OP(0x15):
 				{
 					unsigned out = REG_B - 1;
 					CLR_NZV;
@@ -634,8 +710,8 @@ static void mc6801_run(struct MC6801 *cpu) {
 
 			// 0x16 TAB inherent
 			// 0x1e TAB inherent, illegal
-			case 0x16:
-			case 0x1e:
+			OP(0x16):
+			OP(0x1e):
 				REG_B = REG_A;
 				CLR_NZV;
 				SET_NZ8(REG_B);
@@ -643,7 +719,7 @@ static void mc6801_run(struct MC6801 *cpu) {
 				break;
 
 			// 0x17 TBA inherent
-			case 0x17:
+			OP(0x17):
 				REG_A = REG_B;
 				CLR_NZV;
 				SET_NZ8(REG_A);
@@ -652,26 +728,26 @@ static void mc6801_run(struct MC6801 *cpu) {
 
 			// 0x18 ABA inherent, illegal
 			// 0x1a ABA inherent, illegal
-			case 0x18:
-			case 0x1a:
+			OP(0x18):
+			OP(0x1a):
 				REG_A = op_add_nzv(cpu, REG_A, REG_B);
 				peek_byte(cpu, REG_PC);
 				break;
 
 			// 0x19 DAA inherent
-			case 0x19:
+			OP(0x19):
 				REG_A = op_daa_v(cpu, REG_A);
 				peek_byte(cpu, REG_PC);
 				break;
 
 			// 0x1b ABA inherent
-			case 0x1b:
+			OP(0x1b):
 				REG_A = op_add(cpu, REG_A, REG_B);
 				peek_byte(cpu, REG_PC);
 				break;
 
 			// 0x1d TCBA inherent, illegal; A = B - 1
-			case 0x1d:
+			OP(0x1d):
 				{
 					unsigned out = REG_B - 1;
 					CLR_NZVC;
@@ -685,7 +761,7 @@ static void mc6801_run(struct MC6801 *cpu) {
 				break;
 
 			// 0x1f TBAC inherent, illegal; A = B, set C
-			case 0x1f:
+			OP(0x1f):
 				REG_A = REG_B;
 				CLR_NZV;
 				SET_NZ8(REG_B);
@@ -694,10 +770,10 @@ static void mc6801_run(struct MC6801 *cpu) {
 				break;
 
 			// 0x20 - 0x2f short branches
-			case 0x20: case 0x21: case 0x22: case 0x23:
-			case 0x24: case 0x25: case 0x26: case 0x27:
-			case 0x28: case 0x29: case 0x2a: case 0x2b:
-			case 0x2c: case 0x2d: case 0x2e: case 0x2f: {
+			OP(0x20): OP(0x21): OP(0x22): OP(0x23):
+			OP(0x24): OP(0x25): OP(0x26): OP(0x27):
+			OP(0x28): OP(0x29): OP(0x2a): OP(0x2b):
+			OP(0x2c): OP(0x2d): OP(0x2e): OP(0x2f): {
 				unsigned tmp = sex8(byte_immediate(cpu));
 				NVMA_CYCLE;
 				if (branch_condition(cpu, op))
@@ -705,59 +781,59 @@ static void mc6801_run(struct MC6801 *cpu) {
 			} break;
 
 			// 0x30 TSX inherent
-			case 0x30:
+			OP(0x30):
 				REG_X = REG_SP + 1;
 				peek_byte(cpu, REG_PC);
 				NVMA_CYCLE;
 				break;
 
 			// 0x31 INS inherent
-			case 0x31:
+			OP(0x31):
 				peek_byte(cpu, REG_PC);
 				peek_byte(cpu, REG_SP++);
 				break;
 
 			// 0x32 PULA inherent
-			case 0x32:
+			OP(0x32):
 				peek_byte(cpu, REG_PC);
 				peek_byte(cpu, REG_SP++);
 				REG_A = fetch_byte_notrace(cpu, REG_SP);
 				break;
 
 			// 0x33 PULB inherent
-			case 0x33:
+			OP(0x33):
 				peek_byte(cpu, REG_PC);
 				peek_byte(cpu, REG_SP++);
 				REG_B = fetch_byte_notrace(cpu, REG_SP);
 				break;
 
 			// 0x34 DES inherent
-			case 0x34:
+			OP(0x34):
 				peek_byte(cpu, REG_PC);
 				peek_byte(cpu, REG_SP--);
 				break;
 
 			// 0x35 TXS inherent
-			case 0x35:
+			OP(0x35):
 				REG_SP = REG_X - 1;
 				peek_byte(cpu, REG_PC);
 				NVMA_CYCLE;
 				break;
 
 			// 0x36 PSHA inherent
-			case 0x36:
+			OP(0x36):
 				peek_byte(cpu, REG_PC);
 				store_byte(cpu, REG_SP--, REG_A);
 				break;
 
 			// 0x37 PSHB inherent
-			case 0x37:
+			OP(0x37):
 				peek_byte(cpu, REG_PC);
 				store_byte(cpu, REG_SP--, REG_B);
 				break;
 
 			// 0x38 PULX inherent
-			case 0x38:
+			OP(0x38):
 				peek_byte(cpu, REG_PC);
 				peek_byte(cpu, REG_SP++);
 				REG_X = fetch_byte_notrace(cpu, REG_SP++) << 8;
@@ -765,21 +841,21 @@ static void mc6801_run(struct MC6801 *cpu) {
 				break;
 
 			// 0x39 RTS inherent
-			case 0x39:
+			OP(0x39):
 				peek_byte(cpu, REG_PC);
 				REG_PC = pull_s_word(cpu);
 				NVMA_CYCLE;
 				break;
 
 			// 0x3a ABX inherent
-			case 0x3a:
+			OP(0x3a):
 				REG_X += REG_B;
 				peek_byte(cpu, REG_PC);
 				NVMA_CYCLE;
 				break;
 
 			// 0x3b RTI inherent
-			case 0x3b:
+			OP(0x3b):
 				peek_byte(cpu, REG_PC);
 				peek_byte(cpu, REG_SP);
 				// no point tracking the 1-cycle delay for ITMP->I here
@@ -792,14 +868,14 @@ static void mc6801_run(struct MC6801 *cpu) {
 				break;
 
 			// 0x3c PSHX inherent
-			case 0x3c:
+			OP(0x3c):
 				peek_byte(cpu, REG_PC);
 				store_byte(cpu, REG_SP--, REG_X & 0xff);
 				store_byte(cpu, REG_SP--, REG_X >> 8);
 				break;
 
 			// 0x3d MUL inherent
-			case 0x3d: {
+			OP(0x3d): {
 				unsigned tmp = REG_A * REG_B;
 				REG_D = tmp;
 				if (tmp & 0x80)
@@ -818,7 +894,7 @@ static void mc6801_run(struct MC6801 *cpu) {
 			} break;
 
 			// 0x3e WAI inherent
-			case 0x3e:
+			OP(0x3e):
 				REG_CC = (REG_CC & ~CC_I) | cpu->itmp;
 				peek_byte(cpu, REG_PC);
 				stack_irq_registers(cpu);
@@ -827,7 +903,7 @@ static void mc6801_run(struct MC6801 *cpu) {
 				continue;
 
 			// 0x3f SWI inherent
-			case 0x3f:
+			OP(0x3f):
 				REG_CC = (REG_CC & ~CC_I) | cpu->itmp;
 				peek_byte(cpu, REG_PC);
 				stack_irq_registers(cpu);
@@ -842,22 +918,22 @@ static void mc6801_run(struct MC6801 *cpu) {
 			// 0x70 - 0x7f extended mode ops
 			// NOTE: illegal indexed and extended instructions
 			// appear to behave differently.  Needs investigating.
-			case 0x40: case 0x41: case 0x42: case 0x43:
-			case 0x44: case 0x45: case 0x46: case 0x47:
-			case 0x48: case 0x49: case 0x4a: case 0x4b:
-			case 0x4c: case 0x4d: case 0x4f:
-			case 0x50: case 0x51: case 0x52: case 0x53:
-			case 0x54: case 0x55: case 0x56: case 0x57:
-			case 0x58: case 0x59: case 0x5a: case 0x5b:
-			case 0x5c: case 0x5d: case 0x5f:
-			case 0x60: case 0x61: case 0x62: case 0x63:
-			case 0x64: case 0x65: case 0x66: case 0x67:
-			case 0x68: case 0x69: case 0x6a: case 0x6b:
-			case 0x6c: case 0x6d: case 0x6f:
-			case 0x70: case 0x71: case 0x72: case 0x73:
-			case 0x74: case 0x75: case 0x76: case 0x77:
-			case 0x78: case 0x79: case 0x7a: case 0x7b:
-			case 0x7c: case 0x7d: case 0x7f: {
+			OP(0x40): OP(0x41): OP(0x42): OP(0x43):
+			OP(0x44): OP(0x45): OP(0x46): OP(0x47):
+			OP(0x48): OP(0x49): OP(0x4a): OP(0x4b):
+			OP(0x4c): OP(0x4d): OP(0x4f):
+			OP(0x50): OP(0x51): OP(0x52): OP(0x53):
+			OP(0x54): OP(0x55): OP(0x56): OP(0x57):
+			OP(0x58): OP(0x59): OP(0x5a): OP(0x5b):
+			OP(0x5c): OP(0x5d): OP(0x5f):
+			OP(0x60): OP(0x61): OP(0x62): OP(0x63):
+			OP(0x64): OP(0x65): OP(0x66): OP(0x67):
+			OP(0x68): OP(0x69): OP(0x6a): OP(0x6b):
+			OP(0x6c): OP(0x6d): OP(0x6f):
+			OP(0x70): OP(0x71): OP(0x72): OP(0x73):
+			OP(0x74): OP(0x75): OP(0x76): OP(0x77):
+			OP(0x78): OP(0x79): OP(0x7a): OP(0x7b):
+			OP(0x7c): OP(0x7d): OP(0x7f): {
 				uint16_t ea;
 				unsigned tmp1;
 				switch ((op >> 4) & 0xf) {
@@ -916,14 +992,14 @@ static void mc6801_run(struct MC6801 *cpu) {
 			} break;
 
 			// 0x4e, 0x5e T (HCF)
-			case 0x4e:
-			case 0x5e:
+			OP(0x4e):
+			OP(0x5e):
 				cpu->state = mc6801_state_hcf;
 				break;
 
 			// 0x6e JMP indexed
 			// 0x7e JMP extended
-			case 0x6e: case 0x7e: {
+			OP(0x6e): OP(0x7e): {
 				unsigned ea;
 				switch ((op >> 4) & 0xf) {
 				case 0x6: ea = ea_indexed(cpu); break;
@@ -935,30 +1011,30 @@ static void mc6801_run(struct MC6801 *cpu) {
 
 			// 0x80 - 0xbf A register arithmetic ops
 			// 0xc0 - 0xff B register arithmetic ops
-			case 0x80: case 0x81: case 0x82:
-			case 0x84: case 0x85: case 0x86: case 0x87:
-			case 0x88: case 0x89: case 0x8a: case 0x8b:
-			case 0x90: case 0x91: case 0x92:
-			case 0x94: case 0x95: case 0x96:
-			case 0x98: case 0x99: case 0x9a: case 0x9b:
-			case 0xa0: case 0xa1: case 0xa2:
-			case 0xa4: case 0xa5: case 0xa6:
-			case 0xa8: case 0xa9: case 0xaa: case 0xab:
-			case 0xb0: case 0xb1: case 0xb2:
-			case 0xb4: case 0xb5: case 0xb6:
-			case 0xb8: case 0xb9: case 0xba: case 0xbb:
-			case 0xc0: case 0xc1: case 0xc2:
-			case 0xc4: case 0xc5: case 0xc6: case 0xc7:
-			case 0xc8: case 0xc9: case 0xca: case 0xcb:
-			case 0xd0: case 0xd1: case 0xd2:
-			case 0xd4: case 0xd5: case 0xd6:
-			case 0xd8: case 0xd9: case 0xda: case 0xdb:
-			case 0xe0: case 0xe1: case 0xe2:
-			case 0xe4: case 0xe5: case 0xe6:
-			case 0xe8: case 0xe9: case 0xea: case 0xeb:
-			case 0xf0: case 0xf1: case 0xf2:
-			case 0xf4: case 0xf5: case 0xf6:
-			case 0xf8: case 0xf9: case 0xfa: case 0xfb: {
+			OP(0x80): OP(0x81): OP(0x82):
+			OP(0x84): OP(0x85): OP(0x86): OP(0x87):
+			OP(0x88): OP(0x89): OP(0x8a): OP(0x8b):
+			OP(0x90): OP(0x91): OP(0x92):
+			OP(0x94): OP(0x95): OP(0x96):
+			OP(0x98): OP(0x99): OP(0x9a): OP(0x9b):
+			OP(0xa0): OP(0xa1): OP(0xa2):
+			OP(0xa4): OP(0xa5): OP(0xa6):
+			OP(0xa8): OP(0xa9): OP(0xaa): OP(0xab):
+			OP(0xb0): OP(0xb1): OP(0xb2):
+			OP(0xb4): OP(0xb5): OP(0xb6):
+			OP(0xb8): OP(0xb9): OP(0xba): OP(0xbb):
+			OP(0xc0): OP(0xc1): OP(0xc2):
+			OP(0xc4): OP(0xc5): OP(0xc6): OP(0xc7):
+			OP(0xc8): OP(0xc9): OP(0xca): OP(0xcb):
+			OP(0xd0): OP(0xd1): OP(0xd2):
+			OP(0xd4): OP(0xd5): OP(0xd6):
+			OP(0xd8): OP(0xd9): OP(0xda): OP(0xdb):
+			OP(0xe0): OP(0xe1): OP(0xe2):
+			OP(0xe4): OP(0xe5): OP(0xe6):
+			OP(0xe8): OP(0xe9): OP(0xea): OP(0xeb):
+			OP(0xf0): OP(0xf1): OP(0xf2):
+			OP(0xf4): OP(0xf5): OP(0xf6):
+			OP(0xf8): OP(0xf9): OP(0xfa): OP(0xfb): {
 				unsigned tmp1, tmp2;
 				tmp1 = !(op & 0x40) ? REG_A : REG_B;
 				switch ((op >> 4) & 3) {
@@ -992,8 +1068,8 @@ static void mc6801_run(struct MC6801 *cpu) {
 
 			// 0x83, 0x93, 0xa3, 0xb3 SUBD
 			// 0xc3, 0xd3, 0xe3, 0xf3 ADDD
-			case 0x83: case 0x93: case 0xa3: case 0xb3:
-			case 0xc3: case 0xd3: case 0xe3: case 0xf3: {
+			OP(0x83): OP(0x93): OP(0xa3): OP(0xb3):
+			OP(0xc3): OP(0xd3): OP(0xe3): OP(0xf3): {
 				unsigned tmp1, tmp2;
 				tmp1 = REG_D;
 				switch ((op >> 4) & 3) {
@@ -1013,7 +1089,7 @@ static void mc6801_run(struct MC6801 *cpu) {
 			} break;
 
 			// 0x8c, 0x9c, 0xac, 0xbc CPX
-			case 0x8c: case 0x9c: case 0xac: case 0xbc: {
+			OP(0x8c): OP(0x9c): OP(0xac): OP(0xbc): {
 				unsigned tmp2;
 				switch ((op >> 4) & 3) {
 				case 0: tmp2 = word_immediate(cpu); break;
@@ -1028,7 +1104,7 @@ static void mc6801_run(struct MC6801 *cpu) {
 
 			// 0x8d BSR
 			// 0x9d, 0xad, 0xbd JSR
-			case 0x8d: case 0x9d: case 0xad: case 0xbd: {
+			OP(0x8d): OP(0x9d): OP(0xad): OP(0xbd): {
 				unsigned ea;
 				switch ((op >> 4) & 3) {
 				case 0: ea = short_relative(cpu); ea += REG_PC; NVMA_CYCLE; break;
@@ -1045,9 +1121,9 @@ static void mc6801_run(struct MC6801 *cpu) {
 			// 0x8e, 0x9e, 0xae, 0xbe LDS
 			// 0xcc, 0xdc, 0xec, 0xfc LDD
 			// 0xce, 0xde, 0xee, 0xfe LDX
-			case 0x8e: case 0x9e: case 0xae: case 0xbe:
-			case 0xcc: case 0xdc: case 0xec: case 0xfc:
-			case 0xce: case 0xde: case 0xee: case 0xfe: {
+			OP(0x8e): OP(0x9e): OP(0xae): OP(0xbe):
+			OP(0xcc): OP(0xdc): OP(0xec): OP(0xfc):
+			OP(0xce): OP(0xde): OP(0xee): OP(0xfe): {
 				unsigned tmp1, tmp2;
 				switch ((op >> 4) & 3) {
 				case 0: tmp2 = word_immediate(cpu); break;
@@ -1069,8 +1145,8 @@ static void mc6801_run(struct MC6801 *cpu) {
 			// 0xcd, 0xcf XXX illegal
 			// TODO: behaviour not tested, this just gets the cycle
 			// count right
-			case 0x8f:
-			case 0xcd: case 0xcf: {
+			OP(0x8f):
+			OP(0xcd): OP(0xcf): {
 				unsigned tmp1;
 				(void)word_immediate(cpu);
 				switch (op & 0x4e) {
@@ -1085,8 +1161,8 @@ static void mc6801_run(struct MC6801 *cpu) {
 
 			// 0x97, 0xa7, 0xb7 STAA
 			// 0xd7, 0xe7, 0xf7 STAB
-			case 0x97: case 0xa7: case 0xb7:
-			case 0xd7: case 0xe7: case 0xf7: {
+			OP(0x97): OP(0xa7): OP(0xb7):
+			OP(0xd7): OP(0xe7): OP(0xf7): {
 				uint16_t ea;
 				uint8_t tmp1;
 				tmp1 = !(op & 0x40) ? REG_A : REG_B;
@@ -1104,9 +1180,9 @@ static void mc6801_run(struct MC6801 *cpu) {
 			// 0x9f, 0xaf, 0xbf STS
 			// 0xdd, 0xed, 0xfd STD
 			// 0xdf, 0xef, 0xff STX
-			case 0x9f: case 0xaf: case 0xbf:
-			case 0xdd: case 0xed: case 0xfd:
-			case 0xdf: case 0xef: case 0xff: {
+			OP(0x9f): OP(0xaf): OP(0xbf):
+			OP(0xdd): OP(0xed): OP(0xfd):
+			OP(0xdf): OP(0xef): OP(0xff): {
 				uint16_t ea, tmp1;
 				switch (op & 0x4e) {
 				default:
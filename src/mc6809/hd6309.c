@@ -145,6 +145,7 @@ static void instruction_posthook(struct MC6809 *cpu);
 #define STRUCT_CPU struct MC6809
 
 #include "mc6809_common.c"
+#include "mc680x/mc680x_dispatch.h"
 #include "mc680x/mc680x_ops.c"
 
 #define NATIVE_MODE (REG_MD & MD_NM)
@@ -322,6 +323,167 @@ static void hd6309_reset(struct MC6809 *cpu) {
 // Run CPU while cpu->running is true.
 
 static void hd6309_run(struct MC6809 *cpu) {
+#ifdef WANT_COMPUTED_GOTO
+	static void *const op_table[0x400] = {
+		[0x000] = &&op_0x00, &&op_0x01, &&op_0x02, &&op_0x03,
+		[0x004] = &&op_0x04, &&op_0x05, &&op_0x06, &&op_0x07,
+		[0x008] = &&op_0x08, &&op_0x09, &&op_0x0a, &&op_0x0b,
+		[0x00c] = &&op_0x0c, &&op_0x0d, &&op_0x0e, &&op_0x0f,
+		[0x010] = &&op_0x10, &&op_0x11, &&op_0x12, &&op_0x13,
+		[0x014] = &&op_0x14, &&op_default, &&op_0x16, &&op_0x17,
+		[0x018] = &&op_default, &&op_0x19, &&op_0x1a, &&op_default,
+		[0x01c] = &&op_0x1c, &&op_0x1d, &&op_0x1e, &&op_0x1f,
+		[0x020] = &&op_0x20, &&op_0x21, &&op_0x22, &&op_0x23,
+		[0x024] = &&op_0x24, &&op_0x25, &&op_0x26, &&op_0x27,
+		[0x028] = &&op_0x28, &&op_0x29, &&op_0x2a, &&op_0x2b,
+		[0x02c] = &&op_0x2c, &&op_0x2d, &&op_0x2e, &&op_0x2f,
+		[0x030] = &&op_0x30, &&op_0x31, &&op_0x32, &&op_0x33,
+		[0x034] = &&op_0x34, &&op_0x35, &&op_0x36, &&op_0x37,
+		[0x038] = &&op_default, &&op_0x39, &&op_0x3a, &&op_0x3b,
+		[0x03c] = &&op_0x3c, &&op_0x3d, &&op_default, &&op_0x3f,
+		[0x040] = &&op_0x40, &&op_default, &&op_default, &&op_0x43,
+		[0x044] = &&op_0x44, &&op_default, &&op_0x46, &&op_0x47,
+		[0x048] = &&op_0x48, &&op_0x49, &&op_0x4a, &&op_default,
+		[0x04c] = &&op_0x4c, &&op_0x4d, &&op_default, &&op_0x4f,
+		[0x050] = &&op_0x50, &&op_default, &&op_default, &&op_0x53,
+		[0x054] = &&op_0x54, &&op_default, &&op_0x56, &&op_0x57,
+		[0x058] = &&op_0x58, &&op_0x59, &&op_0x5a, &&op_default,
+		[0x05c] = &&op_0x5c, &&op_0x5d, &&op_default, &&op_0x5f,
+		[0x060] = &&op_0x60, &&op_0x61, &&op_0x62, &&op_0x63,
+		[0x064] = &&op_0x64, &&op_0x65, &&op_0x66, &&op_0x67,
+		[0x068] = &&op_0x68, &&op_0x69, &&op_0x6a, &&op_0x6b,
+		[0x06c] = &&op_0x6c, &&op_0x6d, &&op_0x6e, &&op_0x6f,
+		[0x070] = &&op_0x70, &&op_0x71, &&op_0x72, &&op_0x73,
+		[0x074] = &&op_0x74, &&op_0x75, &&op_0x76, &&op_0x77,
+		[0x078] = &&op_0x78, &&op_0x79, &&op_0x7a, &&op_0x7b,
+		[0x07c] = &&op_0x7c, &&op_0x7d, &&op_0x7e, &&op_0x7f,
+		[0x080] = &&op_0x80, &&op_0x81, &&op_0x82, &&op_0x83,
+		[0x084] = &&op_0x84, &&op_0x85, &&op_0x86, &&op_default,
+		[0x088] = &&op_0x88, &&op_0x89, &&op_0x8a, &&op_0x8b,
+		[0x08c] = &&op_0x8c, &&op_0x8d, &&op_0x8e, &&op_default,
+		[0x090] = &&op_0x90, &&op_0x91, &&op_0x92, &&op_0x93,
+		[0x094] = &&op_0x94, &&op_0x95, &&op_0x96, &&op_0x97,
+		[0x098] = &&op_0x98, &&op_0x99, &&op_0x9a, &&op_0x9b,
+		[0x09c] = &&op_0x9c, &&op_0x9d, &&op_0x9e, &&op_0x9f,
+		[0x0a0] = &&op_0xa0, &&op_0xa1, &&op_0xa2, &&op_0xa3,
+		[0x0a4] = &&op_0xa4, &&op_0xa5, &&op_0xa6, &&op_0xa7,
+		[0x0a8] = &&op_0xa8, &&op_0xa9, &&op_0xaa, &&op_0xab,
+		[0x0ac] = &&op_0xac, &&op_0xad, &&op_0xae, &&op_0xaf,
+		[0x0b0] = &&op_0xb0, &&op_0xb1, &&op_0xb2, &&op_0xb3,
+		[0x0b4] = &&op_0xb4, &&op_0xb5, &&op_0xb6, &&op_0xb7,
+		[0x0b8] = &&op_0xb8, &&op_0xb9, &&op_0xba, &&op_0xbb,
+		[0x0bc] = &&op_0xbc, &&op_0xbd, &&op_0xbe, &&op_0xbf,
+		[0x0c0] = &&op_0xc0, &&op_0xc1, &&op_0xc2, &&op_0xc3,
+		[0x0c4] = &&op_0xc4, &&op_0xc5, &&op_0xc6, &&op_default,
+		[0x0c8] = &&op_0xc8, &&op_0xc9, &&op_0xca, &&op_0xcb,
+		[0x0cc] = &&op_0xcc, &&op_0xcd, &&op_0xce, &&op_default,
+		[0x0d0] = &&op_0xd0, &&op_0xd1, &&op_0xd2, &&op_0xd3,
+		[0x0d4] = &&op_0xd4, &&op_0xd5, &&op_0xd6, &&op_0xd7,
+		[0x0d8] = &&op_0xd8, &&op_0xd9, &&op_0xda, &&op_0xdb,
+		[0x0dc] = &&op_0xdc, &&op_0xdd, &&op_0xde, &&op_0xdf,
+		[0x0e0] = &&op_0xe0, &&op_0xe1, &&op_0xe2, &&op_0xe3,
+		[0x0e4] = &&op_0xe4, &&op_0xe5, &&op_0xe6, &&op_0xe7,
+		[0x0e8] = &&op_0xe8, &&op_0xe9, &&op_0xea, &&op_0xeb,
+		[0x0ec] = &&op_0xec, &&op_0xed, &&op_0xee, &&op_0xef,
+		[0x0f0] = &&op_0xf0, &&op_0xf1, &&op_0xf2, &&op_0xf3,
+		[0x0f4] = &&op_0xf4, &&op_0xf5, &&op_0xf6, &&op_0xf7,
+		[0x0f8] = &&op_0xf8, &&op_0xf9, &&op_0xfa, &&op_0xfb,
+		[0x0fc] = &&op_0xfc, &&op_0xfd, &&op_0xfe, &&op_0xff,
+		[0x100 ... 0x20f] = &&op_default,
+		[0x210] = &&op_0x0210, &&op_0x0211, &&op_default, &&op_default,
+		[0x214 ... 0x220] = &&op_default,
+		[0x221] = &&op_0x0221, &&op_0x0222, &&op_0x0223, &&op_0x0224,
+		[0x225] = &&op_0x0225, &&op_0x0226, &&op_0x0227, &&op_0x0228,
+		[0x229] = &&op_0x0229, &&op_0x022a, &&op_0x022b, &&op_0x022c,
+		[0x22d] = &&op_0x022d, &&op_0x022e, &&op_0x022f, &&op_0x0230,
+		[0x231] = &&op_0x0231, &&op_0x0232, &&op_0x0233, &&op_0x0234,
+		[0x235] = &&op_0x0235, &&op_0x0236, &&op_0x0237, &&op_0x0238,
+		[0x239] = &&op_0x0239, &&op_0x023a, &&op_0x023b, &&op_default,
+		[0x23d] = &&op_default, &&op_default, &&op_0x023f, &&op_0x0240,
+		[0x241] = &&op_default, &&op_default, &&op_0x0243, &&op_0x0244,
+		[0x245] = &&op_default, &&op_0x0246, &&op_0x0247, &&op_0x0248,
+		[0x249] = &&op_0x0249, &&op_0x024a, &&op_default, &&op_0x024c,
+		[0x24d] = &&op_0x024d, &&op_default, &&op_0x024f, &&op_default,
+		[0x251] = &&op_default, &&op_default, &&op_0x0253, &&op_0x0254,
+		[0x255] = &&op_default, &&op_0x0256, &&op_default, &&op_default,
+		[0x259] = &&op_0x0259, &&op_0x025a, &&op_default, &&op_0x025c,
+		[0x25d] = &&op_0x025d, &&op_default, &&op_0x025f, &&op_default,
+		[0x261 ... 0x27f] = &&op_default,
+		[0x280] = &&op_0x0280, &&op_0x0281, &&op_0x0282, &&op_0x0283,
+		[0x284] = &&op_0x0284, &&op_0x0285, &&op_0x0286, &&op_default,
+		[0x288] = &&op_0x0288, &&op_0x0289, &&op_0x028a, &&op_0x028b,
+		[0x28c] = &&op_0x028c, &&op_default, &&op_0x028e, &&op_default,
+		[0x290] = &&op_0x0290, &&op_0x0291, &&op_0x0292, &&op_0x0293,
+		[0x294] = &&op_0x0294, &&op_0x0295, &&op_0x0296, &&op_0x0297,
+		[0x298] = &&op_0x0298, &&op_0x0299, &&op_0x029a, &&op_0x029b,
+		[0x29c] = &&op_0x029c, &&op_default, &&op_0x029e, &&op_0x029f,
+		[0x2a0] = &&op_0x02a0, &&op_0x02a1, &&op_0x02a2, &&op_0x02a3,
+		[0x2a4] = &&op_0x02a4, &&op_0x02a5, &&op_0x02a6, &&op_0x02a7,
+		[0x2a8] = &&op_0x02a8, &&op_0x02a9, &&op_0x02aa, &&op_0x02ab,
+		[0x2ac] = &&op_0x02ac, &&op_default, &&op_0x02ae, &&op_0x02af,
+		[0x2b0] = &&op_0x02b0, &&op_0x02b1, &&op_0x02b2, &&op_0x02b3,
+		[0x2b4] = &&op_0x02b4, &&op_0x02b5, &&op_0x02b6, &&op_0x02b7,
+		[0x2b8] = &&op_0x02b8, &&op_0x02b9, &&op_0x02ba, &&op_0x02bb,
+		[0x2bc] = &&op_0x02bc, &&op_default, &&op_0x02be, &&op_0x02bf,
+		[0x2c0 ... 0x2cd] = &&op_default,
+		[0x2ce] = &&op_0x02ce, &&op_default, &&op_default, &&op_default,
+		[0x2d2 ... 0x2db] = &&op_default,
+		[0x2dc] = &&op_0x02dc, &&op_0x02dd, &&op_0x02de, &&op_0x02df,
+		[0x2e0 ... 0x2eb] = &&op_default,
+		[0x2ec] = &&op_0x02ec, &&op_0x02ed, &&op_0x02ee, &&op_0x02ef,
+		[0x2f0 ... 0x2fb] = &&op_default,
+		[0x2fc] = &&op_0x02fc, &&op_0x02fd, &&op_0x02fe, &&op_0x02ff,
+		[0x300 ... 0x30f] = &&op_default,
+		[0x310] = &&op_0x0310, &&op_0x0311, &&op_default, &&op_default,
+		[0x314 ... 0x32f] = &&op_default,
+		[0x330] = &&op_0x0330, &&op_0x0331, &&op_0x0332, &&op_0x0333,
+		[0x334] = &&op_0x0334, &&op_0x0335, &&op_0x0336, &&op_0x0337,
+		[0x338] = &&op_0x0338, &&op_0x0339, &&op_0x033a, &&op_0x033b,
+		[0x33c] = &&op_0x033c, &&op_0x033d, &&op_default, &&op_0x033f,
+		[0x340] = &&op_default, &&op_default, &&op_default, &&op_0x0343,
+		[0x344] = &&op_default, &&op_default, &&op_default, &&op_default,
+		[0x348] = &&op_default, &&op_default, &&op_0x034a, &&op_default,
+		[0x34c] = &&op_0x034c, &&op_0x034d, &&op_default, &&op_0x034f,
+		[0x350] = &&op_default, &&op_default, &&op_default, &&op_0x0353,
+		[0x354] = &&op_default, &&op_default, &&op_default, &&op_default,
+		[0x358] = &&op_default, &&op_default, &&op_0x035a, &&op_default,
+		[0x35c] = &&op_0x035c, &&op_0x035d, &&op_default, &&op_0x035f,
+		[0x360 ... 0x37f] = &&op_default,
+		[0x380] = &&op_0x0380, &&op_0x0381, &&op_default, &&op_0x0383,
+		[0x384] = &&op_default, &&op_default, &&op_0x0386, &&op_default,
+		[0x388] = &&op_default, &&op_default, &&op_default, &&op_0x038b,
+		[0x38c] = &&op_0x038c, &&op_0x038d, &&op_0x038e, &&op_0x038f,
+		[0x390] = &&op_0x0390, &&op_0x0391, &&op_default, &&op_0x0393,
+		[0x394] = &&op_default, &&op_default, &&op_0x0396, &&op_0x0397,
+		[0x398] = &&op_default, &&op_default, &&op_default, &&op_0x039b,
+		[0x39c] = &&op_0x039c, &&op_0x039d, &&op_0x039e, &&op_0x039f,
+		[0x3a0] = &&op_0x03a0, &&op_0x03a1, &&op_default, &&op_0x03a3,
+		[0x3a4] = &&op_default, &&op_default, &&op_0x03a6, &&op_0x03a7,
+		[0x3a8] = &&op_default, &&op_default, &&op_default, &&op_0x03ab,
+		[0x3ac] = &&op_0x03ac, &&op_0x03ad, &&op_0x03ae, &&op_0x03af,
+		[0x3b0] = &&op_0x03b0, &&op_0x03b1, &&op_default, &&op_0x03b3,
+		[0x3b4] = &&op_default, &&op_default, &&op_0x03b6, &&op_0x03b7,
+		[0x3b8] = &&op_default, &&op_default, &&op_default, &&op_0x03bb,
+		[0x3bc] = &&op_0x03bc, &&op_0x03bd, &&op_0x03be, &&op_0x03bf,
+		[0x3c0] = &&op_0x03c0, &&op_0x03c1, &&op_default, &&op_default,
+		[0x3c4] = &&op_default, &&op_default, &&op_0x03c6, &&op_default,
+		[0x3c8] = &&op_default, &&op_default, &&op_default, &&op_0x03cb,
+		[0x3cc] = &&op_default, &&op_default, &&op_default, &&op_default,
+		[0x3d0] = &&op_0x03d0, &&op_0x03d1, &&op_default, &&op_default,
+		[0x3d4] = &&op_default, &&op_default, &&op_0x03d6, &&op_0x03d7,
+		[0x3d8] = &&op_default, &&op_default, &&op_default, &&op_0x03db,
+		[0x3dc] = &&op_default, &&op_default, &&op_default, &&op_default,
+		[0x3e0] = &&op_0x03e0, &&op_0x03e1, &&op_default, &&op_default,
+		[0x3e4] = &&op_default, &&op_default, &&op_0x03e6, &&op_0x03e7,
+		[0x3e8] = &&op_default, &&op_default, &&op_default, &&op_0x03eb,
+		[0x3ec] = &&op_default, &&op_default, &&op_default, &&op_default,
+		[0x3f0] = &&op_0x03f0, &&op_0x03f1, &&op_default, &&op_default,
+		[0x3f4] = &&op_default, &&op_default, &&op_0x03f6, &&op_0x03f7,
+		[0x3f8] = &&op_default, &&op_default, &&op_default, &&op_0x03fb,
+		[0x3fc] = &&op_default, &&op_default, &&op_default, &&op_default,
+	};
+#endif
+
 	struct HD6309 *hcpu = (struct HD6309 *)cpu;
 
 	do {
@@ -343,7 +505,7 @@ static void hd6309_run(struct MC6809 *cpu) {
 			if (!cpu->halt) {
 				take_interrupt(cpu, 0, MC6809_INT_VEC_RESET);
 			} else {
-				NVMA_CYCLE;
+				IDLE_CYCLE;
 			}
 			continue;
 
@@ -351,7 +513,7 @@ static void hd6309_run(struct MC6809 *cpu) {
 		case hd6309_state_done_instruction:
 		case hd6309_state_label_a:
 			if (cpu->halt) {
-				NVMA_CYCLE;
+				IDLE_CYCLE;
 				continue;
 			}
 			hcpu->state = hd6309_state_label_b;
@@ -383,6 +545,10 @@ static void hd6309_run(struct MC6809 *cpu) {
 				cpu->trace_pc = cpu->trace_next_pc = REG_PC;
 				cpu->trace_nbytes = 0;
 #endif
+				// Straight on to the fetch unless that hook (or the
+				// clock) stopped the CPU.
+				if (cpu->running)
+					goto next_instruction;
 			}
 			continue;
 
@@ -403,7 +569,7 @@ static void hd6309_run(struct MC6809 *cpu) {
 			cpu->nmi_active = cpu->nmi_latch;
 			cpu->firq_active = cpu->firq_latch;
 			cpu->irq_active = cpu->irq_latch;
-			NVMA_CYCLE;
+			IDLE_CYCLE;
 			if (!cpu->halt) {
 				hcpu->state = hd6309_state_dispatch_irq;
 			}
@@ -413,7 +579,7 @@ static void hd6309_run(struct MC6809 *cpu) {
 			cpu->nmi_active = cpu->nmi_latch;
 			cpu->firq_active = cpu->firq_latch;
 			cpu->irq_active = cpu->irq_latch;
-			NVMA_CYCLE;
+			IDLE_CYCLE;
 			if (cpu->nmi_active || cpu->firq_active || cpu->irq_active) {
 				NVMA_CYCLE;
 				instruction_posthook(cpu);
@@ -426,7 +592,7 @@ static void hd6309_run(struct MC6809 *cpu) {
 			continue;
 
 		case hd6309_state_sync_check_halt:
-			NVMA_CYCLE;
+			IDLE_CYCLE;
 			if (!cpu->halt) {
 				hcpu->state = hd6309_state_sync;
 			}
@@ -445,6 +611,28 @@ static void hd6309_run(struct MC6809 *cpu) {
 				hcpu->state = hd6309_state_label_a;
 				break;
 			}
+			// If nothing could interrupt, the machine may run any
+			// number of whole transfers in bulk.  Not possible if
+			// source and destination are the same register.
+			if (DELEGATE_DEFINED(cpu->block_transfer) &&
+			    hcpu->tfm_src != hcpu->tfm_dest &&
+			    !(cpu->nmi || cpu->nmi_latch) &&
+			    !(!(REG_CC & CC_F) && (cpu->firq || cpu->firq_active)) &&
+			    !(!(REG_CC & CC_I) && (cpu->irq || cpu->irq_active))) {
+				unsigned n = DELEGATE_CALL(cpu->block_transfer,
+							   *hcpu->tfm_src, (int16_t)hcpu->tfm_src_mod,
+							   *hcpu->tfm_dest, (int16_t)hcpu->tfm_dest_mod,
+							   REG_W);
+				if (n) {
+					REG_M = cpu->D;
+					*hcpu->tfm_src += n * hcpu->tfm_src_mod;
+					*hcpu->tfm_dest += n * hcpu->tfm_dest_mod;
+					REG_W -= n;
+					cpu->firq_latch = cpu->firq_active = cpu->firq;
+					cpu->irq_latch = cpu->irq_active = cpu->irq;
+					continue;
+				}
+			}
 			REG_M = fetch_byte_notrace(cpu, *hcpu->tfm_src);
 			hcpu->state = hd6309_state_tfm_write;
 			continue;
@@ -473,12 +661,14 @@ static void hd6309_run(struct MC6809 *cpu) {
 			continue;
 
 		case hd6309_state_next_instruction:
+		next_instruction:
 			{
 			unsigned op;
 			// Fetch op-code and process
 			op = byte_immediate(cpu);
 			op |= cpu->page;
 			hcpu->state = hd6309_state_label_a;
+			DISPATCH_OP(op_table, op);
 			switch (op) {
 
 			// 0x00 - 0x0f direct mode ops
@@ -486,26 +676,26 @@ static void hd6309_run(struct MC6809 *cpu) {
 			// 0x50 - 0x5f inherent B register ops
 			// 0x60 - 0x6f indexed mode ops
 			// 0x70 - 0x7f extended mode ops
-			case 0x00: case 0x03:
-			case 0x04: case 0x06: case 0x07:
-			case 0x08: case 0x09: case 0x0a:
-			case 0x0c: case 0x0d: case 0x0f:
-			case 0x40: case 0x43:
-			case 0x44: case 0x46: case 0x47:
-			case 0x48: case 0x49: case 0x4a:
-			case 0x4c: case 0x4d: case 0x4f:
-			case 0x50: case 0x53:
-			case 0x54: case 0x56: case 0x57:
-			case 0x58: case 0x59: case 0x5a:
-			case 0x5c: case 0x5d: case 0x5f:
-			case 0x60: case 0x63:
-			case 0x64: case 0x66: case 0x67:
-			case 0x68: case 0x69: case 0x6a:
-			case 0x6c: case 0x6d: case 0x6f:
-			case 0x70: case 0x73:
-			case 0x74: case 0x76: case 0x77:
-			case 0x78: case 0x79: case 0x7a:
-			case 0x7c: case 0x7d: case 0x7f: {
+			OP(0x00): OP(0x03):
+			OP(0x04): OP(0x06): OP(0x07):
+			OP(0x08): OP(0x09): OP(0x0a):
+			OP(0x0c): OP(0x0d): OP(0x0f):
+			OP(0x40): OP(0x43):
+			OP(0x44): OP(0x46): OP(0x47):
+			OP(0x48): OP(0x49): OP(0x4a):
+			OP(0x4c): OP(0x4d): OP(0x4f):
+			OP(0x50): OP(0x53):
+			OP(0x54): OP(0x56): OP(0x57):
+			OP(0x58): OP(0x59): OP(0x5a):
+			OP(0x5c): OP(0x5d): OP(0x5f):
+			OP(0x60): OP(0x63):
+			OP(0x64): OP(0x66): OP(0x67):
+			OP(0x68): OP(0x69): OP(0x6a):
+			OP(0x6c): OP(0x6d): OP(0x6f):
+			OP(0x70): OP(0x73):
+			OP(0x74): OP(0x76): OP(0x77):
+			OP(0x78): OP(0x79): OP(0x7a):
+			OP(0x7c): OP(0x7d): OP(0x7f): {
 				uint16_t ea;
 				unsigned tmp1;
 				switch ((op >> 4) & 0xf) {
@@ -569,10 +759,10 @@ static void hd6309_run(struct MC6809 *cpu) {
 			// 0x02, 0x62, 0x72 AIM
 			// 0x05, 0x65, 0x75 EIM
 			// 0x0b, 0x6b, 0x7b TIM
-			case 0x01: case 0x61: case 0x71:
-			case 0x02: case 0x62: case 0x72:
-			case 0x05: case 0x65: case 0x75:
-			case 0x0b: case 0x6b: case 0x7b: {
+			OP(0x01): OP(0x61): OP(0x71):
+			OP(0x02): OP(0x62): OP(0x72):
+			OP(0x05): OP(0x65): OP(0x75):
+			OP(0x0b): OP(0x6b): OP(0x7b): {
 				unsigned a, tmp1;
 				REG_M = byte_immediate(cpu);  // [hoglet67]
 				switch ((op >> 4) & 0xf) {
@@ -601,7 +791,7 @@ static void hd6309_run(struct MC6809 *cpu) {
 			// 0x0e JMP direct
 			// 0x6e JMP indexed
 			// 0x7e JMP extended
-			case 0x0e: case 0x6e: case 0x7e: {
+			OP(0x0e): OP(0x6e): OP(0x7e): {
 				unsigned ea;
 				switch ((op >> 4) & 0xf) {
 				case 0x0: ea = ea_direct(cpu); break;
@@ -614,9 +804,9 @@ static void hd6309_run(struct MC6809 *cpu) {
 
 			// 0x10 Page 2
 			// 0x1010, 0x1011 Page 2
-			case 0x10:
-			case 0x0210:
-			case 0x0211:
+			OP(0x10):
+			OP(0x0210):
+			OP(0x0211):
 				hcpu->state = hd6309_state_next_instruction;
 				cpu->page = 0x200;
 #ifdef TRACE
@@ -628,9 +818,9 @@ static void hd6309_run(struct MC6809 *cpu) {
 
 			// 0x11 Page 3
 			// 0x1110, 0x1111 Page 3
-			case 0x11:
-			case 0x0310:
-			case 0x0311:
+			OP(0x11):
+			OP(0x0310):
+			OP(0x0311):
 				hcpu->state = hd6309_state_next_instruction;
 				cpu->page = 0x300;
 #ifdef TRACE
@@ -641,19 +831,19 @@ static void hd6309_run(struct MC6809 *cpu) {
 				continue;
 
 			// 0x12 NOP inherent
-			case 0x12: peek_byte(cpu, REG_PC); break;
+			OP(0x12): peek_byte(cpu, REG_PC); break;
 
 			// 0x13 SYNC inherent
 			// TODO: "There appears to be a bug with SYNC in native
 			// mode" [hoglet67]
-			case 0x13:
+			OP(0x13):
 				if (!NATIVE_MODE)
 					peek_byte(cpu, REG_PC);
 				hcpu->state = hd6309_state_sync;
 				continue;
 
 			// 0x14 SEXW inherent
-			case 0x14:
+			OP(0x14):
 				REG_D = (REG_W & 0x8000) ? 0xffff : 0;
 				CLR_NZ;
 				SET_N16(REG_D);
@@ -665,7 +855,7 @@ static void hd6309_run(struct MC6809 *cpu) {
 				break;
 
 			// 0x16 LBRA relative
-			case 0x16: {
+			OP(0x16): {
 				uint16_t ea;
 				ea = long_relative(cpu);
 				REG_PC += ea;
@@ -675,7 +865,7 @@ static void hd6309_run(struct MC6809 *cpu) {
 			} break;
 
 			// 0x17 LBSR relative
-			case 0x17: {
+			OP(0x17): {
 				uint16_t ea;
 				ea = long_relative(cpu);
 				ea += REG_PC;
@@ -690,7 +880,7 @@ static void hd6309_run(struct MC6809 *cpu) {
 			} break;
 
 			// 0x19 DAA inherent
-			case 0x19:
+			OP(0x19):
 				// TODO: behaviour for illegal input differs on
 				// the 6309 [hoglet67]
 				REG_A = op_daa(cpu, REG_A);
@@ -698,7 +888,7 @@ static void hd6309_run(struct MC6809 *cpu) {
 				break;
 
 			// 0x1a ORCC immediate
-			case 0x1a: {
+			OP(0x1a): {
 				unsigned data;
 				data = byte_immediate(cpu);
 				REG_CC |= data;
@@ -706,7 +896,7 @@ static void hd6309_run(struct MC6809 *cpu) {
 			} break;
 
 			// 0x1c ANDCC immediate
-			case 0x1c: {
+			OP(0x1c): {
 				unsigned data;
 				data = byte_immediate(cpu);
 				REG_CC &= data;
@@ -714,7 +904,7 @@ static void hd6309_run(struct MC6809 *cpu) {
 			} break;
 
 			// 0x1d SEX inherent
-			case 0x1d:
+			OP(0x1d):
 				REG_D = sex8(REG_B);
 				CLR_NZ;
 				SET_NZ16(REG_D);
@@ -723,7 +913,7 @@ static void hd6309_run(struct MC6809 *cpu) {
 				break;
 
 			// 0x1e EXG immediate
-			case 0x1e: {
+			OP(0x1e): {
 				unsigned postbyte;
 				uint16_t tmp1, tmp2;
 				postbyte = byte_immediate(cpu);
@@ -789,7 +979,7 @@ static void hd6309_run(struct MC6809 *cpu) {
 			} break;
 
 			// 0x1f TFR immediate
-			case 0x1f: {
+			OP(0x1f): {
 				unsigned postbyte;
 				uint16_t tmp1;
 				postbyte = byte_immediate(cpu);
@@ -836,10 +1026,10 @@ static void hd6309_run(struct MC6809 *cpu) {
 			} break;
 
 			// 0x20 - 0x2f short branches
-			case 0x20: case 0x21: case 0x22: case 0x23:
-			case 0x24: case 0x25: case 0x26: case 0x27:
-			case 0x28: case 0x29: case 0x2a: case 0x2b:
-			case 0x2c: case 0x2d: case 0x2e: case 0x2f: {
+			OP(0x20): OP(0x21): OP(0x22): OP(0x23):
+			OP(0x24): OP(0x25): OP(0x26): OP(0x27):
+			OP(0x28): OP(0x29): OP(0x2a): OP(0x2b):
+			OP(0x2c): OP(0x2d): OP(0x2e): OP(0x2f): {
 				unsigned tmp = sex8(byte_immediate(cpu));
 				NVMA_CYCLE;
 				if (branch_condition(cpu, op))
@@ -847,7 +1037,7 @@ static void hd6309_run(struct MC6809 *cpu) {
 			} break;
 
 			// 0x30 LEAX indexed
-			case 0x30:
+			OP(0x30):
 				REG_X = ea_indexed(cpu);
 				CLR_Z;
 				SET_Z16(REG_X);
@@ -855,7 +1045,7 @@ static void hd6309_run(struct MC6809 *cpu) {
 				break;
 
 			// 0x31 LEAY indexed
-			case 0x31:
+			OP(0x31):
 				REG_Y = ea_indexed(cpu);
 				CLR_Z;
 				SET_Z16(REG_Y);
@@ -863,20 +1053,20 @@ static void hd6309_run(struct MC6809 *cpu) {
 				break;
 
 			// 0x32 LEAS indexed
-			case 0x32:
+			OP(0x32):
 				REG_S = ea_indexed(cpu);
 				NVMA_CYCLE;
 				cpu->nmi_armed = 1;
 				break;
 
 			// 0x33 LEAU indexed
-			case 0x33:
+			OP(0x33):
 				REG_U = ea_indexed(cpu);
 				NVMA_CYCLE;
 				break;
 
 			// 0x34 PSHS immediate
-			case 0x34:
+			OP(0x34):
 				{
 					unsigned postbyte = byte_immediate(cpu);
 					NVMA_CYCLE;
@@ -896,7 +1086,7 @@ static void hd6309_run(struct MC6809 *cpu) {
 				break;
 
 			// 0x35 PULS immediate
-			case 0x35:
+			OP(0x35):
 				{
 					unsigned postbyte = byte_immediate(cpu);
 					NVMA_CYCLE;
@@ -916,7 +1106,7 @@ static void hd6309_run(struct MC6809 *cpu) {
 				break;
 
 			// 0x36 PSHU immediate
-			case 0x36:
+			OP(0x36):
 				{
 					unsigned postbyte = byte_immediate(cpu);
 					NVMA_CYCLE;
@@ -935,7 +1125,7 @@ static void hd6309_run(struct MC6809 *cpu) {
 				break;
 
 			// 0x37 PULU immediate
-			case 0x37:
+			OP(0x37):
 				{
 					unsigned postbyte = byte_immediate(cpu);
 					NVMA_CYCLE;
@@ -954,14 +1144,14 @@ static void hd6309_run(struct MC6809 *cpu) {
 				break;
 
 			// 0x39 RTS inherent
-			case 0x39:
+			OP(0x39):
 				peek_byte(cpu, REG_PC);
 				REG_PC = pull_s_word(cpu);
 				NVMA_CYCLE;
 				break;
 
 			// 0x3a ABX inherent
-			case 0x3a:
+			OP(0x3a):
 				REG_X += REG_B;
 				peek_byte(cpu, REG_PC);
 				if (!NATIVE_MODE)
@@ -969,7 +1159,7 @@ static void hd6309_run(struct MC6809 *cpu) {
 				break;
 
 			// 0x3b RTI inherent
-			case 0x3b:
+			OP(0x3b):
 				peek_byte(cpu, REG_PC);
 				REG_CC = pull_s_byte(cpu);
 				if (REG_CC & CC_E) {
@@ -992,7 +1182,7 @@ static void hd6309_run(struct MC6809 *cpu) {
 				break;
 
 			// 0x3c CWAI immediate
-			case 0x3c: {
+			OP(0x3c): {
 				unsigned data;
 				data = byte_immediate(cpu);
 				REG_CC &= data;
@@ -1004,7 +1194,7 @@ static void hd6309_run(struct MC6809 *cpu) {
 			} break;
 
 			// 0x3d MUL inherent
-			case 0x3d: {
+			OP(0x3d): {
 				unsigned tmp;
 				REG_M = REG_B;
 				tmp = REG_A * REG_B;
@@ -1029,7 +1219,7 @@ static void hd6309_run(struct MC6809 *cpu) {
 			// 0x3f SWI inherent
 			// TODO: "There appears to be a bug with SWI in native
 			// mode, if it is interrupted with an NMI" [hoglet67]
-			case 0x3f:
+			OP(0x3f):
 				peek_byte(cpu, REG_PC);
 				stack_irq_registers(cpu, 1);
 				instruction_posthook(cpu);
@@ -1038,30 +1228,30 @@ static void hd6309_run(struct MC6809 *cpu) {
 
 			// 0x80 - 0xbf A register arithmetic ops
 			// 0xc0 - 0xff B register arithmetic ops
-			case 0x80: case 0x81: case 0x82:
-			case 0x84: case 0x85: case 0x86:
-			case 0x88: case 0x89: case 0x8a: case 0x8b:
-			case 0x90: case 0x91: case 0x92:
-			case 0x94: case 0x95: case 0x96:
-			case 0x98: case 0x99: case 0x9a: case 0x9b:
-			case 0xa0: case 0xa1: case 0xa2:
-			case 0xa4: case 0xa5: case 0xa6:
-			case 0xa8: case 0xa9: case 0xaa: case 0xab:
-			case 0xb0: case 0xb1: case 0xb2:
-			case 0xb4: case 0xb5: case 0xb6:
-			case 0xb8: case 0xb9: case 0xba: case 0xbb:
-			case 0xc0: case 0xc1: case 0xc2:
-			case 0xc4: case 0xc5: case 0xc6:
-			case 0xc8: case 0xc9: case 0xca: case 0xcb:
-			case 0xd0: case 0xd1: case 0xd2:
-			case 0xd4: case 0xd5: case 0xd6:
-			case 0xd8: case 0xd9: case 0xda: case 0xdb:
-			case 0xe0: case 0xe1: case 0xe2:
-			case 0xe4: case 0xe5: case 0xe6:
-			case 0xe8: case 0xe9: case 0xea: case 0xeb:
-			case 0xf0: case 0xf1: case 0xf2:
-			case 0xf4: case 0xf5: case 0xf6:
-			case 0xf8: case 0xf9: case 0xfa: case 0xfb: {
+			OP(0x80): OP(0x81): OP(0x82):
+			OP(0x84): OP(0x85): OP(0x86):
+			OP(0x88): OP(0x89): OP(0x8a): OP(0x8b):
+			OP(0x90): OP(0x91): OP(0x92):
+			OP(0x94): OP(0x95): OP(0x96):
+			OP(0x98): OP(0x99): OP(0x9a): OP(0x9b):
+			OP(0xa0): OP(0xa1): OP(0xa2):
+			OP(0xa4): OP(0xa5): OP(0xa6):
+			OP(0xa8): OP(0xa9): OP(0xaa): OP(0xab):
+			OP(0xb0): OP(0xb1): OP(0xb2):
+			OP(0xb4): OP(0xb5): OP(0xb6):
+			OP(0xb8): OP(0xb9): OP(0xba): OP(0xbb):
+			OP(0xc0): OP(0xc1): OP(0xc2):
+			OP(0xc4): OP(0xc5): OP(0xc6):
+			OP(0xc8): OP(0xc9): OP(0xca): OP(0xcb):
+			OP(0xd0): OP(0xd1): OP(0xd2):
+			OP(0xd4): OP(0xd5): OP(0xd6):
+			OP(0xd8): OP(0xd9): OP(0xda): OP(0xdb):
+			OP(0xe0): OP(0xe1): OP(0xe2):
+			OP(0xe4): OP(0xe5): OP(0xe6):
+			OP(0xe8): OP(0xe9): OP(0xea): OP(0xeb):
+			OP(0xf0): OP(0xf1): OP(0xf2):
+			OP(0xf4): OP(0xf5): OP(0xf6):
+			OP(0xf8): OP(0xf9): OP(0xfa): OP(0xfb): {
 				unsigned tmp1, tmp2;
 				switch ((op >> 4) & 3) {
 				case 0: tmp2 = byte_immediate(cpu); break;
@@ -1093,8 +1283,8 @@ static void hd6309_run(struct MC6809 *cpu) {
 
 			// 0x83, 0x93, 0xa3, 0xb3 SUBD
 			// 0xc3, 0xd3, 0xe3, 0xf3 ADDD
-			case 0x83: case 0x93: case 0xa3: case 0xb3:
-			case 0xc3: case 0xd3: case 0xe3: case 0xf3: {
+			OP(0x83): OP(0x93): OP(0xa3): OP(0xb3):
+			OP(0xc3): OP(0xd3): OP(0xe3): OP(0xf3): {
 				unsigned tmp1, tmp2;
 				switch ((op >> 4) & 3) {
 				case 0: tmp2 = word_immediate(cpu); break;
@@ -1119,11 +1309,11 @@ static void hd6309_run(struct MC6809 *cpu) {
 			// 0x108c, 0x109c, 0x10ac, 0x10bc CMPY
 			// 0x1183, 0x1193, 0x11a3, 0x11b3 CMPU
 			// 0x118c, 0x119c, 0x11ac, 0x11bc CMPS
-			case 0x8c: case 0x9c: case 0xac: case 0xbc:
-			case 0x0283: case 0x0293: case 0x02a3: case 0x02b3:
-			case 0x028c: case 0x029c: case 0x02ac: case 0x02bc:
-			case 0x0383: case 0x0393: case 0x03a3: case 0x03b3:
-			case 0x038c: case 0x039c: case 0x03ac: case 0x03bc: {
+			OP(0x8c): OP(0x9c): OP(0xac): OP(0xbc):
+			OP(0x0283): OP(0x0293): OP(0x02a3): OP(0x02b3):
+			OP(0x028c): OP(0x029c): OP(0x02ac): OP(0x02bc):
+			OP(0x0383): OP(0x0393): OP(0x03a3): OP(0x03b3):
+			OP(0x038c): OP(0x039c): OP(0x03ac): OP(0x03bc): {
 				unsigned tmp1, tmp2;
 				switch ((op >> 4) & 3) {
 				case 0: tmp2 = word_immediate(cpu); break;
@@ -1147,7 +1337,7 @@ static void hd6309_run(struct MC6809 *cpu) {
 
 			// 0x8d BSR
 			// 0x9d, 0xad, 0xbd JSR
-			case 0x8d: case 0x9d: case 0xad: case 0xbd: {
+			OP(0x8d): OP(0x9d): OP(0xad): OP(0xbd): {
 				uint16_t ea;
 				switch ((op >> 4) & 3) {
 				case 0: ea = short_relative(cpu); ea += REG_PC; NVMA_CYCLE; NVMA_CYCLE; if (!NATIVE_MODE) NVMA_CYCLE; break;
@@ -1166,12 +1356,12 @@ static void hd6309_run(struct MC6809 *cpu) {
 			// 0x1086, 0x1096, 0x10a6, 0x10b6 LDW
 			// 0x108e, 0x109e, 0x10ae, 0x10be LDY
 			// 0x10ce, 0x10de, 0x10ee, 0x10fe LDS
-			case 0x8e: case 0x9e: case 0xae: case 0xbe:
-			case 0xcc: case 0xdc: case 0xec: case 0xfc:
-			case 0xce: case 0xde: case 0xee: case 0xfe:
-			case 0x0286: case 0x0296: case 0x02a6: case 0x02b6:
-			case 0x028e: case 0x029e: case 0x02ae: case 0x02be:
-			case 0x02ce: case 0x02de: case 0x02ee: case 0x02fe: {
+			OP(0x8e): OP(0x9e): OP(0xae): OP(0xbe):
+			OP(0xcc): OP(0xdc): OP(0xec): OP(0xfc):
+			OP(0xce): OP(0xde): OP(0xee): OP(0xfe):
+			OP(0x0286): OP(0x0296): OP(0x02a6): OP(0x02b6):
+			OP(0x028e): OP(0x029e): OP(0x02ae): OP(0x02be):
+			OP(0x02ce): OP(0x02de): OP(0x02ee): OP(0x02fe): {
 				unsigned tmp1, tmp2;
 				switch ((op >> 4) & 3) {
 				case 0: tmp2 = word_immediate(cpu); break;
@@ -1196,10 +1386,10 @@ static void hd6309_run(struct MC6809 *cpu) {
 			// 0xd7, 0xe7, 0xf7 STB
 			// 0x1197, 0x11a7, 0x11b7 STE
 			// 0x11d7, 0x11e7, 0x11f7 STF
-			case 0x97: case 0xa7: case 0xb7:
-			case 0xd7: case 0xe7: case 0xf7:
-			case 0x0397: case 0x03a7: case 0x03b7:
-			case 0x03d7: case 0x03e7: case 0x03f7: {
+			OP(0x97): OP(0xa7): OP(0xb7):
+			OP(0xd7): OP(0xe7): OP(0xf7):
+			OP(0x0397): OP(0x03a7): OP(0x03b7):
+			OP(0x03d7): OP(0x03e7): OP(0x03f7): {
 				uint16_t ea;
 				uint8_t tmp1;
 				switch ((op >> 4) & 3) {
@@ -1226,12 +1416,12 @@ static void hd6309_run(struct MC6809 *cpu) {
 			// 0x1097, 0x10a7, 0x10b7 STW
 			// 0x109f, 0x10af, 0x10bf STY
 			// 0x10df, 0x10ef, 0x10ff STS
-			case 0x9f: case 0xaf: case 0xbf:
-			case 0xdd: case 0xed: case 0xfd:
-			case 0xdf: case 0xef: case 0xff:
-			case 0x0297: case 0x02a7: case 0x02b7:
-			case 0x029f: case 0x02af: case 0x02bf:
-			case 0x02df: case 0x02ef: case 0x02ff: {
+			OP(0x9f): OP(0xaf): OP(0xbf):
+			OP(0xdd): OP(0xed): OP(0xfd):
+			OP(0xdf): OP(0xef): OP(0xff):
+			OP(0x0297): OP(0x02a7): OP(0x02b7):
+			OP(0x029f): OP(0x02af): OP(0x02bf):
+			OP(0x02df): OP(0x02ef): OP(0x02ff): {
 				uint16_t ea, tmp1;
 				switch ((op >> 4) & 3) {
 				case 1: ea = ea_direct(cpu); break;
@@ -1255,7 +1445,7 @@ static void hd6309_run(struct MC6809 *cpu) {
 			} break;
 
 			// 0xcd LDQ immediate
-			case 0xcd: {
+			OP(0xcd): {
 				REG_D = word_immediate(cpu);
 				REG_W = word_immediate(cpu);
 				CLR_NZ;  // V not cleared [hoglet67]
@@ -1266,10 +1456,10 @@ static void hd6309_run(struct MC6809 *cpu) {
 			} break;
 
 			// 0x1021 - 0x102f long branches
-			case 0x0221: case 0x0222: case 0x0223:
-			case 0x0224: case 0x0225: case 0x0226: case 0x0227:
-			case 0x0228: case 0x0229: case 0x022a: case 0x022b:
-			case 0x022c: case 0x022d: case 0x022e: case 0x022f: {
+			OP(0x0221): OP(0x0222): OP(0x0223):
+			OP(0x0224): OP(0x0225): OP(0x0226): OP(0x0227):
+			OP(0x0228): OP(0x0229): OP(0x022a): OP(0x022b):
+			OP(0x022c): OP(0x022d): OP(0x022e): OP(0x022f): {
 				unsigned tmp = word_immediate(cpu);
 				if (branch_condition(cpu, op)) {
 					REG_PC += tmp;
@@ -1293,8 +1483,8 @@ static void hd6309_run(struct MC6809 *cpu) {
 			// 0x1035 ORR
 			// 0x1036 EORR
 			// 0x1037 CMPR
-			case 0x0230: case 0x0231: case 0x0232: case 0x0233:
-			case 0x0234: case 0x0235: case 0x0236: case 0x0237: {
+			OP(0x0230): OP(0x0231): OP(0x0232): OP(0x0233):
+			OP(0x0234): OP(0x0235): OP(0x0236): OP(0x0237): {
 				unsigned postbyte;
 				postbyte = byte_immediate(cpu);
 				unsigned tmp1, tmp2;
@@ -1406,7 +1596,7 @@ static void hd6309_run(struct MC6809 *cpu) {
 			} break;
 
 			// 0x1038 PSHSW inherent
-			case 0x0238:
+			OP(0x0238):
 				NVMA_CYCLE;
 				NVMA_CYCLE;
 				push_s_byte(cpu, REG_F);
@@ -1414,7 +1604,7 @@ static void hd6309_run(struct MC6809 *cpu) {
 				break;
 
 			// 0x1039 PULSW inherent
-			case 0x0239:
+			OP(0x0239):
 				NVMA_CYCLE;
 				NVMA_CYCLE;
 				REG_E = pull_s_byte(cpu);
@@ -1422,7 +1612,7 @@ static void hd6309_run(struct MC6809 *cpu) {
 				break;
 
 			// 0x103a PSHUW inherent
-			case 0x023a:
+			OP(0x023a):
 				NVMA_CYCLE;
 				NVMA_CYCLE;
 				push_u_byte(cpu, REG_F);
@@ -1430,7 +1620,7 @@ static void hd6309_run(struct MC6809 *cpu) {
 				break;
 
 			// 0x103b PULUW inherent
-			case 0x023b:
+			OP(0x023b):
 				NVMA_CYCLE;
 				NVMA_CYCLE;
 				REG_E = pull_u_byte(cpu);
@@ -1438,7 +1628,7 @@ static void hd6309_run(struct MC6809 *cpu) {
 				break;
 
 			// 0x103f SWI2 inherent
-			case 0x023f:
+			OP(0x023f):
 				peek_byte(cpu, REG_PC);
 				stack_irq_registers(cpu, 1);
 				instruction_posthook(cpu);
@@ -1449,14 +1639,14 @@ static void hd6309_run(struct MC6809 *cpu) {
 
 			// 0x1040 - 0x104f D register inherent ops
 			// 0x1050 - 0x105f W register inherent ops
-			case 0x0240: case 0x0243:
-			case 0x0244: case 0x0246: case 0x0247:
-			case 0x0248: case 0x0249: case 0x024a:
-			case 0x024c: case 0x024d: case 0x024f:
-			case 0x0253:
-			case 0x0254: case 0x0256:
-			case 0x0259: case 0x025a:
-			case 0x025c: case 0x025d: case 0x025f: {
+			OP(0x0240): OP(0x0243):
+			OP(0x0244): OP(0x0246): OP(0x0247):
+			OP(0x0248): OP(0x0249): OP(0x024a):
+			OP(0x024c): OP(0x024d): OP(0x024f):
+			OP(0x0253):
+			OP(0x0254): OP(0x0256):
+			OP(0x0259): OP(0x025a):
+			OP(0x025c): OP(0x025d): OP(0x025f): {
 				unsigned tmp1;
 				tmp1 = !(op & 0x10) ? REG_D : REG_W;
 				switch (op & 0xf) {
@@ -1493,9 +1683,9 @@ static void hd6309_run(struct MC6809 *cpu) {
 			// 0x1080, 0x1090, 0x10a0, 0x10b0 SUBW
 			// 0x1081, 0x1091, 0x10a1, 0x10b1 CMPW
 			// 0x108b, 0x109b, 0x10ab, 0x10bb ADDW
-			case 0x0280: case 0x0290: case 0x02a0: case 0x02b0:
-			case 0x0281: case 0x0291: case 0x02a1: case 0x02b1:
-			case 0x028b: case 0x029b: case 0x02ab: case 0x02bb: {
+			OP(0x0280): OP(0x0290): OP(0x02a0): OP(0x02b0):
+			OP(0x0281): OP(0x0291): OP(0x02a1): OP(0x02b1):
+			OP(0x028b): OP(0x029b): OP(0x02ab): OP(0x02bb): {
 				unsigned tmp1, tmp2;
 				switch ((op >> 4) & 3) {
 				case 0: tmp2 = word_immediate(cpu); break;
@@ -1522,12 +1712,12 @@ static void hd6309_run(struct MC6809 *cpu) {
 			// 0x1088, 0x1098, 0x10a8, 0x10b8 EORD
 			// 0x1089, 0x1099, 0x10a9, 0x10b9 ADCD
 			// 0x108a, 0x109a, 0x10aa, 0x10ba ORD
-			case 0x0282: case 0x0292: case 0x02a2: case 0x02b2:
-			case 0x0284: case 0x0294: case 0x02a4: case 0x02b4:
-			case 0x0285: case 0x0295: case 0x02a5: case 0x02b5:
-			case 0x0288: case 0x0298: case 0x02a8: case 0x02b8:
-			case 0x0289: case 0x0299: case 0x02a9: case 0x02b9:
-			case 0x028a: case 0x029a: case 0x02aa: case 0x02ba: {
+			OP(0x0282): OP(0x0292): OP(0x02a2): OP(0x02b2):
+			OP(0x0284): OP(0x0294): OP(0x02a4): OP(0x02b4):
+			OP(0x0285): OP(0x0295): OP(0x02a5): OP(0x02b5):
+			OP(0x0288): OP(0x0298): OP(0x02a8): OP(0x02b8):
+			OP(0x0289): OP(0x0299): OP(0x02a9): OP(0x02b9):
+			OP(0x028a): OP(0x029a): OP(0x02aa): OP(0x02ba): {
 				unsigned tmp1, tmp2;
 				switch ((op >> 4) & 3) {
 				case 0: tmp2 = word_immediate(cpu); break;
@@ -1552,7 +1742,7 @@ static void hd6309_run(struct MC6809 *cpu) {
 			} break;
 
 			// 0x10dc, 0x10ec, 0x10fc LDQ
-			case 0x02dc: case 0x02ec: case 0x02fc: {
+			OP(0x02dc): OP(0x02ec): OP(0x02fc): {
 				unsigned ea;
 				switch ((op >> 4) & 3) {
 				case 1: ea = ea_direct(cpu); break;
@@ -1569,7 +1759,7 @@ static void hd6309_run(struct MC6809 *cpu) {
 			} break;
 
 			// 0x10dd, 0x10ed, 0x10fd STQ
-			case 0x02dd: case 0x02ed: case 0x02fd: {
+			OP(0x02dd): OP(0x02ed): OP(0x02fd): {
 				unsigned ea;
 				switch ((op >> 4) & 3) {
 				case 1: ea = ea_direct(cpu); break;
@@ -1588,8 +1778,8 @@ static void hd6309_run(struct MC6809 *cpu) {
 			} break;
 
 			// 0x1130 - 0x1137 direct logical bit ops
-			case 0x0330: case 0x0331: case 0x0332: case 0x0333:
-			case 0x0334: case 0x0335: case 0x0336: case 0x0337: {
+			OP(0x0330): OP(0x0331): OP(0x0332): OP(0x0333):
+			OP(0x0334): OP(0x0335): OP(0x0336): OP(0x0337): {
 				unsigned postbyte;
 				unsigned mem_byte;
 				unsigned ea;
@@ -1664,7 +1854,7 @@ static void hd6309_run(struct MC6809 *cpu) {
 			// 0x1139 TFM r0-,r1-
 			// 0x113a TFM r0+,r1
 			// 0x113b TFM r0,r1+
-			case 0x0338: case 0x0339: case 0x033a: case 0x033b: {
+			OP(0x0338): OP(0x0339): OP(0x033a): OP(0x033b): {
 				unsigned postbyte;
 				switch (op & 3) {
 				case 0: hcpu->tfm_src_mod = hcpu->tfm_dest_mod = 1; break;
@@ -1693,7 +1883,7 @@ static void hd6309_run(struct MC6809 *cpu) {
 			}
 
 			// 0x113c BITMD immediate
-			case 0x033c: {
+			OP(0x033c): {
 				REG_M = byte_immediate(cpu);
 				unsigned data = REG_M & (MD_D0 | MD_IL);
 				if (REG_MD & data)
@@ -1705,7 +1895,7 @@ static void hd6309_run(struct MC6809 *cpu) {
 			} break;
 
 			// 0x113d LDMD immediate
-			case 0x033d: {
+			OP(0x033d): {
 				unsigned data;
 				data = byte_immediate(cpu);
 				data &= (MD_FM | MD_NM);
@@ -1715,7 +1905,7 @@ static void hd6309_run(struct MC6809 *cpu) {
 			} break;
 
 			// 0x113f SWI3 inherent
-			case 0x033f:
+			OP(0x033f):
 				peek_byte(cpu, REG_PC);
 				stack_irq_registers(cpu, 1);
 				instruction_posthook(cpu);
@@ -1724,12 +1914,12 @@ static void hd6309_run(struct MC6809 *cpu) {
 
 			// 0x1140 - 0x114f E register inherent ops
 			// 0x1150 - 0x115f F register inherent ops
-			case 0x0343:
-			case 0x034a:
-			case 0x034c: case 0x034d: case 0x034f:
-			case 0x0353:
-			case 0x035a:
-			case 0x035c: case 0x035d: case 0x035f: {
+			OP(0x0343):
+			OP(0x034a):
+			OP(0x034c): OP(0x034d): OP(0x034f):
+			OP(0x0353):
+			OP(0x035a):
+			OP(0x035c): OP(0x035d): OP(0x035f): {
 				unsigned tmp1;
 				tmp1 = !(op & 0x10) ? REG_E : REG_F;
 				switch (op & 0xf) {
@@ -1760,14 +1950,14 @@ static void hd6309_run(struct MC6809 *cpu) {
 
 			// 0x1180 - 0x11bf E register arithmetic ops
 			// 0x11c0 - 0x11ff F register arithmetic ops
-			case 0x0380: case 0x0381: case 0x0386: case 0x038b:
-			case 0x0390: case 0x0391: case 0x0396: case 0x039b:
-			case 0x03a0: case 0x03a1: case 0x03a6: case 0x03ab:
-			case 0x03b0: case 0x03b1: case 0x03b6: case 0x03bb:
-			case 0x03c0: case 0x03c1: case 0x03c6: case 0x03cb:
-			case 0x03d0: case 0x03d1: case 0x03d6: case 0x03db:
-			case 0x03e0: case 0x03e1: case 0x03e6: case 0x03eb:
-			case 0x03f0: case 0x03f1: case 0x03f6: case 0x03fb: {
+			OP(0x0380): OP(0x0381): OP(0x0386): OP(0x038b):
+			OP(0x0390): OP(0x0391): OP(0x0396): OP(0x039b):
+			OP(0x03a0): OP(0x03a1): OP(0x03a6): OP(0x03ab):
+			OP(0x03b0): OP(0x03b1): OP(0x03b6): OP(0x03bb):
+			OP(0x03c0): OP(0x03c1): OP(0x03c6): OP(0x03cb):
+			OP(0x03d0): OP(0x03d1): OP(0x03d6): OP(0x03db):
+			OP(0x03e0): OP(0x03e1): OP(0x03e6): OP(0x03eb):
+			OP(0x03f0): OP(0x03f1): OP(0x03f6): OP(0x03fb): {
 				unsigned tmp1, tmp2;
 				switch ((op >> 4) & 3) {
 				case 0: tmp2 = byte_immediate(cpu); break;
@@ -1792,7 +1982,7 @@ static void hd6309_run(struct MC6809 *cpu) {
 			} break;
 
 			// 0x118d, 0x119d, 0x11ad, 0x11bd DIVD
-			case 0x038d: case 0x039d: case 0x03ad: case 0x03bd: {
+			OP(0x038d): OP(0x039d): OP(0x03ad): OP(0x03bd): {
 				uint16_t tmp1;
 				uint8_t tmp2;
 				switch ((op >> 4) & 3) {
@@ -1880,7 +2070,7 @@ static void hd6309_run(struct MC6809 *cpu) {
 			} break;
 
 			// 0x118e, 0x119e, 0x11ae, 0x11be DIVQ
-			case 0x038e: case 0x039e: case 0x03ae: case 0x03be: {
+			OP(0x038e): OP(0x039e): OP(0x03ae): OP(0x03be): {
 				uint32_t tmp1;
 				uint16_t tmp2;
 				switch ((op >> 4) & 3) {
@@ -1968,7 +2158,7 @@ static void hd6309_run(struct MC6809 *cpu) {
 			} break;
 
 			// 0x118f, 0x119f, 0x11af, 0x11bf MULD
-			case 0x038f: case 0x039f: case 0x03af: case 0x03bf: {
+			OP(0x038f): OP(0x039f): OP(0x03af): OP(0x03bf): {
 				uint16_t tmp1, tmp2;
 				switch ((op >> 4) & 3) {
 				case 0: tmp2 = word_immediate(cpu); break;
@@ -1995,7 +2185,7 @@ static void hd6309_run(struct MC6809 *cpu) {
 			} break;
 
 			// Illegal instruction
-			default:
+			OP_DEFAULT:
 				// XXX Two dead cycles?  Verify further!
 				peek_byte(cpu, cpu->reg_pc);
 				peek_byte(cpu, cpu->reg_pc);
@@ -40,6 +40,16 @@
 // Additionally, I quite early on made reference to MAME source to understand
 // the overflow (V) flag.
 
+// Note that there is deliberately no predecode or instruction cache here.
+// Every opcode, postbyte and operand byte is the result of a bus cycle that
+// the machine must see (SAM timing, cartridge snooping, watchpoints), so a
+// cached decode would still have to wait on the same mem_cycle() calls that
+// supply the bytes it was keyed on.  Once a byte is in hand, the switch
+// below is already a single indexed jump (or, configured with
+// --enable-computed-goto, a jump through op_table; see mc680x_dispatch.h).
+// Memory access cost is instead addressed per-machine, in the mem_cycle()
+// delegates.
+
 // TODO:
 //
 // - Many more instructions fall through to their unprefixed form after a
@@ -157,6 +167,7 @@ static uint8_t op_xclr(struct MC6809 *cpu, uint8_t in);
 #define STRUCT_CPU struct MC6809
 
 #include "mc6809_common.c"
+#include "mc680x/mc680x_dispatch.h"
 #include "mc680x/mc680x_ops.c"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -256,6 +267,200 @@ static void mc6809_reset(struct MC6809 *cpu) {
 // Run CPU while cpu->running is true.
 
 static void mc6809_run(struct MC6809 *cpu) {
+#ifdef WANT_COMPUTED_GOTO
+	static void *const op_table[0x400] = {
+		[0x000] = &&op_0x00, &&op_0x01, &&op_0x02, &&op_0x03,
+		[0x004] = &&op_0x04, &&op_0x05, &&op_0x06, &&op_0x07,
+		[0x008] = &&op_0x08, &&op_0x09, &&op_0x0a, &&op_0x0b,
+		[0x00c] = &&op_0x0c, &&op_0x0d, &&op_0x0e, &&op_0x0f,
+		[0x010] = &&op_0x10, &&op_0x11, &&op_0x12, &&op_0x13,
+		[0x014] = &&op_0x14, &&op_0x15, &&op_0x16, &&op_0x17,
+		[0x018] = &&op_0x18, &&op_0x19, &&op_0x1a, &&op_0x1b,
+		[0x01c] = &&op_0x1c, &&op_0x1d, &&op_0x1e, &&op_0x1f,
+		[0x020] = &&op_0x20, &&op_0x21, &&op_0x22, &&op_0x23,
+		[0x024] = &&op_0x24, &&op_0x25, &&op_0x26, &&op_0x27,
+		[0x028] = &&op_0x28, &&op_0x29, &&op_0x2a, &&op_0x2b,
+		[0x02c] = &&op_0x2c, &&op_0x2d, &&op_0x2e, &&op_0x2f,
+		[0x030] = &&op_0x30, &&op_0x31, &&op_0x32, &&op_0x33,
+		[0x034] = &&op_0x34, &&op_0x35, &&op_0x36, &&op_0x37,
+		[0x038] = &&op_0x38, &&op_0x39, &&op_0x3a, &&op_0x3b,
+		[0x03c] = &&op_0x3c, &&op_0x3d, &&op_0x3e, &&op_0x3f,
+		[0x040] = &&op_0x40, &&op_0x41, &&op_0x42, &&op_0x43,
+		[0x044] = &&op_0x44, &&op_0x45, &&op_0x46, &&op_0x47,
+		[0x048] = &&op_0x48, &&op_0x49, &&op_0x4a, &&op_0x4b,
+		[0x04c] = &&op_0x4c, &&op_0x4d, &&op_0x4e, &&op_0x4f,
+		[0x050] = &&op_0x50, &&op_0x51, &&op_0x52, &&op_0x53,
+		[0x054] = &&op_0x54, &&op_0x55, &&op_0x56, &&op_0x57,
+		[0x058] = &&op_0x58, &&op_0x59, &&op_0x5a, &&op_0x5b,
+		[0x05c] = &&op_0x5c, &&op_0x5d, &&op_0x5e, &&op_0x5f,
+		[0x060] = &&op_0x60, &&op_0x61, &&op_0x62, &&op_0x63,
+		[0x064] = &&op_0x64, &&op_0x65, &&op_0x66, &&op_0x67,
+		[0x068] = &&op_0x68, &&op_0x69, &&op_0x6a, &&op_0x6b,
+		[0x06c] = &&op_0x6c, &&op_0x6d, &&op_0x6e, &&op_0x6f,
+		[0x070] = &&op_0x70, &&op_0x71, &&op_0x72, &&op_0x73,
+		[0x074] = &&op_0x74, &&op_0x75, &&op_0x76, &&op_0x77,
+		[0x078] = &&op_0x78, &&op_0x79, &&op_0x7a, &&op_0x7b,
+		[0x07c] = &&op_0x7c, &&op_0x7d, &&op_0x7e, &&op_0x7f,
+		[0x080] = &&op_0x80, &&op_0x81, &&op_0x82, &&op_0x83,
+		[0x084] = &&op_0x84, &&op_0x85, &&op_0x86, &&op_0x87,
+		[0x088] = &&op_0x88, &&op_0x89, &&op_0x8a, &&op_0x8b,
+		[0x08c] = &&op_0x8c, &&op_0x8d, &&op_0x8e, &&op_0x8f,
+		[0x090] = &&op_0x90, &&op_0x91, &&op_0x92, &&op_0x93,
+		[0x094] = &&op_0x94, &&op_0x95, &&op_0x96, &&op_0x97,
+		[0x098] = &&op_0x98, &&op_0x99, &&op_0x9a, &&op_0x9b,
+		[0x09c] = &&op_0x9c, &&op_0x9d, &&op_0x9e, &&op_0x9f,
+		[0x0a0] = &&op_0xa0, &&op_0xa1, &&op_0xa2, &&op_0xa3,
+		[0x0a4] = &&op_0xa4, &&op_0xa5, &&op_0xa6, &&op_0xa7,
+		[0x0a8] = &&op_0xa8, &&op_0xa9, &&op_0xaa, &&op_0xab,
+		[0x0ac] = &&op_0xac, &&op_0xad, &&op_0xae, &&op_0xaf,
+		[0x0b0] = &&op_0xb0, &&op_0xb1, &&op_0xb2, &&op_0xb3,
+		[0x0b4] = &&op_0xb4, &&op_0xb5, &&op_0xb6, &&op_0xb7,
+		[0x0b8] = &&op_0xb8, &&op_0xb9, &&op_0xba, &&op_0xbb,
+		[0x0bc] = &&op_0xbc, &&op_0xbd, &&op_0xbe, &&op_0xbf,
+		[0x0c0] = &&op_0xc0, &&op_0xc1, &&op_0xc2, &&op_0xc3,
+		[0x0c4] = &&op_0xc4, &&op_0xc5, &&op_0xc6, &&op_0xc7,
+		[0x0c8] = &&op_0xc8, &&op_0xc9, &&op_0xca, &&op_0xcb,
+		[0x0cc] = &&op_0xcc, &&op_0xcd, &&op_0xce, &&op_0xcf,
+		[0x0d0] = &&op_0xd0, &&op_0xd1, &&op_0xd2, &&op_0xd3,
+		[0x0d4] = &&op_0xd4, &&op_0xd5, &&op_0xd6, &&op_0xd7,
+		[0x0d8] = &&op_0xd8, &&op_0xd9, &&op_0xda, &&op_0xdb,
+		[0x0dc] = &&op_0xdc, &&op_0xdd, &&op_0xde, &&op_0xdf,
+		[0x0e0] = &&op_0xe0, &&op_0xe1, &&op_0xe2, &&op_0xe3,
+		[0x0e4] = &&op_0xe4, &&op_0xe5, &&op_0xe6, &&op_0xe7,
+		[0x0e8] = &&op_0xe8, &&op_0xe9, &&op_0xea, &&op_0xeb,
+		[0x0ec] = &&op_0xec, &&op_0xed, &&op_0xee, &&op_0xef,
+		[0x0f0] = &&op_0xf0, &&op_0xf1, &&op_0xf2, &&op_0xf3,
+		[0x0f4] = &&op_0xf4, &&op_0xf5, &&op_0xf6, &&op_0xf7,
+		[0x0f8] = &&op_0xf8, &&op_0xf9, &&op_0xfa, &&op_0xfb,
+		[0x0fc] = &&op_0xfc, &&op_0xfd, &&op_0xfe, &&op_0xff,
+		[0x100 ... 0x1ff] = &&op_default,
+		[0x200] = &&op_0x0200, &&op_0x0201, &&op_0x0202, &&op_0x0203,
+		[0x204] = &&op_0x0204, &&op_0x0205, &&op_0x0206, &&op_0x0207,
+		[0x208] = &&op_0x0208, &&op_0x0209, &&op_0x020a, &&op_0x020b,
+		[0x20c] = &&op_0x020c, &&op_0x020d, &&op_0x020e, &&op_0x020f,
+		[0x210] = &&op_0x0210, &&op_0x0211, &&op_0x0212, &&op_0x0213,
+		[0x214] = &&op_0x0214, &&op_0x0215, &&op_0x0216, &&op_0x0217,
+		[0x218] = &&op_0x0218, &&op_0x0219, &&op_0x021a, &&op_0x021b,
+		[0x21c] = &&op_0x021c, &&op_0x021d, &&op_0x021e, &&op_0x021f,
+		[0x220] = &&op_0x0220, &&op_0x0221, &&op_0x0222, &&op_0x0223,
+		[0x224] = &&op_0x0224, &&op_0x0225, &&op_0x0226, &&op_0x0227,
+		[0x228] = &&op_0x0228, &&op_0x0229, &&op_0x022a, &&op_0x022b,
+		[0x22c] = &&op_0x022c, &&op_0x022d, &&op_0x022e, &&op_0x022f,
+		[0x230] = &&op_0x0230, &&op_0x0231, &&op_0x0232, &&op_0x0233,
+		[0x234] = &&op_0x0234, &&op_0x0235, &&op_0x0236, &&op_0x0237,
+		[0x238] = &&op_0x0238, &&op_0x0239, &&op_0x023a, &&op_0x023b,
+		[0x23c] = &&op_0x023c, &&op_0x023d, &&op_0x023e, &&op_0x023f,
+		[0x240] = &&op_0x0240, &&op_0x0241, &&op_0x0242, &&op_0x0243,
+		[0x244] = &&op_0x0244, &&op_0x0245, &&op_0x0246, &&op_0x0247,
+		[0x248] = &&op_0x0248, &&op_0x0249, &&op_0x024a, &&op_0x024b,
+		[0x24c] = &&op_0x024c, &&op_0x024d, &&op_0x024e, &&op_0x024f,
+		[0x250] = &&op_0x0250, &&op_0x0251, &&op_0x0252, &&op_0x0253,
+		[0x254] = &&op_0x0254, &&op_0x0255, &&op_0x0256, &&op_0x0257,
+		[0x258] = &&op_0x0258, &&op_0x0259, &&op_0x025a, &&op_0x025b,
+		[0x25c] = &&op_0x025c, &&op_0x025d, &&op_0x025e, &&op_0x025f,
+		[0x260] = &&op_0x0260, &&op_0x0261, &&op_0x0262, &&op_0x0263,
+		[0x264] = &&op_0x0264, &&op_0x0265, &&op_0x0266, &&op_0x0267,
+		[0x268] = &&op_0x0268, &&op_0x0269, &&op_0x026a, &&op_0x026b,
+		[0x26c] = &&op_0x026c, &&op_0x026d, &&op_0x026e, &&op_0x026f,
+		[0x270] = &&op_0x0270, &&op_0x0271, &&op_0x0272, &&op_0x0273,
+		[0x274] = &&op_0x0274, &&op_0x0275, &&op_0x0276, &&op_0x0277,
+		[0x278] = &&op_0x0278, &&op_0x0279, &&op_0x027a, &&op_0x027b,
+		[0x27c] = &&op_0x027c, &&op_0x027d, &&op_0x027e, &&op_0x027f,
+		[0x280] = &&op_0x0280, &&op_0x0281, &&op_0x0282, &&op_0x0283,
+		[0x284] = &&op_0x0284, &&op_0x0285, &&op_0x0286, &&op_0x0287,
+		[0x288] = &&op_0x0288, &&op_0x0289, &&op_0x028a, &&op_0x028b,
+		[0x28c] = &&op_0x028c, &&op_0x028d, &&op_0x028e, &&op_0x028f,
+		[0x290] = &&op_0x0290, &&op_0x0291, &&op_0x0292, &&op_0x0293,
+		[0x294] = &&op_0x0294, &&op_0x0295, &&op_0x0296, &&op_0x0297,
+		[0x298] = &&op_0x0298, &&op_0x0299, &&op_0x029a, &&op_0x029b,
+		[0x29c] = &&op_0x029c, &&op_0x029d, &&op_0x029e, &&op_0x029f,
+		[0x2a0] = &&op_0x02a0, &&op_0x02a1, &&op_0x02a2, &&op_0x02a3,
+		[0x2a4] = &&op_0x02a4, &&op_0x02a5, &&op_0x02a6, &&op_0x02a7,
+		[0x2a8] = &&op_0x02a8, &&op_0x02a9, &&op_0x02aa, &&op_0x02ab,
+		[0x2ac] = &&op_0x02ac, &&op_0x02ad, &&op_0x02ae, &&op_0x02af,
+		[0x2b0] = &&op_0x02b0, &&op_0x02b1, &&op_0x02b2, &&op_0x02b3,
+		[0x2b4] = &&op_0x02b4, &&op_0x02b5, &&op_0x02b6, &&op_0x02b7,
+		[0x2b8] = &&op_0x02b8, &&op_0x02b9, &&op_0x02ba, &&op_0x02bb,
+		[0x2bc] = &&op_0x02bc, &&op_0x02bd, &&op_0x02be, &&op_0x02bf,
+		[0x2c0] = &&op_0x02c0, &&op_0x02c1, &&op_0x02c2, &&op_0x02c3,
+		[0x2c4] = &&op_0x02c4, &&op_0x02c5, &&op_0x02c6, &&op_0x02c7,
+		[0x2c8] = &&op_0x02c8, &&op_0x02c9, &&op_0x02ca, &&op_0x02cb,
+		[0x2cc] = &&op_default, &&op_0x02cd, &&op_0x02ce, &&op_0x02cf,
+		[0x2d0] = &&op_0x02d0, &&op_0x02d1, &&op_0x02d2, &&op_0x02d3,
+		[0x2d4] = &&op_0x02d4, &&op_0x02d5, &&op_0x02d6, &&op_0x02d7,
+		[0x2d8] = &&op_0x02d8, &&op_0x02d9, &&op_0x02da, &&op_0x02db,
+		[0x2dc] = &&op_default, &&op_default, &&op_0x02de, &&op_0x02df,
+		[0x2e0] = &&op_0x02e0, &&op_0x02e1, &&op_0x02e2, &&op_0x02e3,
+		[0x2e4] = &&op_0x02e4, &&op_0x02e5, &&op_0x02e6, &&op_0x02e7,
+		[0x2e8] = &&op_0x02e8, &&op_0x02e9, &&op_0x02ea, &&op_0x02eb,
+		[0x2ec] = &&op_default, &&op_default, &&op_0x02ee, &&op_0x02ef,
+		[0x2f0] = &&op_0x02f0, &&op_0x02f1, &&op_0x02f2, &&op_0x02f3,
+		[0x2f4] = &&op_0x02f4, &&op_0x02f5, &&op_0x02f6, &&op_0x02f7,
+		[0x2f8] = &&op_0x02f8, &&op_0x02f9, &&op_0x02fa, &&op_0x02fb,
+		[0x2fc] = &&op_default, &&op_default, &&op_0x02fe, &&op_0x02ff,
+		[0x300] = &&op_0x0300, &&op_0x0301, &&op_0x0302, &&op_0x0303,
+		[0x304] = &&op_0x0304, &&op_0x0305, &&op_0x0306, &&op_0x0307,
+		[0x308] = &&op_0x0308, &&op_0x0309, &&op_0x030a, &&op_0x030b,
+		[0x30c] = &&op_0x030c, &&op_0x030d, &&op_0x030e, &&op_0x030f,
+		[0x310] = &&op_0x0310, &&op_0x0311, &&op_0x0312, &&op_0x0313,
+		[0x314] = &&op_0x0314, &&op_0x0315, &&op_0x0316, &&op_0x0317,
+		[0x318] = &&op_0x0318, &&op_0x0319, &&op_0x031a, &&op_0x031b,
+		[0x31c] = &&op_0x031c, &&op_0x031d, &&op_0x031e, &&op_0x031f,
+		[0x320 ... 0x333] = &&op_default,
+		[0x334] = &&op_0x0334, &&op_0x0335, &&op_0x0336, &&op_0x0337,
+		[0x338] = &&op_0x0338, &&op_0x0339, &&op_0x033a, &&op_0x033b,
+		[0x33c] = &&op_0x033c, &&op_0x033d, &&op_0x033e, &&op_0x033f,
+		[0x340] = &&op_0x0340, &&op_0x0341, &&op_0x0342, &&op_0x0343,
+		[0x344] = &&op_0x0344, &&op_0x0345, &&op_0x0346, &&op_0x0347,
+		[0x348] = &&op_0x0348, &&op_0x0349, &&op_0x034a, &&op_0x034b,
+		[0x34c] = &&op_0x034c, &&op_0x034d, &&op_0x034e, &&op_0x034f,
+		[0x350] = &&op_0x0350, &&op_0x0351, &&op_0x0352, &&op_0x0353,
+		[0x354] = &&op_0x0354, &&op_0x0355, &&op_0x0356, &&op_0x0357,
+		[0x358] = &&op_0x0358, &&op_0x0359, &&op_0x035a, &&op_0x035b,
+		[0x35c] = &&op_0x035c, &&op_0x035d, &&op_0x035e, &&op_0x035f,
+		[0x360] = &&op_0x0360, &&op_0x0361, &&op_0x0362, &&op_0x0363,
+		[0x364] = &&op_0x0364, &&op_0x0365, &&op_0x0366, &&op_0x0367,
+		[0x368] = &&op_0x0368, &&op_0x0369, &&op_0x036a, &&op_0x036b,
+		[0x36c] = &&op_0x036c, &&op_0x036d, &&op_0x036e, &&op_0x036f,
+		[0x370] = &&op_0x0370, &&op_0x0371, &&op_0x0372, &&op_0x0373,
+		[0x374] = &&op_0x0374, &&op_0x0375, &&op_0x0376, &&op_0x0377,
+		[0x378] = &&op_0x0378, &&op_0x0379, &&op_0x037a, &&op_0x037b,
+		[0x37c] = &&op_0x037c, &&op_0x037d, &&op_0x037e, &&op_0x037f,
+		[0x380] = &&op_0x0380, &&op_0x0381, &&op_0x0382, &&op_0x0383,
+		[0x384] = &&op_0x0384, &&op_0x0385, &&op_0x0386, &&op_0x0387,
+		[0x388] = &&op_0x0388, &&op_0x0389, &&op_0x038a, &&op_0x038b,
+		[0x38c] = &&op_0x038c, &&op_0x038d, &&op_default, &&op_0x038f,
+		[0x390] = &&op_0x0390, &&op_0x0391, &&op_0x0392, &&op_0x0393,
+		[0x394] = &&op_0x0394, &&op_0x0395, &&op_0x0396, &&op_0x0397,
+		[0x398] = &&op_0x0398, &&op_0x0399, &&op_0x039a, &&op_0x039b,
+		[0x39c] = &&op_0x039c, &&op_0x039d, &&op_default, &&op_default,
+		[0x3a0] = &&op_0x03a0, &&op_0x03a1, &&op_0x03a2, &&op_0x03a3,
+		[0x3a4] = &&op_0x03a4, &&op_0x03a5, &&op_0x03a6, &&op_0x03a7,
+		[0x3a8] = &&op_0x03a8, &&op_0x03a9, &&op_0x03aa, &&op_0x03ab,
+		[0x3ac] = &&op_0x03ac, &&op_0x03ad, &&op_default, &&op_default,
+		[0x3b0] = &&op_0x03b0, &&op_0x03b1, &&op_0x03b2, &&op_0x03b3,
+		[0x3b4] = &&op_0x03b4, &&op_0x03b5, &&op_0x03b6, &&op_0x03b7,
+		[0x3b8] = &&op_0x03b8, &&op_0x03b9, &&op_0x03ba, &&op_0x03bb,
+		[0x3bc] = &&op_0x03bc, &&op_0x03bd, &&op_default, &&op_default,
+		[0x3c0] = &&op_0x03c0, &&op_0x03c1, &&op_0x03c2, &&op_0x03c3,
+		[0x3c4] = &&op_0x03c4, &&op_0x03c5, &&op_0x03c6, &&op_0x03c7,
+		[0x3c8] = &&op_0x03c8, &&op_0x03c9, &&op_0x03ca, &&op_0x03cb,
+		[0x3cc] = &&op_default, &&op_0x03cd, &&op_default, &&op_0x03cf,
+		[0x3d0] = &&op_0x03d0, &&op_0x03d1, &&op_0x03d2, &&op_0x03d3,
+		[0x3d4] = &&op_0x03d4, &&op_0x03d5, &&op_0x03d6, &&op_0x03d7,
+		[0x3d8] = &&op_0x03d8, &&op_0x03d9, &&op_0x03da, &&op_0x03db,
+		[0x3dc] = &&op_default, &&op_default, &&op_default, &&op_default,
+		[0x3e0] = &&op_0x03e0, &&op_0x03e1, &&op_0x03e2, &&op_0x03e3,
+		[0x3e4] = &&op_0x03e4, &&op_0x03e5, &&op_0x03e6, &&op_0x03e7,
+		[0x3e8] = &&op_0x03e8, &&op_0x03e9, &&op_0x03ea, &&op_0x03eb,
+		[0x3ec] = &&op_default, &&op_default, &&op_default, &&op_default,
+		[0x3f0] = &&op_0x03f0, &&op_0x03f1, &&op_0x03f2, &&op_0x03f3,
+		[0x3f4] = &&op_0x03f4, &&op_0x03f5, &&op_0x03f6, &&op_0x03f7,
+		[0x3f8] = &&op_0x03f8, &&op_0x03f9, &&op_0x03fa, &&op_0x03fb,
+		[0x3fc] = &&op_default, &&op_default, &&op_default, &&op_default,
+	};
+#endif
+
 
 	do {
 
@@ -279,7 +484,7 @@ static void mc6809_run(struct MC6809 *cpu) {
 			if (!cpu->halt) {
 				take_interrupt(cpu, 0, MC6809_INT_VEC_RESET);
 			} else {
-				NVMA_CYCLE;
+				IDLE_CYCLE;
 			}
 			continue;
 
@@ -287,7 +492,7 @@ static void mc6809_run(struct MC6809 *cpu) {
 		case mc6809_state_done_instruction:
 		case mc6809_state_label_a:
 			if (cpu->halt) {
-				NVMA_CYCLE;
+				IDLE_CYCLE;
 				continue;
 			}
 			cpu->state = mc6809_state_label_b;
@@ -319,6 +524,10 @@ static void mc6809_run(struct MC6809 *cpu) {
 				cpu->trace_pc = cpu->trace_next_pc = REG_PC;
 				cpu->trace_nbytes = 0;
 #endif
+				// Straight on to the fetch unless that hook (or the
+				// clock) stopped the CPU.
+				if (cpu->running)
+					goto next_instruction;
 			}
 			continue;
 
@@ -339,7 +548,7 @@ static void mc6809_run(struct MC6809 *cpu) {
 			cpu->nmi_active = cpu->nmi_latch;
 			cpu->firq_active = cpu->firq_latch;
 			cpu->irq_active = cpu->irq_latch;
-			NVMA_CYCLE;
+			IDLE_CYCLE;
 			if (!cpu->halt) {
 				cpu->state = mc6809_state_dispatch_irq;
 			}
@@ -349,7 +558,7 @@ static void mc6809_run(struct MC6809 *cpu) {
 			cpu->nmi_active = cpu->nmi_latch;
 			cpu->firq_active = cpu->firq_latch;
 			cpu->irq_active = cpu->irq_latch;
-			NVMA_CYCLE;
+			IDLE_CYCLE;
 			if (cpu->nmi_active || cpu->firq_active || cpu->irq_active) {
 				NVMA_CYCLE;
 				instruction_posthook(cpu);
@@ -362,18 +571,20 @@ static void mc6809_run(struct MC6809 *cpu) {
 			continue;
 
 		case mc6809_state_sync_check_halt:
-			NVMA_CYCLE;
+			IDLE_CYCLE;
 			if (!cpu->halt) {
 				cpu->state = mc6809_state_sync;
 			}
 			continue;
 
-		case mc6809_state_next_instruction: {
+		case mc6809_state_next_instruction:
+		next_instruction: {
 			unsigned op;
 			// Fetch op-code and process
 			op = byte_immediate(cpu);
 			op |= cpu->page;
 			cpu->state = mc6809_state_label_a;
+			DISPATCH_OP(op_table, op);
 			switch (op) {
 
 			// 0x00 - 0x0f direct mode ops
@@ -382,68 +593,68 @@ static void mc6809_run(struct MC6809 *cpu) {
 			// 0x60 - 0x6f indexed mode ops
 			// 0x70 - 0x7f extended mode ops
 			// 0x10xx, 0x11xx - page 2/3 fallthrough, illegal
-			case 0x00: case 0x01: case 0x02: case 0x03:
-			case 0x04: case 0x05: case 0x06: case 0x07:
-			case 0x08: case 0x09: case 0x0a: case 0x0b:
-			case 0x0c: case 0x0d: case 0x0f:
-			case 0x40: case 0x41: case 0x42: case 0x43:
-			case 0x44: case 0x45: case 0x46: case 0x47:
-			case 0x48: case 0x49: case 0x4a: case 0x4b:
-			case 0x4c: case 0x4d: case 0x4e: case 0x4f:
-			case 0x50: case 0x51: case 0x52: case 0x53:
-			case 0x54: case 0x55: case 0x56: case 0x57:
-			case 0x58: case 0x59: case 0x5a: case 0x5b:
-			case 0x5c: case 0x5d: case 0x5e: case 0x5f:
-			case 0x60: case 0x61: case 0x62: case 0x63:
-			case 0x64: case 0x65: case 0x66: case 0x67:
-			case 0x68: case 0x69: case 0x6a: case 0x6b:
-			case 0x6c: case 0x6d: case 0x6f:
-			case 0x70: case 0x71: case 0x72: case 0x73:
-			case 0x74: case 0x75: case 0x76: case 0x77:
-			case 0x78: case 0x79: case 0x7a: case 0x7b:
-			case 0x7c: case 0x7d: case 0x7f:
-
-			case 0x0200: case 0x0201: case 0x0202: case 0x0203:
-			case 0x0204: case 0x0205: case 0x0206: case 0x0207:
-			case 0x0208: case 0x0209: case 0x020a: case 0x020b:
-			case 0x020c: case 0x020d: case 0x020f:
-			case 0x0240: case 0x0241: case 0x0242: case 0x0243:
-			case 0x0244: case 0x0245: case 0x0246: case 0x0247:
-			case 0x0248: case 0x0249: case 0x024a: case 0x024b:
-			case 0x024c: case 0x024d: case 0x024e: case 0x024f:
-			case 0x0250: case 0x0251: case 0x0252: case 0x0253:
-			case 0x0254: case 0x0255: case 0x0256: case 0x0257:
-			case 0x0258: case 0x0259: case 0x025a: case 0x025b:
-			case 0x025c: case 0x025d: case 0x025e: case 0x025f:
-			case 0x0260: case 0x0261: case 0x0262: case 0x0263:
-			case 0x0264: case 0x0265: case 0x0266: case 0x0267:
-			case 0x0268: case 0x0269: case 0x026a: case 0x026b:
-			case 0x026c: case 0x026d: case 0x026f:
-			case 0x0270: case 0x0271: case 0x0272: case 0x0273:
-			case 0x0274: case 0x0275: case 0x0276: case 0x0277:
-			case 0x0278: case 0x0279: case 0x027a: case 0x027b:
-			case 0x027c: case 0x027d: case 0x027f:
-
-			case 0x0300: case 0x0301: case 0x0302: case 0x0303:
-			case 0x0304: case 0x0305: case 0x0306: case 0x0307:
-			case 0x0308: case 0x0309: case 0x030a: case 0x030b:
-			case 0x030c: case 0x030d: case 0x030f:
-			case 0x0340: case 0x0341: case 0x0342: case 0x0343:
-			case 0x0344: case 0x0345: case 0x0346: case 0x0347:
-			case 0x0348: case 0x0349: case 0x034a: case 0x034b:
-			case 0x034c: case 0x034d: case 0x034e: case 0x034f:
-			case 0x0350: case 0x0351: case 0x0352: case 0x0353:
-			case 0x0354: case 0x0355: case 0x0356: case 0x0357:
-			case 0x0358: case 0x0359: case 0x035a: case 0x035b:
-			case 0x035c: case 0x035d: case 0x035e: case 0x035f:
-			case 0x0360: case 0x0361: case 0x0362: case 0x0363:
-			case 0x0364: case 0x0365: case 0x0366: case 0x0367:
-			case 0x0368: case 0x0369: case 0x036a: case 0x036b:
-			case 0x036c: case 0x036d: case 0x036f:
-			case 0x0370: case 0x0371: case 0x0372: case 0x0373:
-			case 0x0374: case 0x0375: case 0x0376: case 0x0377:
-			case 0x0378: case 0x0379: case 0x037a: case 0x037b:
-			case 0x037c: case 0x037d: case 0x037f: {
+			OP(0x00): OP(0x01): OP(0x02): OP(0x03):
+			OP(0x04): OP(0x05): OP(0x06): OP(0x07):
+			OP(0x08): OP(0x09): OP(0x0a): OP(0x0b):
+			OP(0x0c): OP(0x0d): OP(0x0f):
+			OP(0x40): OP(0x41): OP(0x42): OP(0x43):
+			OP(0x44): OP(0x45): OP(0x46): OP(0x47):
+			OP(0x48): OP(0x49): OP(0x4a): OP(0x4b):
+			OP(0x4c): OP(0x4d): OP(0x4e): OP(0x4f):
+			OP(0x50): OP(0x51): OP(0x52): OP(0x53):
+			OP(0x54): OP(0x55): OP(0x56): OP(0x57):
+			OP(0x58): OP(0x59): OP(0x5a): OP(0x5b):
+			OP(0x5c): OP(0x5d): OP(0x5e): OP(0x5f):
+			OP(0x60): OP(0x61): OP(0x62): OP(0x63):
+			OP(0x64): OP(0x65): OP(0x66): OP(0x67):
+			OP(0x68): OP(0x69): OP(0x6a): OP(0x6b):
+			OP(0x6c): OP(0x6d): OP(0x6f):
+			OP(0x70): OP(0x71): OP(0x72): OP(0x73):
+			OP(0x74): OP(0x75): OP(0x76): OP(0x77):
+			OP(0x78): OP(0x79): OP(0x7a): OP(0x7b):
+			OP(0x7c): OP(0x7d): OP(0x7f):
+
+			OP(0x0200): OP(0x0201): OP(0x0202): OP(0x0203):
+			OP(0x0204): OP(0x0205): OP(0x0206): OP(0x0207):
+			OP(0x0208): OP(0x0209): OP(0x020a): OP(0x020b):
+			OP(0x020c): OP(0x020d): OP(0x020f):
+			OP(0x0240): OP(0x0241): OP(0x0242): OP(0x0243):
+			OP(0x0244): OP(0x0245): OP(0x0246): OP(0x0247):
+			OP(0x0248): OP(0x0249): OP(0x024a): OP(0x024b):
+			OP(0x024c): OP(0x024d): OP(0x024e): OP(0x024f):
+			OP(0x0250): OP(0x0251): OP(0x0252): OP(0x0253):
+			OP(0x0254): OP(0x0255): OP(0x0256): OP(0x0257):
+			OP(0x0258): OP(0x0259): OP(0x025a): OP(0x025b):
+			OP(0x025c): OP(0x025d): OP(0x025e): OP(0x025f):
+			OP(0x0260): OP(0x0261): OP(0x0262): OP(0x0263):
+			OP(0x0264): OP(0x0265): OP(0x0266): OP(0x0267):
+			OP(0x0268): OP(0x0269): OP(0x026a): OP(0x026b):
+			OP(0x026c): OP(0x026d): OP(0x026f):
+			OP(0x0270): OP(0x0271): OP(0x0272): OP(0x0273):
+			OP(0x0274): OP(0x0275): OP(0x0276): OP(0x0277):
+			OP(0x0278): OP(0x0279): OP(0x027a): OP(0x027b):
+			OP(0x027c): OP(0x027d): OP(0x027f):
+
+			OP(0x0300): OP(0x0301): OP(0x0302): OP(0x0303):
+			OP(0x0304): OP(0x0305): OP(0x0306): OP(0x0307):
+			OP(0x0308): OP(0x0309): OP(0x030a): OP(0x030b):
+			OP(0x030c): OP(0x030d): OP(0x030f):
+			OP(0x0340): OP(0x0341): OP(0x0342): OP(0x0343):
+			OP(0x0344): OP(0x0345): OP(0x0346): OP(0x0347):
+			OP(0x0348): OP(0x0349): OP(0x034a): OP(0x034b):
+			OP(0x034c): OP(0x034d): OP(0x034e): OP(0x034f):
+			OP(0x0350): OP(0x0351): OP(0x0352): OP(0x0353):
+			OP(0x0354): OP(0x0355): OP(0x0356): OP(0x0357):
+			OP(0x0358): OP(0x0359): OP(0x035a): OP(0x035b):
+			OP(0x035c): OP(0x035d): OP(0x035e): OP(0x035f):
+			OP(0x0360): OP(0x0361): OP(0x0362): OP(0x0363):
+			OP(0x0364): OP(0x0365): OP(0x0366): OP(0x0367):
+			OP(0x0368): OP(0x0369): OP(0x036a): OP(0x036b):
+			OP(0x036c): OP(0x036d): OP(0x036f):
+			OP(0x0370): OP(0x0371): OP(0x0372): OP(0x0373):
+			OP(0x0374): OP(0x0375): OP(0x0376): OP(0x0377):
+			OP(0x0378): OP(0x0379): OP(0x037a): OP(0x037b):
+			OP(0x037c): OP(0x037d): OP(0x037f): {
 
 				uint16_t ea;
 				unsigned tmp1;
@@ -504,9 +715,9 @@ static void mc6809_run(struct MC6809 *cpu) {
 			// 0x6e JMP indexed
 			// 0x7e JMP extended
 			// 0x10xx, 0x11xx - page 2/3 fallthrough, illegal
-			case 0x0e: case 0x6e: case 0x7e:
-			case 0x020e: case 0x026e: case 0x027e:
-			case 0x030e: case 0x036e: case 0x037e: {
+			OP(0x0e): OP(0x6e): OP(0x7e):
+			OP(0x020e): OP(0x026e): OP(0x027e):
+			OP(0x030e): OP(0x036e): OP(0x037e): {
 				unsigned ea;
 				switch ((op >> 4) & 0xf) {
 				case 0x0: ea = ea_direct(cpu); break;
@@ -519,9 +730,9 @@ static void mc6809_run(struct MC6809 *cpu) {
 
 			// 0x10 Page 2
 			// 0x1010, 0x1011 Page 2
-			case 0x10:
-			case 0x0210:
-			case 0x0211:
+			OP(0x10):
+			OP(0x0210):
+			OP(0x0211):
 				cpu->state = mc6809_state_next_instruction;
 				cpu->page = 0x200;
 #ifdef TRACE
@@ -533,9 +744,9 @@ static void mc6809_run(struct MC6809 *cpu) {
 
 			// 0x11 Page 3
 			// 0x1110, 0x1111 Page 3
-			case 0x0310:
-			case 0x0311:
-			case 0x11:
+			OP(0x0310):
+			OP(0x0311):
+			OP(0x11):
 				cpu->state = mc6809_state_next_instruction;
 				cpu->page = 0x300;
 #ifdef TRACE
@@ -548,29 +759,29 @@ static void mc6809_run(struct MC6809 *cpu) {
 			// 0x12 NOP inherent
 			// 0x1b NOP inherent (illegal)
 			// 0x10xx, 0x11xx - page 2/3 fallthrough, illegal
-			case 0x12:
-			case 0x1b:
-			case 0x0212:
-			case 0x021b:
-			case 0x0312:
-			case 0x031b:
+			OP(0x12):
+			OP(0x1b):
+			OP(0x0212):
+			OP(0x021b):
+			OP(0x0312):
+			OP(0x031b):
 				peek_byte(cpu, REG_PC);
 				break;
 
 			// 0x13 SYNC inherent
 			// 0x10xx, 0x11xx - page 2/3 fallthrough, illegal
-			case 0x13:
-			case 0x0213:
-			case 0x0313:
+			OP(0x13):
+			OP(0x0213):
+			OP(0x0313):
 				peek_byte(cpu, REG_PC);
 				cpu->state = mc6809_state_sync;
 				continue;
 
 			// 0x14, 0x15 HCF? (illegal)
 			// 0x10xx, 0x11xx - page 2/3 fallthrough, illegal
-			case 0x14: case 0x15: case 0xcd:
-			case 0x0214: case 0x0215: case 0x02cd:
-			case 0x0314: case 0x0315: case 0x03cd:
+			OP(0x14): OP(0x15): OP(0xcd):
+			OP(0x0214): OP(0x0215): OP(0x02cd):
+			OP(0x0314): OP(0x0315): OP(0x03cd):
 				cpu->state = mc6809_state_hcf;
 				break;
 
@@ -579,9 +790,9 @@ static void mc6809_run(struct MC6809 *cpu) {
 			// 0x108d, 0x118d - LBRA observed by darrena on discord
 			// TODO: investigate [dfffffff] claim of destination
 			// opcode affecting behaviour
-			case 0x16:
-			case 0x0216: case 0x028d:
-			case 0x0316: case 0x038d: {
+			OP(0x16):
+			OP(0x0216): OP(0x028d):
+			OP(0x0316): OP(0x038d): {
 				uint16_t ea = long_relative(cpu);
 				REG_PC += ea;
 				NVMA_CYCLE;
@@ -590,9 +801,9 @@ static void mc6809_run(struct MC6809 *cpu) {
 
 			// 0x17 LBSR relative
 			// 0x10xx, 0x11xx - page 2/3 fallthrough, illegal
-			case 0x17:
-			case 0x0217:
-			case 0x0317: {
+			OP(0x17):
+			OP(0x0217):
+			OP(0x0317): {
 				uint16_t ea = long_relative(cpu);
 				ea += REG_PC;
 				NVMA_CYCLE;
@@ -608,9 +819,9 @@ static void mc6809_run(struct MC6809 *cpu) {
 			// Behaviour as defined in [hoglet67]
 			// TODO: do we inc PC for operand?
 			// TODO: is this actually mirrored in the other pages?
-			case 0x18:
-			case 0x0218:
-			case 0x0318: {
+			OP(0x18):
+			OP(0x0218):
+			OP(0x0318): {
 				unsigned data = fetch_byte_notrace(cpu, REG_PC);
 				REG_CC = (REG_CC & data) << 1;
 				REG_CC |= (REG_CC >> 2) & 0x02;
@@ -619,18 +830,18 @@ static void mc6809_run(struct MC6809 *cpu) {
 
 			// 0x19 DAA inherent
 			// 0x10xx, 0x11xx - page 2/3 fallthrough, illegal
-			case 0x19:
-			case 0x0219:
-			case 0x0319:
+			OP(0x19):
+			OP(0x0219):
+			OP(0x0319):
 				REG_A = op_daa(cpu, REG_A);
 				peek_byte(cpu, REG_PC);
 				break;
 
 			// 0x1a ORCC immediate
 			// 0x10xx, 0x11xx - page 2/3 fallthrough, illegal
-			case 0x1a:
-			case 0x021a:
-			case 0x031a: {
+			OP(0x1a):
+			OP(0x021a):
+			OP(0x031a): {
 				unsigned data = byte_immediate(cpu);
 				REG_CC |= data;
 				peek_byte(cpu, REG_PC);
@@ -638,9 +849,9 @@ static void mc6809_run(struct MC6809 *cpu) {
 
 			// 0x1c ANDCC immediate
 			// 0x10xx, 0x11xx - page 2/3 fallthrough, illegal
-			case 0x1c:
-			case 0x021c:
-			case 0x031c: {
+			OP(0x1c):
+			OP(0x021c):
+			OP(0x031c): {
 				unsigned data = byte_immediate(cpu);
 				REG_CC &= data;
 				peek_byte(cpu, REG_PC);
@@ -648,9 +859,9 @@ static void mc6809_run(struct MC6809 *cpu) {
 
 			// 0x1d SEX inherent
 			// 0x10xx, 0x11xx - page 2/3 fallthrough, illegal
-			case 0x1d:
-			case 0x021d:
-			case 0x031d:
+			OP(0x1d):
+			OP(0x021d):
+			OP(0x031d):
 				REG_D = sex8(REG_B);
 				CLR_NZ;
 				SET_NZ16(REG_D);
@@ -659,9 +870,9 @@ static void mc6809_run(struct MC6809 *cpu) {
 
 			// 0x1e EXG immediate
 			// 0x10xx, 0x11xx - page 2/3 fallthrough, illegal
-			case 0x1e:
-			case 0x021e:
-			case 0x031e: {
+			OP(0x1e):
+			OP(0x021e):
+			OP(0x031e): {
 				uint16_t tmp1, tmp2;
 				unsigned postbyte = byte_immediate(cpu);
 				switch (postbyte >> 4) {
@@ -713,9 +924,9 @@ static void mc6809_run(struct MC6809 *cpu) {
 
 			// 0x1f TFR immediate
 			// 0x10xx, 0x11xx - page 2/3 fallthrough, illegal
-			case 0x1f:
-			case 0x021f:
-			case 0x031f: {
+			OP(0x1f):
+			OP(0x021f):
+			OP(0x031f): {
 				uint16_t tmp1;
 				unsigned postbyte = byte_immediate(cpu);
 				switch (postbyte >> 4) {
@@ -751,10 +962,10 @@ static void mc6809_run(struct MC6809 *cpu) {
 			} break;
 
 			// 0x20 - 0x2f short branches
-			case 0x20: case 0x21: case 0x22: case 0x23:
-			case 0x24: case 0x25: case 0x26: case 0x27:
-			case 0x28: case 0x29: case 0x2a: case 0x2b:
-			case 0x2c: case 0x2d: case 0x2e: case 0x2f: {
+			OP(0x20): OP(0x21): OP(0x22): OP(0x23):
+			OP(0x24): OP(0x25): OP(0x26): OP(0x27):
+			OP(0x28): OP(0x29): OP(0x2a): OP(0x2b):
+			OP(0x2c): OP(0x2d): OP(0x2e): OP(0x2f): {
 				unsigned tmp = sex8(byte_immediate(cpu));
 				NVMA_CYCLE;
 				if (branch_condition(cpu, op))
@@ -763,8 +974,8 @@ static void mc6809_run(struct MC6809 *cpu) {
 
 			// 0x30 LEAX indexed
 			// 0x1030 LEAX indexed, illegal
-			case 0x30:
-			case 0x0230:
+			OP(0x30):
+			OP(0x0230):
 				REG_X = ea_indexed(cpu);
 				CLR_Z;
 				SET_Z16(REG_X);
@@ -773,8 +984,8 @@ static void mc6809_run(struct MC6809 *cpu) {
 
 			// 0x31 LEAY indexed
 			// 0x1031 LEAY indexed, illegal
-			case 0x31:
-			case 0x0231:
+			OP(0x31):
+			OP(0x0231):
 				REG_Y = ea_indexed(cpu);
 				CLR_Z;
 				SET_Z16(REG_Y);
@@ -783,8 +994,8 @@ static void mc6809_run(struct MC6809 *cpu) {
 
 			// 0x32 LEAS indexed
 			// 0x1032 LEAS indexed, illegal
-			case 0x32:
-			case 0x0232:
+			OP(0x32):
+			OP(0x0232):
 				REG_S = ea_indexed(cpu);
 				NVMA_CYCLE;
 				cpu->nmi_armed = 1;
@@ -792,17 +1003,17 @@ static void mc6809_run(struct MC6809 *cpu) {
 
 			// 0x33 LEAU indexed
 			// 0x1033 LEAU indexed, illegal
-			case 0x33:
-			case 0x0233:
+			OP(0x33):
+			OP(0x0233):
 				REG_U = ea_indexed(cpu);
 				NVMA_CYCLE;
 				break;
 
 			// 0x34 PSHS immediate
 			// 0x10xx, 0x11xx - page 2/3 fallthrough, illegal
-			case 0x34:
-			case 0x0234:
-			case 0x0334:
+			OP(0x34):
+			OP(0x0234):
+			OP(0x0334):
 				{
 					unsigned postbyte = byte_immediate(cpu);
 					NVMA_CYCLE;
@@ -822,9 +1033,9 @@ static void mc6809_run(struct MC6809 *cpu) {
 
 			// 0x35 PULS immediate
 			// 0x10xx, 0x11xx - page 2/3 fallthrough, illegal
-			case 0x35:
-			case 0x0235:
-			case 0x0335:
+			OP(0x35):
+			OP(0x0235):
+			OP(0x0335):
 				{
 					unsigned postbyte = byte_immediate(cpu);
 					NVMA_CYCLE;
@@ -844,9 +1055,9 @@ static void mc6809_run(struct MC6809 *cpu) {
 
 			// 0x36 PSHU immediate
 			// 0x10xx, 0x11xx - page 2/3 fallthrough, illegal
-			case 0x36:
-			case 0x0236:
-			case 0x0336:
+			OP(0x36):
+			OP(0x0236):
+			OP(0x0336):
 				{
 					unsigned postbyte = byte_immediate(cpu);
 					NVMA_CYCLE;
@@ -865,9 +1076,9 @@ static void mc6809_run(struct MC6809 *cpu) {
 
 			// 0x37 PULU immediate
 			// 0x10xx, 0x11xx - page 2/3 fallthrough, illegal
-			case 0x37:
-			case 0x0237:
-			case 0x0337:
+			OP(0x37):
+			OP(0x0237):
+			OP(0x0337):
 				{
 					unsigned postbyte = byte_immediate(cpu);
 					NVMA_CYCLE;
@@ -886,9 +1097,9 @@ static void mc6809_run(struct MC6809 *cpu) {
 
 			// 0x38 ANDCC immediate, illegal
 			// 0x10xx, 0x11xx - page 2/3 fallthrough, illegal
-			case 0x38:
-			case 0x0238:
-			case 0x0338: {
+			OP(0x38):
+			OP(0x0238):
+			OP(0x0338): {
 				unsigned data = byte_immediate(cpu);
 				REG_CC &= data;
 				peek_byte(cpu, REG_PC);
@@ -899,9 +1110,9 @@ static void mc6809_run(struct MC6809 *cpu) {
 
 			// 0x39 RTS inherent
 			// 0x10xx, 0x11xx - page 2/3 fallthrough, illegal
-			case 0x39:
-			case 0x0239:
-			case 0x0339:
+			OP(0x39):
+			OP(0x0239):
+			OP(0x0339):
 				peek_byte(cpu, REG_PC);
 				REG_PC = pull_s_word(cpu);
 				NVMA_CYCLE;
@@ -909,9 +1120,9 @@ static void mc6809_run(struct MC6809 *cpu) {
 
 			// 0x3a ABX inherent
 			// 0x10xx, 0x11xx - page 2/3 fallthrough, illegal
-			case 0x3a:
-			case 0x023a:
-			case 0x033a:
+			OP(0x3a):
+			OP(0x023a):
+			OP(0x033a):
 				REG_X += REG_B;
 				peek_byte(cpu, REG_PC);
 				NVMA_CYCLE;
@@ -919,9 +1130,9 @@ static void mc6809_run(struct MC6809 *cpu) {
 
 			// 0x3b RTI inherent
 			// 0x10xx, 0x11xx - page 2/3 fallthrough, illegal
-			case 0x3b:
-			case 0x023b:
-			case 0x033b:
+			OP(0x3b):
+			OP(0x023b):
+			OP(0x033b):
 				peek_byte(cpu, REG_PC);
 				REG_CC = pull_s_byte(cpu);
 				if (REG_CC & CC_E) {
@@ -941,9 +1152,9 @@ static void mc6809_run(struct MC6809 *cpu) {
 
 			// 0x3c CWAI immediate
 			// 0x10xx, 0x11xx - page 2/3 fallthrough, illegal
-			case 0x3c:
-			case 0x023c:
-			case 0x033c: {
+			OP(0x3c):
+			OP(0x023c):
+			OP(0x033c): {
 				unsigned data = byte_immediate(cpu);
 				REG_CC &= data;
 				peek_byte(cpu, REG_PC);
@@ -955,9 +1166,9 @@ static void mc6809_run(struct MC6809 *cpu) {
 
 			// 0x3d MUL inherent
 			// 0x10xx, 0x11xx - page 2/3 fallthrough, illegal
-			case 0x3d:
-			case 0x023d:
-			case 0x033d: {
+			OP(0x3d):
+			OP(0x023d):
+			OP(0x033d): {
 				unsigned tmp = REG_A * REG_B;
 				REG_D = tmp;
 				CLR_ZC;
@@ -979,7 +1190,7 @@ static void mc6809_run(struct MC6809 *cpu) {
 			// 0x3e RESET inherent, illegal
 			// NMI not disarmed
 			// [hoglet67] F and I not set
-			case 0x3e:
+			OP(0x3e):
 				peek_byte(cpu, REG_PC);
 				push_irq_registers(cpu);
 				instruction_posthook(cpu);
@@ -987,7 +1198,7 @@ static void mc6809_run(struct MC6809 *cpu) {
 				continue;
 
 			// 0x3f SWI inherent
-			case 0x3f:
+			OP(0x3f):
 				peek_byte(cpu, REG_PC);
 				stack_irq_registers(cpu);
 				instruction_posthook(cpu);
@@ -997,80 +1208,80 @@ static void mc6809_run(struct MC6809 *cpu) {
 			// 0x80 - 0xbf A register arithmetic ops
 			// 0xc0 - 0xff B register arithmetic ops
 			// 0x10xx, 0x11xx - page 2/3 fallthrough, illegal
-			case 0x80: case 0x81: case 0x82:
-			case 0x84: case 0x85: case 0x86: case 0x87:
-			case 0x88: case 0x89: case 0x8a: case 0x8b:
-			case 0x90: case 0x91: case 0x92:
-			case 0x94: case 0x95: case 0x96:
-			case 0x98: case 0x99: case 0x9a: case 0x9b:
-			case 0xa0: case 0xa1: case 0xa2:
-			case 0xa4: case 0xa5: case 0xa6:
-			case 0xa8: case 0xa9: case 0xaa: case 0xab:
-			case 0xb0: case 0xb1: case 0xb2:
-			case 0xb4: case 0xb5: case 0xb6:
-			case 0xb8: case 0xb9: case 0xba: case 0xbb:
-			case 0xc0: case 0xc1: case 0xc2:
-			case 0xc4: case 0xc5: case 0xc6: case 0xc7:
-			case 0xc8: case 0xc9: case 0xca: case 0xcb:
-			case 0xd0: case 0xd1: case 0xd2:
-			case 0xd4: case 0xd5: case 0xd6:
-			case 0xd8: case 0xd9: case 0xda: case 0xdb:
-			case 0xe0: case 0xe1: case 0xe2:
-			case 0xe4: case 0xe5: case 0xe6:
-			case 0xe8: case 0xe9: case 0xea: case 0xeb:
-			case 0xf0: case 0xf1: case 0xf2:
-			case 0xf4: case 0xf5: case 0xf6:
-			case 0xf8: case 0xf9: case 0xfa: case 0xfb:
-
-			case 0x0280: case 0x0281: case 0x0282:
-			case 0x0284: case 0x0285: case 0x0286: case 0x0287:
-			case 0x0288: case 0x0289: case 0x028a: case 0x028b:
-			case 0x0290: case 0x0291: case 0x0292:
-			case 0x0294: case 0x0295: case 0x0296:
-			case 0x0298: case 0x0299: case 0x029a: case 0x029b:
-			case 0x02a0: case 0x02a1: case 0x02a2:
-			case 0x02a4: case 0x02a5: case 0x02a6:
-			case 0x02a8: case 0x02a9: case 0x02aa: case 0x02ab:
-			case 0x02b0: case 0x02b1: case 0x02b2:
-			case 0x02b4: case 0x02b5: case 0x02b6:
-			case 0x02b8: case 0x02b9: case 0x02ba: case 0x02bb:
-			case 0x02c0: case 0x02c1: case 0x02c2:
-			case 0x02c4: case 0x02c5: case 0x02c6: case 0x02c7:
-			case 0x02c8: case 0x02c9: case 0x02ca: case 0x02cb:
-			case 0x02d0: case 0x02d1: case 0x02d2:
-			case 0x02d4: case 0x02d5: case 0x02d6:
-			case 0x02d8: case 0x02d9: case 0x02da: case 0x02db:
-			case 0x02e0: case 0x02e1: case 0x02e2:
-			case 0x02e4: case 0x02e5: case 0x02e6:
-			case 0x02e8: case 0x02e9: case 0x02ea: case 0x02eb:
-			case 0x02f0: case 0x02f1: case 0x02f2:
-			case 0x02f4: case 0x02f5: case 0x02f6:
-			case 0x02f8: case 0x02f9: case 0x02fa: case 0x02fb:
-
-			case 0x0380: case 0x0381: case 0x0382:
-			case 0x0384: case 0x0385: case 0x0386: case 0x0387:
-			case 0x0388: case 0x0389: case 0x038a: case 0x038b:
-			case 0x0390: case 0x0391: case 0x0392:
-			case 0x0394: case 0x0395: case 0x0396:
-			case 0x0398: case 0x0399: case 0x039a: case 0x039b:
-			case 0x03a0: case 0x03a1: case 0x03a2:
-			case 0x03a4: case 0x03a5: case 0x03a6:
-			case 0x03a8: case 0x03a9: case 0x03aa: case 0x03ab:
-			case 0x03b0: case 0x03b1: case 0x03b2:
-			case 0x03b4: case 0x03b5: case 0x03b6:
-			case 0x03b8: case 0x03b9: case 0x03ba: case 0x03bb:
-			case 0x03c0: case 0x03c1: case 0x03c2:
-			case 0x03c4: case 0x03c5: case 0x03c6: case 0x03c7:
-			case 0x03c8: case 0x03c9: case 0x03ca: case 0x03cb:
-			case 0x03d0: case 0x03d1: case 0x03d2:
-			case 0x03d4: case 0x03d5: case 0x03d6:
-			case 0x03d8: case 0x03d9: case 0x03da: case 0x03db:
-			case 0x03e0: case 0x03e1: case 0x03e2:
-			case 0x03e4: case 0x03e5: case 0x03e6:
-			case 0x03e8: case 0x03e9: case 0x03ea: case 0x03eb:
-			case 0x03f0: case 0x03f1: case 0x03f2:
-			case 0x03f4: case 0x03f5: case 0x03f6:
-			case 0x03f8: case 0x03f9: case 0x03fa: case 0x03fb: {
+			OP(0x80): OP(0x81): OP(0x82):
+			OP(0x84): OP(0x85): OP(0x86): OP(0x87):
+			OP(0x88): OP(0x89): OP(0x8a): OP(0x8b):
+			OP(0x90): OP(0x91): OP(0x92):
+			OP(0x94): OP(0x95): OP(0x96):
+			OP(0x98): OP(0x99): OP(0x9a): OP(0x9b):
+			OP(0xa0): OP(0xa1): OP(0xa2):
+			OP(0xa4): OP(0xa5): OP(0xa6):
+			OP(0xa8): OP(0xa9): OP(0xaa): OP(0xab):
+			OP(0xb0): OP(0xb1): OP(0xb2):
+			OP(0xb4): OP(0xb5): OP(0xb6):
+			OP(0xb8): OP(0xb9): OP(0xba): OP(0xbb):
+			OP(0xc0): OP(0xc1): OP(0xc2):
+			OP(0xc4): OP(0xc5): OP(0xc6): OP(0xc7):
+			OP(0xc8): OP(0xc9): OP(0xca): OP(0xcb):
+			OP(0xd0): OP(0xd1): OP(0xd2):
+			OP(0xd4): OP(0xd5): OP(0xd6):
+			OP(0xd8): OP(0xd9): OP(0xda): OP(0xdb):
+			OP(0xe0): OP(0xe1): OP(0xe2):
+			OP(0xe4): OP(0xe5): OP(0xe6):
+			OP(0xe8): OP(0xe9): OP(0xea): OP(0xeb):
+			OP(0xf0): OP(0xf1): OP(0xf2):
+			OP(0xf4): OP(0xf5): OP(0xf6):
+			OP(0xf8): OP(0xf9): OP(0xfa): OP(0xfb):
+
+			OP(0x0280): OP(0x0281): OP(0x0282):
+			OP(0x0284): OP(0x0285): OP(0x0286): OP(0x0287):
+			OP(0x0288): OP(0x0289): OP(0x028a): OP(0x028b):
+			OP(0x0290): OP(0x0291): OP(0x0292):
+			OP(0x0294): OP(0x0295): OP(0x0296):
+			OP(0x0298): OP(0x0299): OP(0x029a): OP(0x029b):
+			OP(0x02a0): OP(0x02a1): OP(0x02a2):
+			OP(0x02a4): OP(0x02a5): OP(0x02a6):
+			OP(0x02a8): OP(0x02a9): OP(0x02aa): OP(0x02ab):
+			OP(0x02b0): OP(0x02b1): OP(0x02b2):
+			OP(0x02b4): OP(0x02b5): OP(0x02b6):
+			OP(0x02b8): OP(0x02b9): OP(0x02ba): OP(0x02bb):
+			OP(0x02c0): OP(0x02c1): OP(0x02c2):
+			OP(0x02c4): OP(0x02c5): OP(0x02c6): OP(0x02c7):
+			OP(0x02c8): OP(0x02c9): OP(0x02ca): OP(0x02cb):
+			OP(0x02d0): OP(0x02d1): OP(0x02d2):
+			OP(0x02d4): OP(0x02d5): OP(0x02d6):
+			OP(0x02d8): OP(0x02d9): OP(0x02da): OP(0x02db):
+			OP(0x02e0): OP(0x02e1): OP(0x02e2):
+			OP(0x02e4): OP(0x02e5): OP(0x02e6):
+			OP(0x02e8): OP(0x02e9): OP(0x02ea): OP(0x02eb):
+			OP(0x02f0): OP(0x02f1): OP(0x02f2):
+			OP(0x02f4): OP(0x02f5): OP(0x02f6):
+			OP(0x02f8): OP(0x02f9): OP(0x02fa): OP(0x02fb):
+
+			OP(0x0380): OP(0x0381): OP(0x0382):
+			OP(0x0384): OP(0x0385): OP(0x0386): OP(0x0387):
+			OP(0x0388): OP(0x0389): OP(0x038a): OP(0x038b):
+			OP(0x0390): OP(0x0391): OP(0x0392):
+			OP(0x0394): OP(0x0395): OP(0x0396):
+			OP(0x0398): OP(0x0399): OP(0x039a): OP(0x039b):
+			OP(0x03a0): OP(0x03a1): OP(0x03a2):
+			OP(0x03a4): OP(0x03a5): OP(0x03a6):
+			OP(0x03a8): OP(0x03a9): OP(0x03aa): OP(0x03ab):
+			OP(0x03b0): OP(0x03b1): OP(0x03b2):
+			OP(0x03b4): OP(0x03b5): OP(0x03b6):
+			OP(0x03b8): OP(0x03b9): OP(0x03ba): OP(0x03bb):
+			OP(0x03c0): OP(0x03c1): OP(0x03c2):
+			OP(0x03c4): OP(0x03c5): OP(0x03c6): OP(0x03c7):
+			OP(0x03c8): OP(0x03c9): OP(0x03ca): OP(0x03cb):
+			OP(0x03d0): OP(0x03d1): OP(0x03d2):
+			OP(0x03d4): OP(0x03d5): OP(0x03d6):
+			OP(0x03d8): OP(0x03d9): OP(0x03da): OP(0x03db):
+			OP(0x03e0): OP(0x03e1): OP(0x03e2):
+			OP(0x03e4): OP(0x03e5): OP(0x03e6):
+			OP(0x03e8): OP(0x03e9): OP(0x03ea): OP(0x03eb):
+			OP(0x03f0): OP(0x03f1): OP(0x03f2):
+			OP(0x03f4): OP(0x03f5): OP(0x03f6):
+			OP(0x03f8): OP(0x03f9): OP(0x03fa): OP(0x03fb): {
 
 				unsigned tmp1, tmp2;
 				switch ((op >> 4) & 3) {
@@ -1104,8 +1315,8 @@ static void mc6809_run(struct MC6809 *cpu) {
 
 			// 0x83, 0x93, 0xa3, 0xb3 SUBD
 			// 0xc3, 0xd3, 0xe3, 0xf3 ADDD
-			case 0x83: case 0x93: case 0xa3: case 0xb3:
-			case 0xc3: case 0xd3: case 0xe3: case 0xf3: {
+			OP(0x83): OP(0x93): OP(0xa3): OP(0xb3):
+			OP(0xc3): OP(0xd3): OP(0xe3): OP(0xf3): {
 				unsigned tmp1, tmp2;
 				switch ((op >> 4) & 3) {
 				case 0: tmp2 = word_immediate(cpu); break;
@@ -1129,11 +1340,11 @@ static void mc6809_run(struct MC6809 *cpu) {
 			// 0x108c, 0x109c, 0x10ac, 0x10bc CMPY
 			// 0x1183, 0x1193, 0x11a3, 0x11b3 CMPU
 			// 0x118c, 0x119c, 0x11ac, 0x11bc CMPS
-			case 0x8c: case 0x9c: case 0xac: case 0xbc:
-			case 0x0283: case 0x0293: case 0x02a3: case 0x02b3:
-			case 0x028c: case 0x029c: case 0x02ac: case 0x02bc:
-			case 0x0383: case 0x0393: case 0x03a3: case 0x03b3:
-			case 0x038c: case 0x039c: case 0x03ac: case 0x03bc: {
+			OP(0x8c): OP(0x9c): OP(0xac): OP(0xbc):
+			OP(0x0283): OP(0x0293): OP(0x02a3): OP(0x02b3):
+			OP(0x028c): OP(0x029c): OP(0x02ac): OP(0x02bc):
+			OP(0x0383): OP(0x0393): OP(0x03a3): OP(0x03b3):
+			OP(0x038c): OP(0x039c): OP(0x03ac): OP(0x03bc): {
 				unsigned tmp1, tmp2;
 				switch ((op >> 4) & 3) {
 				case 0: tmp2 = word_immediate(cpu); break;
@@ -1155,7 +1366,7 @@ static void mc6809_run(struct MC6809 *cpu) {
 			} break;
 
 			// 0x10c3, 0x10d3, 0x10e3, 0x10f3 XADDD, illegal [hoglet67]
-			case 0x02c3: case 0x02d3: case 0x02e3: case 0x02f3: {
+			OP(0x02c3): OP(0x02d3): OP(0x02e3): OP(0x02f3): {
 				unsigned tmp1, tmp2;
 				switch ((op >> 4) & 3) {
 				case 0: tmp2 = word_immediate(cpu); break;
@@ -1170,7 +1381,7 @@ static void mc6809_run(struct MC6809 *cpu) {
 			} break;
 
 			// 0x11c3, 0x11d3, 0x11e3, 0x11f3 XADDU, illegal [hoglet67]
-			case 0x03c3: case 0x03d3: case 0x03e3: case 0x03f3: {
+			OP(0x03c3): OP(0x03d3): OP(0x03e3): OP(0x03f3): {
 				unsigned tmp1, tmp2;
 				switch ((op >> 4) & 3) {
 				case 0: tmp2 = word_immediate(cpu); break;
@@ -1187,9 +1398,9 @@ static void mc6809_run(struct MC6809 *cpu) {
 			// 0x8d BSR
 			// 0x9d, 0xad, 0xbd JSR
 			// 0x10xx, 0x11xx - page 2/3 fallthrough, illegal
-			case 0x8d: case 0x9d: case 0xad: case 0xbd:
-			case 0x029d: case 0x02ad: case 0x02bd:
-			case 0x039d: case 0x03ad: case 0x03bd: {
+			OP(0x8d): OP(0x9d): OP(0xad): OP(0xbd):
+			OP(0x029d): OP(0x02ad): OP(0x02bd):
+			OP(0x039d): OP(0x03ad): OP(0x03bd): {
 				unsigned ea;
 				switch ((op >> 4) & 3) {
 				case 0: ea = short_relative(cpu); ea += REG_PC; NVMA_CYCLE; NVMA_CYCLE; NVMA_CYCLE; break;
@@ -1207,11 +1418,11 @@ static void mc6809_run(struct MC6809 *cpu) {
 			// 0xce, 0xde, 0xee, 0xfe LDU
 			// 0x108e, 0x109e, 0x10ae, 0x10be LDY
 			// 0x10ce, 0x10de, 0x10ee, 0x10fe LDS
-			case 0x8e: case 0x9e: case 0xae: case 0xbe:
-			case 0xcc: case 0xdc: case 0xec: case 0xfc:
-			case 0xce: case 0xde: case 0xee: case 0xfe:
-			case 0x028e: case 0x029e: case 0x02ae: case 0x02be:
-			case 0x02ce: case 0x02de: case 0x02ee: case 0x02fe: {
+			OP(0x8e): OP(0x9e): OP(0xae): OP(0xbe):
+			OP(0xcc): OP(0xdc): OP(0xec): OP(0xfc):
+			OP(0xce): OP(0xde): OP(0xee): OP(0xfe):
+			OP(0x028e): OP(0x029e): OP(0x02ae): OP(0x02be):
+			OP(0x02ce): OP(0x02de): OP(0x02ee): OP(0x02fe): {
 				unsigned tmp1, tmp2;
 				switch ((op >> 4) & 3) {
 				case 0: tmp2 = word_immediate(cpu); break;
@@ -1235,9 +1446,9 @@ static void mc6809_run(struct MC6809 *cpu) {
 			// 0xcf STU immediate, illegal
 			// 0x10xx, 0x11xx - page 2/3 fallthrough, illegal
 			// Illegal instruction only part working
-			case 0x8f: case 0xcf:
-			case 0x028f: case 0x02cf:
-			case 0x038f: case 0x03cf: {
+			OP(0x8f): OP(0xcf):
+			OP(0x028f): OP(0x02cf):
+			OP(0x038f): OP(0x03cf): {
 				unsigned tmp1;
 				tmp1 = !(op & 0x40) ? REG_X : REG_U;
 				(void)fetch_byte_notrace(cpu, REG_PC);
@@ -1251,12 +1462,12 @@ static void mc6809_run(struct MC6809 *cpu) {
 			// 0x97, 0xa7, 0xb7 STA
 			// 0xd7, 0xe7, 0xf7 STB
 			// 0x10xx, 0x11xx - page 2/3 fallthrough, illegal
-			case 0x97: case 0xa7: case 0xb7:
-			case 0xd7: case 0xe7: case 0xf7:
-			case 0x0297: case 0x02a7: case 0x02b7:
-			case 0x02d7: case 0x02e7: case 0x02f7:
-			case 0x0397: case 0x03a7: case 0x03b7:
-			case 0x03d7: case 0x03e7: case 0x03f7: {
+			OP(0x97): OP(0xa7): OP(0xb7):
+			OP(0xd7): OP(0xe7): OP(0xf7):
+			OP(0x0297): OP(0x02a7): OP(0x02b7):
+			OP(0x02d7): OP(0x02e7): OP(0x02f7):
+			OP(0x0397): OP(0x03a7): OP(0x03b7):
+			OP(0x03d7): OP(0x03e7): OP(0x03f7): {
 				uint16_t ea;
 				uint8_t tmp1;
 				switch ((op >> 4) & 3) {
@@ -1276,11 +1487,11 @@ static void mc6809_run(struct MC6809 *cpu) {
 			// 0xdf, 0xef, 0xff STU
 			// 0x109f, 0x10af, 0x10bf STY
 			// 0x10df, 0x10ef, 0x10ff STS
-			case 0x9f: case 0xaf: case 0xbf:
-			case 0xdd: case 0xed: case 0xfd:
-			case 0xdf: case 0xef: case 0xff:
-			case 0x029f: case 0x02af: case 0x02bf:
-			case 0x02df: case 0x02ef: case 0x02ff: {
+			OP(0x9f): OP(0xaf): OP(0xbf):
+			OP(0xdd): OP(0xed): OP(0xfd):
+			OP(0xdf): OP(0xef): OP(0xff):
+			OP(0x029f): OP(0x02af): OP(0x02bf):
+			OP(0x02df): OP(0x02ef): OP(0x02ff): {
 				uint16_t ea, tmp1;
 				switch ((op >> 4) & 3) {
 				case 1: ea = ea_direct(cpu); break;
@@ -1303,10 +1514,10 @@ static void mc6809_run(struct MC6809 *cpu) {
 			} break;
 
 			// 0x1020 - 0x102f long branches
-			case 0x0220: case 0x0221: case 0x0222: case 0x0223:
-			case 0x0224: case 0x0225: case 0x0226: case 0x0227:
-			case 0x0228: case 0x0229: case 0x022a: case 0x022b:
-			case 0x022c: case 0x022d: case 0x022e: case 0x022f: {
+			OP(0x0220): OP(0x0221): OP(0x0222): OP(0x0223):
+			OP(0x0224): OP(0x0225): OP(0x0226): OP(0x0227):
+			OP(0x0228): OP(0x0229): OP(0x022a): OP(0x022b):
+			OP(0x022c): OP(0x022d): OP(0x022e): OP(0x022f): {
 				unsigned tmp = word_immediate(cpu);
 				if (branch_condition(cpu, op)) {
 					REG_PC += tmp;
@@ -1316,7 +1527,7 @@ static void mc6809_run(struct MC6809 *cpu) {
 			} break;
 
 			// 0x103e SWI2 inherent, illegal
-			case 0x023e:
+			OP(0x023e):
 				peek_byte(cpu, REG_PC);
 				push_irq_registers(cpu);
 				instruction_posthook(cpu);
@@ -1324,7 +1535,7 @@ static void mc6809_run(struct MC6809 *cpu) {
 				continue;
 
 			// 0x103f SWI2 inherent
-			case 0x023f:
+			OP(0x023f):
 				peek_byte(cpu, REG_PC);
 				stack_irq_registers(cpu);
 				instruction_posthook(cpu);
@@ -1332,7 +1543,7 @@ static void mc6809_run(struct MC6809 *cpu) {
 				continue;
 
 			// 0x113e FIRQ inherent, illegal [hoglet67]
-			case 0x033e:
+			OP(0x033e):
 				peek_byte(cpu, REG_PC);
 				push_irq_registers(cpu);
 				instruction_posthook(cpu);
@@ -1340,7 +1551,7 @@ static void mc6809_run(struct MC6809 *cpu) {
 				continue;
 
 			// 0x113f SWI3 inherent
-			case 0x033f:
+			OP(0x033f):
 				peek_byte(cpu, REG_PC);
 				stack_irq_registers(cpu);
 				instruction_posthook(cpu);
@@ -1348,7 +1559,7 @@ static void mc6809_run(struct MC6809 *cpu) {
 				continue;
 
 			// Illegal instruction
-			default:
+			OP_DEFAULT:
 				NVMA_CYCLE;
 				break;
 			}
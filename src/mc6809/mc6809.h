@@ -103,6 +103,17 @@ struct MC6809 {
 	DELEGATE_T1(void, uint32) instruction_hook;
 	// Called after instruction is executed
 	DELEGATE_T0(void) instruction_posthook;
+	// Optional.  Called before each dummy cycle while idle (SYNC, CWAI or
+	// halted).  The machine may advance time in bulk by any number of such
+	// cycles during which no event falls due, as nothing could change.
+	DELEGATE_T0(void) idle_cycles;
+	// Optional, HD6309 only.  Called before each TFM byte transfer with
+	// source address & increment, destination address & increment, and
+	// bytes remaining.  The machine may itself perform any number of
+	// whole transfers (read, dummy cycle, write) that would have no side
+	// effects and during which no event falls due, advancing the clock
+	// to match and leaving the last byte in D.  Returns number performed.
+	DELEGATE_T5(unsigned, uint16, int, uint16, int, unsigned) block_transfer;
 
 	/* Registers */
 	uint8_t reg_cc, reg_dp;
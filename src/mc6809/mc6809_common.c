@@ -87,6 +87,15 @@ static void store_byte(struct MC6809 *cpu, uint16_t a, uint8_t d) {
 #define peek_byte(c,a) ((void)fetch_byte_notrace(c,a))
 #define NVMA_CYCLE (peek_byte(cpu, 0xffff))
 
+// Dummy cycle while idle (SYNC, CWAI, halted).  Unless an interrupt input is
+// already asserted, the machine may first account in bulk for any run of these
+// during which nothing can happen.
+#define IDLE_CYCLE do { \
+		if (!(cpu->nmi || cpu->firq || cpu->irq)) \
+			DELEGATE_SAFE_CALL(cpu->idle_cycles); \
+		NVMA_CYCLE; \
+	} while (0)
+
 /*
  * Stack operations
  */
@@ -0,0 +1,47 @@
+/** \file
+ *
+ *  \brief Motorola MC680x-compatible opcode dispatch.
+ *
+ *  \copyright Copyright 2026 agent
+ *
+ *  \licenseblock This file is part of XRoar, a Dragon/Tandy CoCo emulator.
+ *
+ *  XRoar is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation, either version 3 of the License, or (at your option) any later
+ *  version.
+ *
+ *  See COPYING.GPL for redistribution conditions.
+ *
+ *  \endlicenseblock
+ *
+ *  Each core decodes opcodes with a switch.  Top-level cases are labelled
+ *  OP(n) and the default case OP_DEFAULT, and DISPATCH_OP() immediately
+ *  precedes the switch.
+ *
+ *  Normally, these expand to plain case labels and DISPATCH_OP() does
+ *  nothing.  When configured with --enable-computed-goto, each label also
+ *  names a goto target, and DISPATCH_OP() jumps straight to it through a
+ *  table of label addresses (a GCC extension), bypassing the switch's range
+ *  check.  The table must be declared by the core as op_table, mapping
+ *  unhandled opcodes to &&op_default.
+ */
+
+#ifndef XROAR_MC680X_MC680X_DISPATCH_H_
+#define XROAR_MC680X_MC680X_DISPATCH_H_
+
+#ifdef WANT_COMPUTED_GOTO
+
+#define OP(o) case o: op_ ## o
+#define OP_DEFAULT default: op_default
+#define DISPATCH_OP(table, op) goto *(table)[(op)]
+
+#else
+
+#define OP(o) case o
+#define OP_DEFAULT default
+#define DISPATCH_OP(table, op) do { } while (0)
+
+#endif
+
+#endif
@@ -52,6 +52,15 @@ enum vdg_render_mode {
 	VDG_RENDER_RG,
 };
 
+// Byte-parallel expansion of video data.  For each data byte, a mask with each
+// bit expanded to 2 (32-byte modes) or 4 (16-byte modes) pixels.  Masks are
+// built bytewise in the order they appear in pixel_data[], so work regardless
+// of host endianness.
+
+static uint64_t expand_2px[256][2];
+static uint64_t expand_4px[256][4];
+static bool have_expand_tables = 0;
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 struct MC6847_private {
@@ -198,6 +207,7 @@ const struct ser_struct_data mc6847_ser_struct_data = {
 static void do_hs_fall(void *);
 static void do_hs_rise(void *);
 
+static void init_expand_tables(void);
 static void render_scanline(struct MC6847_private *vdg);
 
 // Canonify scanline numbers:
@@ -238,6 +248,8 @@ static struct part *mc6847_allocate(void) {
 	event_init(&vdg->hs_fall_event, MACHINE_EVENT_LIST, DELEGATE_AS0(void, do_hs_fall, vdg));
 	event_init(&vdg->hs_rise_event, MACHINE_EVENT_LIST, DELEGATE_AS0(void, do_hs_rise, vdg));
 
+	init_expand_tables();
+
 	return p;
 }
 
@@ -410,6 +422,77 @@ static void do_hs_rise(void *data) {
 	DELEGATE_CALL(vdg->public.signal_hs, 1);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+static void init_expand_tables(void) {
+	if (have_expand_tables)
+		return;
+	for (unsigned d = 0; d < 256; d++) {
+		uint8_t m2[16], m4[32];
+		for (unsigned i = 0; i < 8; i++) {
+			uint8_t m = (d & (0x80 >> i)) ? 0xff : 0;
+			memset(m2 + i*2, m, 2);
+			memset(m4 + i*4, m, 4);
+		}
+		memcpy(expand_2px[d], m2, sizeof(m2));
+		memcpy(expand_4px[d], m4, sizeof(m4));
+	}
+	have_expand_tables = 1;
+}
+
+// Render a whole byte of active area at once.  Only called at a byte boundary
+// when the whole byte lies before the current time, so no mode change can
+// take effect partway through it.  Output is identical to rendering it two
+// bits at a time.
+//
+// Each 64-bit word holds 8 palettised pixels.  Colours are replicated across
+// the word and selected by mask; in colour graphics modes, each pixel's
+// 2-bit colour index is added to the base colour without carry between
+// bytes.
+
+static uint8_t *render_byte(struct MC6847_private *vdg, uint8_t *pixel) {
+	const uint64_t ones = UINT64_C(0x0101010101010101);
+	unsigned nwords = vdg->is_32byte ? 2 : 4;
+	uint64_t out[4];
+
+	if (vdg->render_mode == VDG_RENDER_CG) {
+		// Spread high and low bit of each pair across both positions
+		uint8_t d = vdg->vram_g_data;
+		uint8_t hi = (d & 0xaa) | ((d & 0xaa) >> 1);
+		uint8_t lo = (d & 0x55) | ((d & 0x55) << 1);
+		const uint64_t *mhi = vdg->is_32byte ? expand_2px[hi] : expand_4px[hi];
+		const uint64_t *mlo = vdg->is_32byte ? expand_2px[lo] : expand_4px[lo];
+		uint64_t base = ones * vdg->cg_colours;
+		for (unsigned i = 0; i < nwords; i++) {
+			out[i] = base + (mhi[i] & (ones * 2)) + (mlo[i] & ones);
+		}
+	} else {
+		uint64_t fg, bg;
+		uint8_t d;
+		if (vdg->render_mode == VDG_RENDER_RG) {
+			d = vdg->vram_g_data;
+			fg = ones * vdg->fg_colour;
+			bg = ones * vdg->bg_colour;
+		} else {
+			d = vdg->vram_sg_data;
+			fg = ones * vdg->s_fg_colour;
+			bg = ones * vdg->s_bg_colour;
+		}
+		const uint64_t *mask = vdg->is_32byte ? expand_2px[d] : expand_4px[d];
+		for (unsigned i = 0; i < nwords; i++) {
+			out[i] = (fg & mask[i]) | (bg & ~mask[i]);
+		}
+	}
+
+	memcpy(pixel, out, nwords * 8);
+	vdg->beam_pos += nwords * 8;
+	vdg->vram_bit = 0;
+	vdg->vram_remaining--;
+	vdg->vram_g_data = 0;
+	vdg->vram_sg_data = 0;
+	return pixel + nwords * 8;
+}
+
 // Renders current scanline up to the current time.
 
 static void render_scanline(struct MC6847_private *vdg) {
@@ -528,6 +611,16 @@ static void render_scanline(struct MC6847_private *vdg) {
 			}
 		}
 
+		// Fast path: whole byte known to render in the current mode.
+
+		if (vdg->vram_bit == 8 &&
+		    vdg->beam_pos + (vdg->is_32byte ? 16 : 32) <= beam_to) {
+			pixel = render_byte(vdg, pixel);
+			if (vdg->beam_pos >= beam_to)
+				return;
+			continue;
+		}
+
 		// Output is rendered for two bits of input data at a time.
 		// This limits where mode changes can take effect, possibly a
 		// little too much (2 bits can be 4 pixels in 16-byte modes).
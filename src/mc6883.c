@@ -274,6 +274,7 @@ static bool mc6883_finish(struct part *p);
 static void mc6883_reset(struct MC6883 *);
 static int mc6883_mem_cycle(void *, bool RnW, uint16_t A);
 static unsigned mc6883_decode(struct MC6883 *, bool RnW, uint16_t A);
+static bool mc6883_map_decode(struct MC6883 *, bool RnW, uint16_t A, struct MC6883_decode *);
 static void mc6883_vdg_hsync(struct MC6883 *, bool level);
 static void mc6883_vdg_fsync(struct MC6883 *, bool level);
 static int mc6883_vdg_bytes(struct MC6883 *, int nbytes);
@@ -304,10 +305,12 @@ static struct part *mc6883_allocate(void) {
 	*sam = (struct MC6883_private){0};
 
 	sam->public.vdg_update = DELEGATE_DEFAULT0(void);
+	sam->public.map_update = DELEGATE_DEFAULT0(void);
 
 	samp->reset = mc6883_reset;
 	samp->mem_cycle = mc6883_mem_cycle;
 	samp->decode = mc6883_decode;
+	samp->map_decode = mc6883_map_decode;
 	samp->vdg_hsync = mc6883_vdg_hsync;
 	samp->vdg_fsync = mc6883_vdg_fsync;
 	samp->vdg_bytes = mc6883_vdg_bytes;
@@ -415,6 +418,7 @@ static void mc6883_reset(struct MC6883 *samp) {
 	mc6883_vdg_fsync(samp, 1);
 	sam->running_fast = 0;
 	sam->extend_slow_cycle = 0;
+	DELEGATE_CALL(samp->map_update);
 }
 
 #define VRAM_TRANSLATE_ROW(a) \
@@ -436,18 +440,14 @@ static void mc6883_reset(struct MC6883 *samp) {
 static uint8_t const io_S[8] = { 4, 5, 6, 7, 7, 7, 7, 2 };
 static uint8_t const data_S[8] = { 7, 7, 7, 7, 1, 2, 3, 3 };
 
-static int mc6883_mem_cycle(void *sptr, bool RnW, uint16_t A) {
-	struct MC6883 *samp = sptr;
-	struct MC6883_private *sam = (struct MC6883_private *)samp;
-	int ncycles;
-	bool fast_cycle;
-	bool want_register_update = 0;
+// Address decode common to mem_cycle() and map_decode().  Returns S, and sets
+// *is_RAM if the address selects RAM.
 
+static unsigned decode_S(const struct MC6883_private *sam, bool RnW, uint16_t A, bool *is_RAM) {
 	bool is_FFxx    = ((A >> 8) & 0xff) == 0xff;
 	bool is_IO0     = is_FFxx && ((A >> 5) & 0x7) == 0x0;  // FF0x and FF1x
 	bool is_IO1     = is_FFxx && ((A >> 5) & 0x7) == 0x1;  // FF2x and FF3x
 	bool is_IO2     = is_FFxx && ((A >> 5) & 0x7) == 0x2;  // FF4x and FF5x
-	bool is_SAM_REG = is_FFxx && ((A >> 5) & 0x7) == 0x6;  // FFCx and FFDx
 	bool is_IRQ_VEC = is_FFxx && ((A >> 5) & 0x7) == 0x7;  // FFEx and FFFx
 
 	bool is_8xxx = ((A >> 13) & 0x7) == 0x4;
@@ -455,38 +455,53 @@ static int mc6883_mem_cycle(void *sptr, bool RnW, uint16_t A) {
 	bool is_Cxxx = ((A >> 14) & 0x3) == 0x3 && !is_FFxx;
 	bool is_upper_32K = is_8xxx || is_Axxx || is_Cxxx;
 
-	bool is_RAM = !(A & 0x8000) || (sam->TY && !is_FFxx);
+	*is_RAM = !(A & 0x8000) || (sam->TY && !is_FFxx);
 
 	if (!sam->want_785) {
 		// Regular '783 behaviour
-		if (is_IO0) samp->S = 0x4;
-		else if (is_IO1) samp->S = 0x5;
-		else if (is_IO2) samp->S = 0x6;
-		else if (is_IRQ_VEC) samp->S = 0x2;
-		else if (is_FFxx) samp->S = 0x7;
-		else if (is_upper_32K && sam->TY && RnW) samp->S = 0x0;
-		else if (is_8xxx) samp->S = 0x1;
-		else if (is_Axxx) samp->S = 0x2;
-		else if (is_Cxxx) samp->S = 0x3;
-		else if (RnW) samp->S = 0x0;
-		else samp->S = 0x7;
-	} else {
-		// Variant '785 behaviour
-		if (is_IO0) samp->S = 0x4;
-		else if (is_IO1) samp->S = 0x5;
-		else if (is_IO2) samp->S = 0x6;
-		else if (is_IRQ_VEC && !RnW) samp->S = 0x7;
-		else if (is_IRQ_VEC) samp->S = 0x2;
-		else if (is_FFxx) samp->S = 0x7;
-		else if (is_upper_32K && sam->TY && RnW) samp->S = 0x0;
-		else if (is_upper_32K && sam->TY) samp->S = 0x7;
-		else if (is_8xxx) samp->S = 0x1;
-		else if (is_Axxx) samp->S = 0x2;
-		else if (is_Cxxx) samp->S = 0x3;
-		else if (RnW) samp->S = 0x0;
-		else samp->S = 0x7;
+		if (is_IO0) return 0x4;
+		else if (is_IO1) return 0x5;
+		else if (is_IO2) return 0x6;
+		else if (is_IRQ_VEC) return 0x2;
+		else if (is_FFxx) return 0x7;
+		else if (is_upper_32K && sam->TY && RnW) return 0x0;
+		else if (is_8xxx) return 0x1;
+		else if (is_Axxx) return 0x2;
+		else if (is_Cxxx) return 0x3;
+		else if (RnW) return 0x0;
+		return 0x7;
 	}
 
+	// Variant '785 behaviour
+	if (is_IO0) return 0x4;
+	else if (is_IO1) return 0x5;
+	else if (is_IO2) return 0x6;
+	else if (is_IRQ_VEC && !RnW) return 0x7;
+	else if (is_IRQ_VEC) return 0x2;
+	else if (is_FFxx) return 0x7;
+	else if (is_upper_32K && sam->TY && RnW) return 0x0;
+	else if (is_upper_32K && sam->TY) return 0x7;
+	else if (is_8xxx) return 0x1;
+	else if (is_Axxx) return 0x2;
+	else if (is_Cxxx) return 0x3;
+	else if (RnW) return 0x0;
+	return 0x7;
+}
+
+static int mc6883_mem_cycle(void *sptr, bool RnW, uint16_t A) {
+	struct MC6883 *samp = sptr;
+	struct MC6883_private *sam = (struct MC6883_private *)samp;
+	int ncycles;
+	bool fast_cycle;
+	bool want_register_update = 0;
+
+	bool is_FFxx    = ((A >> 8) & 0xff) == 0xff;
+	bool is_IO0     = is_FFxx && ((A >> 5) & 0x7) == 0x0;  // FF0x and FF1x
+	bool is_SAM_REG = is_FFxx && ((A >> 5) & 0x7) == 0x6;  // FFCx and FFDx
+
+	bool is_RAM;
+	samp->S = decode_S(sam, RnW, A, &is_RAM);
+
 	samp->nWE = is_RAM ? RnW : 1;
 	samp->RAS0 = samp->RAS1 = 0;
 
@@ -549,6 +564,9 @@ static int mc6883_mem_cycle(void *sptr, bool RnW, uint16_t A) {
 				sam->extend_slow_cycle = 0;
 			}
 			sam->running_fast = 0;
+			if (sam->R == 0) {
+				DELEGATE_CALL(samp->map_update);
+			}
 		} else {
 			// Fast cycle, may become un-interleaved
 			ncycles = EVENT_TICKS_14M31818(8);
@@ -558,11 +576,38 @@ static int mc6883_mem_cycle(void *sptr, bool RnW, uint16_t A) {
 
 	if (want_register_update) {
 		update_from_register(sam);
+		if (((A >> 1) & 0xf) >= 0xa) {
+			// P, R, M or TY changed: affects address translation
+			DELEGATE_CALL(samp->map_update);
+		}
 	}
 
 	return ncycles;
 }
 
+// Address decode and RAM translation from mc6883_mem_cycle(), without side
+// effects.  Only valid while the MPU rate is fixed slow, as then every cycle
+// takes the same time and leaves timing state untouched.
+
+static bool mc6883_map_decode(struct MC6883 *samp, bool RnW, uint16_t A, struct MC6883_decode *d) {
+	const struct MC6883_private *sam = (struct MC6883_private *)samp;
+	if (sam->R != 0 || sam->running_fast)
+		return 0;
+
+	bool is_RAM;
+	d->S = decode_S(sam, RnW, A, &is_RAM);
+	d->nWE = is_RAM ? RnW : 1;
+	d->RAS0 = d->RAS1 = 0;
+	d->Zrow = d->Zcol = 0;
+	if (is_RAM) {
+		d->RAS1 = sam->ram_ras1 && (A & sam->ram_ras1_bit);
+		d->RAS0 = !(A & sam->ram_ras1_bit);
+		d->Zrow = RAM_TRANSLATE_ROW(A);
+		d->Zcol = RAM_TRANSLATE_COL(A);
+	}
+	return 1;
+}
+
 // Just the address decode from mc6883_mem_cycle().  Used to verify that a
 // breakpoint refers to ROM.
 
@@ -903,4 +948,5 @@ static void mc6883_set_register(void *sptr, int n, uint32_t v) {
 	sam->M = (v >> 13) & 3;
 	sam->TY = (v >> 15) & 1;
 	update_from_register(sam);
+	DELEGATE_CALL(sam->public.map_update);
 }
@@ -28,6 +28,17 @@
 
 struct ram;
 
+// Result of a side-effect-free address decode, as returned by map_decode().
+
+struct MC6883_decode {
+	uint8_t S;
+	unsigned Zrow;
+	unsigned Zcol;
+	bool nWE;
+	bool RAS0;
+	bool RAS1;
+};
+
 struct MC6883 {
 	struct part part;
 
@@ -43,9 +54,20 @@ struct MC6883 {
 
 	DELEGATE_T0(void) vdg_update;
 
+	// Called whenever the result of map_decode() may have changed for any
+	// address, e.g. after a write to the SAM control register.
+	DELEGATE_T0(void) map_update;
+
 	void (*reset)(struct MC6883 *);
 	int (*mem_cycle)(void *, bool RnW, uint16_t A);
 	unsigned (*decode)(struct MC6883 *, bool RnW, uint16_t A);
+
+	// Optional.  Decode an address as mem_cycle() would, without side
+	// effects.  Only succeeds (returns true) while a cycle to any address
+	// would be a plain slow cycle that leaves SAM state unchanged, i.e. the
+	// caller may then skip mem_cycle() and account 16 ticks itself for
+	// addresses that aren't SAM registers.
+	bool (*map_decode)(struct MC6883 *, bool RnW, uint16_t A, struct MC6883_decode *);
 	void (*vdg_fsync)(struct MC6883 *, bool level);
 	void (*vdg_hsync)(struct MC6883 *, bool level);
 	int (*vdg_bytes)(struct MC6883 *, int nbytes);
@@ -93,7 +93,35 @@ void ntsc_burst_set(struct vo_render *vr, unsigned burstn) {
 	}
 }
 
+// Tap k of the decode filter for output pixel at time t sees a signal
+// sample encoded at time t-3+k.
+
+void ntsc_lut_set(struct vo_render *vr, unsigned burstn, struct ntsc_lut *lut) {
+	struct ntsc_palette *np = &vr->cmp.ntsc_palette;
+	struct ntsc_burst *nb = &vr->cmp.burst[burstn].ntsc_burst;
+	static const int ycoeff[7] = {
+		NTSC_C3, NTSC_C2, NTSC_C1, NTSC_C0, NTSC_C1, NTSC_C2, NTSC_C3
+	};
+
+	for (unsigned t = 0; t < NTSC_NPHASES; t++) {
+		const int *burstu = nb->byphase[(t+0) % NTSC_NPHASES];
+		const int *burstv = nb->byphase[(t+1) % NTSC_NPHASES];
+		for (unsigned k = 0; k < 7; k++) {
+			const int *encoded = np->byphase[(t+NTSC_NPHASES-3+k) % NTSC_NPHASES];
+			for (unsigned c = 0; c < 256; c++) {
+				int y = ycoeff[k] * encoded[c];
+				int u = burstu[k] * encoded[c];
+				int v = burstv[k] * encoded[c];
+				lut->tap[t][k][c].x = +155*y   +0*u +177*v;
+				lut->tap[t][k][c].y = +155*y  -61*u  -90*v;
+				lut->tap[t][k][c].z = +155*y +315*u   +0*v;
+			}
+		}
+	}
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+extern inline int_xyz ntsc_decode_lut(const struct ntsc_lut *lut, const uint8_t *data, unsigned t);
 extern inline int_xyz ntsc_decode(const struct ntsc_burst *nb, const uint8_t *ntsc, unsigned t);
 extern inline int_xyz ntsc_decode_mono(const uint8_t *ntsc);
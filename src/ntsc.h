@@ -46,10 +46,21 @@ struct ntsc_burst {
 	int byphase[NTSC_NPHASES][7];
 };
 
+// Decode table.  As the encoded signal is just a palette lookup by phase, the
+// contribution of each tap to the (unshifted) R'G'B' result can be tabulated
+// per output phase and palette index.  Decoding a pixel is then seven lookups
+// and adds, with results identical to ntsc_decode().
+
+struct ntsc_lut {
+	int_xyz tap[NTSC_NPHASES][7][256];
+};
+
 void ntsc_palette_set_ybr(struct vo_render *vr, unsigned c);
 
 void ntsc_burst_set(struct vo_render *vr, unsigned burstn);
 
+void ntsc_lut_set(struct vo_render *vr, unsigned burstn, struct ntsc_lut *lut);
+
 inline int_xyz ntsc_decode(const struct ntsc_burst *nb, const uint8_t *ntsc, unsigned t) {
 	int_xyz buf;
 	const int *burstu = nb->byphase[(t+0) % NTSC_NPHASES];
@@ -71,6 +82,22 @@ inline int_xyz ntsc_decode(const struct ntsc_burst *nb, const uint8_t *ntsc, uns
 	return buf;
 }
 
+// Unlike ntsc_decode(), takes palettised data, not encoded signal.
+
+inline int_xyz ntsc_decode_lut(const struct ntsc_lut *lut, const uint8_t *data, unsigned t) {
+	const int_xyz (*tap)[256] = lut->tap[t % NTSC_NPHASES];
+	int_xyz buf = tap[0][data[0]];
+	for (int k = 1; k < 7; k++) {
+		buf.x += tap[k][data[k]].x;
+		buf.y += tap[k][data[k]].y;
+		buf.z += tap[k][data[k]].z;
+	}
+	buf.x >>= 22;
+	buf.y >>= 22;
+	buf.z >>= 22;
+	return buf;
+}
+
 inline int_xyz ntsc_decode_mono(const uint8_t *ntsc) {
 	int_xyz buf;
 	int y = NTSC_C3*ntsc[0] + NTSC_C2*ntsc[1] + NTSC_C1*ntsc[2] +
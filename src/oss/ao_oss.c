@@ -14,12 +14,18 @@
  *  See COPYING.GPL for redistribution conditions.
  *
  *  \endlicenseblock
+ *
+ *  Where threads are available, a separate thread makes the blocking writes to
+ *  the device, fetching audio from the sound interface's ring.
  */
 
 #include "top-config.h"
 
 #include <errno.h>
 #include <fcntl.h>
+#ifdef HAVE_PTHREADS
+#include <pthread.h>
+#endif
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -48,11 +54,22 @@ struct ao_oss_interface {
 
 	int sound_fd;
 	int fragment_nbytes;
+	int fragment_nframes;
 	void *audio_buffer;
+
+#ifdef HAVE_PTHREADS
+	bool have_thread;
+	pthread_t thread;
+	pthread_mutex_t mt;
+	bool quit;
+#endif
 };
 
 static void ao_oss_free(void *sptr);
 static void *ao_oss_write_buffer(void *sptr, void *buffer);
+#ifdef HAVE_PTHREADS
+static void *writer_thread(void *sptr);
+#endif
 
 static const char *default_devices[] = {
 	"/dev/dsp",
@@ -220,6 +237,7 @@ static void *new(void *cfg) {
 	}
 	aooss->fragment_nbytes = 1 << frag_size_sel;
 	fragment_nframes = aooss->fragment_nbytes / (bytes_per_sample * nchannels);
+	aooss->fragment_nframes = fragment_nframes;
 	buffer_nframes = fragment_nframes * nfragments;
 
 	aooss->audio_buffer = xmalloc(aooss->fragment_nbytes);
@@ -229,13 +247,29 @@ static void *new(void *cfg) {
 		LOG_MOD_ERROR("oss", "failed to initialise: XRoar internal error\n");
 		goto failed;
 	}
-	ao->sound_interface->write_buffer = DELEGATE_AS1(voidp, voidp, ao_oss_write_buffer, ao);
 	LOG_DEBUG(1, "\t%d frags * %d frames/frag = %d frames buffer (%.1fms)\n", nfragments, fragment_nframes, buffer_nframes, (float)(buffer_nframes * 1000) / rate);
 
 	ioctl(aooss->sound_fd, SNDCTL_DSP_RESET, 0);
+
+#ifdef HAVE_PTHREADS
+	if (sound_ring_enable(ao->sound_interface)) {
+		pthread_mutex_init(&aooss->mt, NULL);
+		if (pthread_create(&aooss->thread, NULL, writer_thread, aooss) != 0) {
+			LOG_MOD_ERROR("oss", "failed to create writer thread\n");
+			pthread_mutex_destroy(&aooss->mt);
+			goto failed;
+		}
+		aooss->have_thread = 1;
+		return aooss;
+	}
+#endif
+
+	ao->sound_interface->write_buffer = DELEGATE_AS1(voidp, voidp, ao_oss_write_buffer, ao);
 	return aooss;
 
 failed:
+	if (ao->sound_interface)
+		sound_interface_free(ao->sound_interface);
 	free(aooss->audio_buffer);
 	if (aooss->sound_fd != -1)
 		close(aooss->sound_fd);
@@ -246,6 +280,16 @@ failed:
 static void ao_oss_free(void *sptr) {
 	struct ao_oss_interface *aooss = sptr;
 
+#ifdef HAVE_PTHREADS
+	if (aooss->have_thread) {
+		pthread_mutex_lock(&aooss->mt);
+		aooss->quit = 1;
+		pthread_mutex_unlock(&aooss->mt);
+		pthread_join(aooss->thread, NULL);
+		pthread_mutex_destroy(&aooss->mt);
+	}
+#endif
+
 	ioctl(aooss->sound_fd, SNDCTL_DSP_RESET, 0);
 	close(aooss->sound_fd);
 	sound_interface_free(aooss->public.sound_interface);
@@ -262,3 +306,22 @@ static void *ao_oss_write_buffer(void *sptr, void *buffer) {
 	(void)r;
 	return buffer;
 }
+
+#ifdef HAVE_PTHREADS
+
+static void *writer_thread(void *sptr) {
+	struct ao_oss_interface *aooss = sptr;
+	for (;;) {
+		pthread_mutex_lock(&aooss->mt);
+		bool quit = aooss->quit;
+		pthread_mutex_unlock(&aooss->mt);
+		if (quit)
+			break;
+		sound_ring_read(aooss->public.sound_interface, aooss->audio_buffer, aooss->fragment_nframes);
+		int r = write(aooss->sound_fd, aooss->audio_buffer, aooss->fragment_nbytes);
+		(void)r;
+	}
+	return NULL;
+}
+
+#endif
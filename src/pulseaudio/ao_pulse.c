@@ -14,10 +14,16 @@
  *  See COPYING.GPL for redistribution conditions.
  *
  *  \endlicenseblock
+ *
+ *  Where threads are available, a separate thread makes the blocking writes to
+ *  the server, fetching audio from the sound interface's ring.
  */
 
 #include "top-config.h"
 
+#ifdef HAVE_PTHREADS
+#include <pthread.h>
+#endif
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -46,11 +52,22 @@ struct ao_pulse_interface {
 
 	pa_simple *pa;
 	size_t fragment_nbytes;
+	unsigned fragment_nframes;
 	void *audio_buffer;
+
+#ifdef HAVE_PTHREADS
+	bool have_thread;
+	pthread_t thread;
+	pthread_mutex_t mt;
+	bool quit;
+#endif
 };
 
 static void ao_pulse_free(void *sptr);
 static void *ao_pulse_write_buffer(void *sptr, void *buffer);
+#ifdef HAVE_PTHREADS
+static void *writer_thread(void *sptr);
+#endif
 
 static void *new(void *cfg) {
 	(void)cfg;
@@ -124,6 +141,7 @@ static void *new(void *cfg) {
 		goto failed;
 	}
 
+	aopulse->fragment_nframes = fragment_nframes;
 	aopulse->fragment_nbytes = fragment_nframes * sample_nbytes * nchannels;
 	aopulse->audio_buffer = xmalloc(aopulse->fragment_nbytes);
 	ao->sound_interface = sound_interface_new(aopulse->audio_buffer, request_fmt, rate, nchannels, fragment_nframes);
@@ -131,11 +149,29 @@ static void *new(void *cfg) {
 		LOG_MOD_ERROR("pulse", "failed to initialise: XRoar internal error\n");
 		goto failed;
 	}
-	ao->sound_interface->write_buffer = DELEGATE_AS1(voidp, voidp, ao_pulse_write_buffer, ao);
 	LOG_DEBUG(1, "\t%d frags * %d frames/frag = %d frames buffer (%ums)\n", nfragments, fragment_nframes, nfragments * fragment_nframes, (nfragments * fragment_nframes * 1000) / rate);
+
+#ifdef HAVE_PTHREADS
+	if (sound_ring_enable(ao->sound_interface)) {
+		pthread_mutex_init(&aopulse->mt, NULL);
+		if (pthread_create(&aopulse->thread, NULL, writer_thread, aopulse) != 0) {
+			LOG_MOD_ERROR("pulse", "failed to create writer thread\n");
+			pthread_mutex_destroy(&aopulse->mt);
+			goto failed;
+		}
+		aopulse->have_thread = 1;
+		return aopulse;
+	}
+#endif
+
+	ao->sound_interface->write_buffer = DELEGATE_AS1(voidp, voidp, ao_pulse_write_buffer, ao);
 	return aopulse;
 
 failed:
+	if (ao->sound_interface)
+		sound_interface_free(ao->sound_interface);
+	if (aopulse->pa)
+		pa_simple_free(aopulse->pa);
 	free(aopulse->audio_buffer);
 	free(aopulse);
 	return NULL;
@@ -144,6 +180,16 @@ failed:
 static void ao_pulse_free(void *sptr) {
 	struct ao_pulse_interface *aopulse = sptr;
 
+#ifdef HAVE_PTHREADS
+	if (aopulse->have_thread) {
+		pthread_mutex_lock(&aopulse->mt);
+		aopulse->quit = 1;
+		pthread_mutex_unlock(&aopulse->mt);
+		pthread_join(aopulse->thread, NULL);
+		pthread_mutex_destroy(&aopulse->mt);
+	}
+#endif
+
 	int error;
 	pa_simple_flush(aopulse->pa, &error);
 	pa_simple_free(aopulse->pa);
@@ -161,3 +207,22 @@ static void *ao_pulse_write_buffer(void *sptr, void *buffer) {
 	pa_simple_write(aopulse->pa, buffer, aopulse->fragment_nbytes, &error);
 	return buffer;
 }
+
+#ifdef HAVE_PTHREADS
+
+static void *writer_thread(void *sptr) {
+	struct ao_pulse_interface *aopulse = sptr;
+	for (;;) {
+		pthread_mutex_lock(&aopulse->mt);
+		bool quit = aopulse->quit;
+		pthread_mutex_unlock(&aopulse->mt);
+		if (quit)
+			break;
+		sound_ring_read(aopulse->public.sound_interface, aopulse->audio_buffer, aopulse->fragment_nframes);
+		int error;
+		pa_simple_write(aopulse->pa, aopulse->audio_buffer, aopulse->fragment_nbytes, &error);
+	}
+	return NULL;
+}
+
+#endif
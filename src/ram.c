@@ -355,6 +355,8 @@ extern inline void ram_d8(struct ram *ram, bool RnW, unsigned bank,
 			  unsigned row, unsigned col, uint8_t *d);
 extern inline void ram_d16(struct ram *ram, bool RnW, unsigned bank,
 			   unsigned row, unsigned col, uint16_t *d);
+extern inline unsigned ram_read_row_be16(struct ram *ram, unsigned bank, unsigned row, unsigned col,
+					 unsigned nwords, uint16_t *dest);
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
@@ -28,8 +28,10 @@
 #define XROAR_RAM_H_
 
 #include <stdint.h>
+#include <string.h>
 
 #include "delegate.h"
+#include "pl-endian.h"
 
 #include "part.h"
 
@@ -148,6 +150,29 @@ inline void ram_d16(struct ram *ram, bool RnW, unsigned bank,
 	}
 }
 
+// Read big-endian 16-bit words from 8-bit RAM, starting at an even row
+// address and stopping at the end of that row.  Returns the number of words
+// read (no more than nwords), or 0 if the bank is not present.  Used to fetch
+// runs of video data a row at a time.
+
+inline unsigned ram_read_row_be16(struct ram *ram, unsigned bank, unsigned row, unsigned col,
+				  unsigned nwords, uint16_t *dest) {
+	uint8_t *p = ram_a8(ram, bank, row, col);
+	if (!p)
+		return 0;
+	unsigned n = ((ram->row_mask + 1) - (row & ram->row_mask)) / 2;
+	if (n > nwords)
+		n = nwords;
+#if __BYTE_ORDER == __BIG_ENDIAN
+	memcpy(dest, p, n * 2);
+#else
+	for (unsigned i = 0; i < n; i++) {
+		dest[i] = (p[i*2] << 8) | p[i*2+1];
+	}
+#endif
+	return n;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 unsigned ram_report(struct ram *ram, const char *par, const char *name);
@@ -120,6 +120,7 @@ static struct part *rsdos_allocate(void) {
 	*d = (struct rsdos){0};
 
 	cart_rom_init(c);
+	c->decode_only = 1;
 
 	c->detach = rsdos_detach;
 	c->read = rsdos_read;
@@ -97,6 +97,7 @@ int screenshot_write_png(const char *filename, struct vo_interface *vo) {
 	png_write_info(png_ptr, info_ptr);
 
 	// write image data
+	vo_render_sync(vo->renderer);
 	for (int j = 0; j < height; j++) {
 		memset(line, 0, 3 * width);
 		vo->renderer->line_to_rgb(vo->renderer, j, line);
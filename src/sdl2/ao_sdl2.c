@@ -15,9 +15,12 @@
  *
  *  \endlicenseblock
  *
- *  We now use SDL's queued audio interface.  When writing, we query how much
- *  is left in the queue, and if it's too much we wait a while for the queue to
- *  drain.
+ *  Where the sound interface's audio ring is available, SDL's audio callback
+ *  fetches audio from it.
+ *
+ *  Otherwise (e.g. WebAssembly) we use SDL's queued audio interface.  When
+ *  writing, we query how much is left in the queue, and if it's too much we
+ *  wait a while for the queue to drain.
  */
 
 #include "top-config.h"
@@ -59,14 +62,16 @@ struct ao_sdl2_interface {
 	unsigned nfragments;
 	unsigned fragment_nbytes;
 
-	// Now that the WASAPI driver isn't causing issues in Windows, we
-	// can use SDL's queued audio interface for all builds.
+	// Without the audio ring, SDL's queued audio interface is used.
 	void *fragment_buffer;
 	Uint32 qbytes_threshold;
 	unsigned qdelay_divisor;
 };
 
 static void ao_sdl2_free(void *sptr);
+#ifdef HAVE_SOUND_RING
+static void callback(void *userdata, Uint8 *stream, int len);
+#endif
 static void *ao_sdl2_write_buffer(void *sptr, void *buffer);
 #ifndef HAVE_WASM
 static void *ao_sdl2_write_silence(void *sptr, void *buffer);
@@ -135,7 +140,11 @@ static void *new(void *cfg) {
 	desired.freq = rate;
 	desired.channels = nchannels;
 	desired.samples = fragment_nframes;
+#ifdef HAVE_SOUND_RING
+	desired.callback = callback;
+#else
 	desired.callback = NULL;
+#endif
 	desired.userdata = aosdl;
 
 	switch (xroar.cfg.ao.format) {
@@ -235,10 +244,24 @@ static void *new(void *cfg) {
 		LOG_MOD_SUB_ERROR("sdl", "audio", "failed to initialise: XRoar internal error\n");
 		goto failed;
 	}
-	ao->sound_interface->write_buffer = DELEGATE_AS1(voidp, voidp, ao_sdl2_write_buffer, ao);
+	if (!aosdl->audiospec.callback || !sound_ring_enable(ao->sound_interface)) {
+		if (aosdl->audiospec.callback) {
+			// Can't use the callback after all, so reopen the device
+			// exactly as obtained, but without one.
+			LOG_MOD_SUB_DEBUG(3, "sdl", "audio", "audio ring not available: using queued audio\n");
+			SDL_CloseAudioDevice(aosdl->device);
+			aosdl->audiospec.callback = NULL;
+			aosdl->device = SDL_OpenAudioDevice(xroar.cfg.ao.device, 0, &aosdl->audiospec, NULL, 0);
+			if (aosdl->device == 0) {
+				LOG_MOD_SUB_ERROR("sdl", "audio", "failed to reopen audio: %s\n", SDL_GetError());
+				goto failed;
+			}
+		}
+		ao->sound_interface->write_buffer = DELEGATE_AS1(voidp, voidp, ao_sdl2_write_buffer, ao);
 #ifndef HAVE_WASM
-	ao->sound_interface->write_silence = DELEGATE_AS1(voidp, voidp, ao_sdl2_write_silence, ao);
+		ao->sound_interface->write_silence = DELEGATE_AS1(voidp, voidp, ao_sdl2_write_silence, ao);
 #endif
+	}
 	LOG_DEBUG(1, "\t%u frags * %u frames/frag = %u frames buffer (%.1fms)\n", buf_nfragments, fragment_nframes, buffer_nframes, (float)(buffer_nframes * 1000) / rate);
 
 	SDL_PauseAudioDevice(aosdl->device, 0);
@@ -247,6 +270,8 @@ static void *new(void *cfg) {
 failed:
 	if (aosdl->device != 0)
 		SDL_CloseAudioDevice(aosdl->device);
+	if (ao->sound_interface)
+		sound_interface_free(ao->sound_interface);
 	if (aosdl->fragment_buffer)
 		free(aosdl->fragment_buffer);
 	free(aosdl);
@@ -273,6 +298,15 @@ static void ao_sdl2_free(void *sptr) {
 	free(aosdl);
 }
 
+#ifdef HAVE_SOUND_RING
+
+static void callback(void *userdata, Uint8 *stream, int len) {
+	struct ao_sdl2_interface *aosdl = userdata;
+	sound_ring_read(aosdl->public.sound_interface, stream, len / aosdl->frame_nbytes);
+}
+
+#endif
+
 static void *ao_sdl2_write_buffer(void *sptr, void *buffer) {
 	struct ao_sdl2_interface *aosdl = sptr;
 	(void)buffer;
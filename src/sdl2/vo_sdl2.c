@@ -145,6 +145,8 @@ bool sdl_vo_init(struct ui_sdl2_interface *uisdl2) {
 	}
 
 	struct vo_render *vr = vo_render_new(vo_cfg->pixel_fmt);
+	vo_render_set_threaded(vr, vo_cfg->render_thread);
+	vo_render_set_ntsc_lut(vr, vo_cfg->ntsc_lut_kib);
 
 	vo_set_renderer(vo, vr);
 
@@ -323,6 +325,8 @@ static void recreate_texture(struct ui_sdl2_interface *uisdl2) {
 	}
 
 	vr->buffer_pitch = vr->viewport.w;
+	// New texture needs all lines uploading
+	vo_render_set_dirty(vr);
 }
 
 // Update viewport based on requested dimensions and 60Hz scaling.
@@ -516,7 +520,15 @@ static void draw(void *sptr) {
 	struct vo_sdl_interface *vosdl = (struct vo_sdl_interface *)vo;
 	struct vo_render *vr = vo->renderer;
 
-	SDL_UpdateTexture(vosdl->texture.texture, NULL, vosdl->texture.pixels, vr->viewport.w * vosdl->texture.pixel_size);
+	// Upload only lines that have changed
+	int pitch = vr->viewport.w * vosdl->texture.pixel_size;
+	int y = 0, h;
+	while ((y = vo_render_next_dirty(vr, y, &h)) >= 0) {
+		SDL_Rect rect = { .x = 0, .y = y, .w = vr->viewport.w, .h = h };
+		SDL_UpdateTexture(vosdl->texture.texture, &rect, (uint8_t *)vosdl->texture.pixels + y * pitch, pitch);
+		y += h;
+	}
+	vo_render_clear_dirty(vr);
 	SDL_RenderClear(vosdl->sdl_renderer);
 	SDL_Rect dstrect = {
 		.x = vo->picture_area.x, .y = vo->picture_area.y,
@@ -651,7 +651,7 @@ void ser_write_struct_data(struct ser_handle *sh, const struct ser_struct_data *
 			break;
 
 		case ser_type_tick:
-			ser_write_vint32(sh, tag, *(event_ticks *)ptr - event_current_tick);
+			ser_write_vint32(sh, tag, event_tick_delta(*(event_ticks *)ptr, event_current_tick));
 			break;
 
 		case ser_type_event:
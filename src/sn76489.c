@@ -24,6 +24,7 @@
 
 #include "top-config.h"
 
+#include <limits.h>
 #include <stdint.h>
 #include <stdlib.h>
 
@@ -353,6 +354,98 @@ void sn76489_write(struct SN76489 *csg, uint32_t tick, uint8_t D) {
 	update_reg(csg_, reg_sel, reg_val);
 }
 
+// Each tone channel is a 10-bit down counter, reloaded from its frequency
+// register, and its output flips each time the counter expires.  The noise
+// channel shifts its 15-bit LFSR on each rising edge of either its own
+// fixed-rate square wave or tone 3's output.  Between expiries, then, every
+// channel's level is constant.
+//
+// sn76489_get_audio() therefore works in runs: it finds the fewest reference
+// ticks until a counter expires on a channel that can be heard, feeds the
+// summed level through the filter for that long, then calls advance() to bring
+// all four counters, the channel states and the LFSR up to date at once.
+// Channels that can't be heard are advanced too, so their state is the same as
+// if the chip had been stepped tick by tick.
+
+// No audible counter: the run is limited only by the ticks requested.
+
+#define NO_EVENT (UINT_MAX)
+
+// Ticks until a counter expires.  A zero counter (only from a bad snapshot)
+// wraps round on its next decrement, so is treated as never expiring.
+
+static unsigned counter_ticks(unsigned counter) {
+	return counter ? counter : NO_EVENT;
+}
+
+// Advance a counter by 'nticks', returning the number of times it expired.
+
+static unsigned counter_advance(unsigned *counter, unsigned period, unsigned nticks) {
+	if (*counter == 0 || nticks < *counter) {
+		*counter -= nticks;
+		return 0;
+	}
+	unsigned rem = nticks - *counter;
+	*counter = period - (rem % period);
+	return 1 + (rem / period);
+}
+
+// Advance all generators by 'nticks'.
+
+static void advance(struct SN76489_private *csg_, unsigned nticks) {
+	// noise is either clocked by independent frequency select, or
+	// by the output of tone generator 3.  input transition to high
+	// clocks the LFSR.
+	unsigned noise_nclocks = 0;
+
+	// tone generators 1, 2, 3
+	for (int c = 0; c < 3; c++) {
+		unsigned ntoggles = counter_advance(&csg_->counter[c], csg_->frequency[c], nticks);
+		if (ntoggles > 0) {
+			bool state = csg_->state[c] & 1;
+			if (c == 2 && csg_->noise_tone3) {
+				// noise channel clocked from tone3
+				noise_nclocks = (ntoggles + !state) / 2;
+			}
+			if (ntoggles & 1) {
+				state = !state;
+			}
+			csg_->state[c] = state;
+			csg_->level[c] = csg_->amplitude[c][state];
+		}
+	}
+
+	if (!csg_->noise_tone3) {
+		// noise channel clocked independently
+		unsigned ntoggles = counter_advance(&csg_->counter[3], csg_->frequency[3], nticks);
+		noise_nclocks = (ntoggles + !csg_->nstate) / 2;
+		if (ntoggles & 1) {
+			csg_->nstate = !csg_->nstate;
+		}
+	}
+
+	if (noise_nclocks > 0) {
+		unsigned lfsr = csg_->noise_lfsr;
+		for (unsigned i = 0; i < noise_nclocks; i++) {
+			lfsr = (lfsr >> 1) |
+			       ((unsigned)(csg_->noise_white
+					   ? u32_parity(lfsr & 0x0003)
+					   : (lfsr & 1)) << 14);
+		}
+		csg_->noise_lfsr = lfsr;
+		bool state = lfsr & 1;
+		csg_->state[3] = state;
+		csg_->level[3] = csg_->amplitude[3][state];
+	}
+}
+
+// True if a channel changing state can affect its output level.
+
+static bool is_audible(struct SN76489_private *csg_, int c) {
+	return csg_->amplitude[c][0] != csg_->amplitude[c][1] ||
+	       csg_->level[c] != csg_->amplitude[c][0];
+}
+
 float sn76489_get_audio(void *sptr, uint32_t tick, int nframes, float *buf) {
 	struct SN76489_private *csg_ = sptr;
 	struct SN76489 *csg = &csg_->public;
@@ -376,75 +469,93 @@ float sn76489_get_audio(void *sptr, uint32_t tick, int nframes, float *buf) {
 		csg_->overrun = 0;
 	}
 
+	// No writes arrive during this call, so which channels can be heard
+	// is fixed for its duration.  Noise clocked from tone 3 makes tone 3's
+	// counter matter even if tone 3 itself is silent.
+
+	bool audible[4];
+	for (int c = 0; c < 4; c++) {
+		audible[c] = is_audible(csg_, c);
+	}
+	if (audible[3]) {
+		if (csg_->noise_tone3) {
+			audible[2] = 1;
+		}
+	}
+
+	// The chip runs at a fraction of the system clock: track system
+	// ticks per reference tick as a whole part and a remainder
+	int dtick_base = csg_->tickrate / csg_->refrate;
+	int dtick_rem = csg_->tickrate % csg_->refrate;
+
 	while (nticks > 0) {
 
-		// framerate will *always* be less than refrate, so this is a
-		// simple test.  allow for 1 overrun sample.
-		csg_->frameerror += csg_->framerate;
-		if (csg_->frameerror >= csg_->refrate) {
-			csg_->frameerror -= csg_->refrate;
-			if (nframes > 0) {
-				if (buf) {
-					*(buf++) = output;
-				}
-				nframes--;
-			} else {
-				csg_->overrun = 1;
+		// Find number of ticks before an audible change
+		unsigned run = NO_EVENT;
+		for (int c = 0; c < 4; c++) {
+			if (audible[c] && !(c == 3 && csg_->noise_tone3)) {
+				unsigned t = counter_ticks(csg_->counter[c]) - 1;
+				if (t < run)
+					run = t;
 			}
 		}
 
-		// tickrate may be higher than refrate: calculate remainder.
-		csg_->tickerror += csg_->tickrate;
-		int dtick = csg_->tickerror / csg_->refrate;
-		if (dtick > 0) {
-			nticks -= dtick;
-			csg_->tickerror -= (dtick * csg_->refrate);
+		bool stepped = (run == 0);
+		if (stepped) {
+			// Change on the very next tick
+			run = 1;
+			advance(csg_, 1);
 		}
 
-		// noise is either clocked by independent frequency select, or
-		// by the output of tone generator 3
-		bool noise_clock = 0;
+		// sum the output channels
+		new_output = csg_->level[0] + csg_->level[1] +
+		             csg_->level[2] + csg_->level[3];
 
-		// tone generators 1, 2, 3
-		for (int c = 0; c < 3; c++) {
-			bool state = csg_->state[c] & 1;
-			if (--csg_->counter[c] == 0) {
-				state = !state;
-				csg_->counter[c] = csg_->frequency[c];
-				csg_->state[c] = state;
-				csg_->level[c] = csg_->amplitude[c][state];
-				if (c == 2 && csg_->noise_tone3) {
-					// noise channel clocked from tone3
-					noise_clock = state;
+		// The level is constant for the whole run, so the filter needs
+		// stepping only when a sample is due, and at the run's end.
+
+		unsigned nrun = 0;
+		int nfilter = 0;
+		while (nrun < run && nticks > 0) {
+
+			// framerate will *always* be less than refrate, so
+			// this is a simple test.  allow for 1 overrun sample.
+			csg_->frameerror += csg_->framerate;
+			if (csg_->frameerror >= csg_->refrate) {
+				csg_->frameerror -= csg_->refrate;
+				if (nfilter > 0) {
+					output = filter_iir_apply_n(csg_->filter, new_output, nfilter);
+					nfilter = 0;
+				}
+				if (nframes > 0) {
+					if (buf) {
+						*(buf++) = output;
+					}
+					nframes--;
+				} else {
+					csg_->overrun = 1;
 				}
 			}
-		}
 
-		if (!csg_->noise_tone3) {
-			// noise channel clocked independently
-			if (--csg_->counter[3] == 0) {
-				csg_->nstate = !csg_->nstate;
-				csg_->counter[3] = csg_->frequency[3];
-				noise_clock = csg_->nstate;
+			// tickrate may be higher than refrate: track
+			// remainder.
+			nticks -= dtick_base;
+			csg_->tickerror += dtick_rem;
+			if (csg_->tickerror >= csg_->refrate) {
+				csg_->tickerror -= csg_->refrate;
+				nticks--;
 			}
-		}
 
-		if (noise_clock) {
-			// input transition to high clocks the LFSR
-			csg_->noise_lfsr = (csg_->noise_lfsr >> 1) |
-			                   ((unsigned)(csg_->noise_white
-					     ? u32_parity(csg_->noise_lfsr & 0x0003)
-					     : (csg_->noise_lfsr & 1)) << 14);
-			bool state = csg_->noise_lfsr & 1;
-			csg_->state[3] = state;
-			csg_->level[3] = csg_->amplitude[3][state];
+			nfilter++;
+			nrun++;
+		}
+		if (nfilter > 0) {
+			output = filter_iir_apply_n(csg_->filter, new_output, nfilter);
 		}
 
-		// sum the output channels
-		new_output = csg_->level[0] + csg_->level[1] +
-		             csg_->level[2] + csg_->level[3];
-
-		output = filter_iir_apply(csg_->filter, new_output);
+		if (!stepped) {
+			advance(csg_, nrun);
+		}
 	}
 
 	csg_->nticks = nticks;
@@ -21,14 +21,30 @@
 
 #include "top-config.h"
 
+// for nanosleep
+#define _POSIX_C_SOURCE 200112L
+
 #include <assert.h>
 #include <math.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
+#ifdef HAVE_SOUND_RING
+#include <errno.h>
+#include <stdatomic.h>
+#include <time.h>
+#endif
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 #include "delegate.h"
 #include "pl-endian.h"
+#include "simd.h"
 #include "xalloc.h"
 
 #include "events.h"
@@ -39,8 +55,32 @@
 #include "tape.h"
 #include "xroar.h"
 
+#ifndef M_PI
+# define M_PI 3.14159265358979323846
+#endif
+
 static void flush_buffer(void *sptr);
 
+// Band-limited step synthesis.  Level changes from the DAC and single-bit
+// sound are piecewise constant, and may occur at any point between output
+// frames.  Rather than step the output on the next frame boundary (which
+// aliases badly at typical output rates), each change inserts a windowed-sinc
+// step, positioned to sub-frame accuracy.  Output is delayed by half the
+// kernel width.
+
+// Kernel width in frames.  Output is delayed by half this.
+#define BLEP_NTAPS (16)
+
+// Sub-frame resolution of step positions.
+#define BLEP_NPHASES (32)
+
+// Per-frame increments of a band-limited unit step, indexed by phase.  Each
+// row sums to 1.
+static float blep_table[BLEP_NPHASES+1][BLEP_NTAPS+1];
+static bool blep_table_ready = 0;
+
+struct sound_ring;
+
 struct sound_interface_private {
 
 	struct sound_interface public;
@@ -51,11 +91,16 @@ struct sound_interface_private {
 	// Describes the mix & output buffers:
 	unsigned buffer_nframes;
 	float *mix_buffer;  // mix buffer
+	float *mono_buffer;  // mono mix prior to gain & channel expansion
 	int output_nchannels;
 	enum sound_fmt output_fmt;
 	void *output_buffer;  // final output may not be floats
 	bool output_buffer_is_silent;
 
+	// If not NULL, mixed buffers are queued here instead of being
+	// converted and passed to write_buffer.
+	struct sound_ring *ring;
+
 	// Current index into the buffer
 	unsigned buffer_frame;
 
@@ -106,6 +151,15 @@ struct sound_interface_private {
 	// set_volume().  Defaults to -3 dBFS.
 	float gain;
 
+	// Band-limited step synthesis state
+	struct {
+		bool enabled;
+		float *delta;  // pending step increments, indexed by frame
+		float level;  // target level after all pending steps
+		float acc;  // current level, accumulated from delta[]
+		unsigned nactive;  // frames until delta[] is clear
+	} blep;
+
 };
 
 enum sound_source {
@@ -155,6 +209,9 @@ static const float source_offset_v[NUM_SOURCES][3] = {
 };
 
 static void sound_ui_set_gain(void *, int tag, void *smsg);
+static void blep_init_table(void);
+static void ring_write(struct sound_interface_private *snd);
+static void ring_free(struct sound_interface_private *snd);
 
 struct sound_interface *sound_interface_new(void *buf, enum sound_fmt fmt, unsigned rate,
 					    unsigned nchannels, unsigned nframes) {
@@ -237,6 +294,7 @@ struct sound_interface *sound_interface_new(void *buf, enum sound_fmt fmt, unsig
 		// Otherwise we need a staging area to mix float data.
 		snd->mix_buffer = xmalloc(nframes * nchannels * sizeof(float));
 	}
+	snd->mono_buffer = xmalloc(nframes * sizeof(float));
 	snd->buffer_nframes = nframes;
 	snd->output_fmt = fmt;
 	snd->output_nchannels = nchannels;
@@ -254,6 +312,12 @@ struct sound_interface *sound_interface_new(void *buf, enum sound_fmt fmt, unsig
 		snd->non_muxed_output[j] = 0.0;
 	}
 
+	snd->blep.enabled = xroar.cfg.ao.blep;
+	if (snd->blep.enabled) {
+		blep_init_table();
+		snd->blep.delta = xzalloc((nframes + BLEP_NTAPS + 1) * sizeof(float));
+	}
+
 	snd->last_cycle = event_current_tick;
 
 	event_init(&snd->flush_event, MACHINE_EVENT_LIST, DELEGATE_AS0(void, flush_buffer, snd));
@@ -268,59 +332,206 @@ void sound_interface_free(struct sound_interface *sndp) {
 	struct sound_interface_private *snd = (struct sound_interface_private *)sndp;
 	messenger_client_unregister(snd->msgr_client_id);
 	event_dequeue(&snd->flush_event);
-	if (snd->output_fmt != SOUND_FMT_FLOAT) {
+	if (snd->output_fmt != SOUND_FMT_FLOAT || snd->ring) {
 		free(snd->mix_buffer);
 	}
+	ring_free(snd);
 	free(snd->non_muxed_output);
 	for (unsigned i = 0; i < 5; i++) {
 		free(snd->mux_input[i]);
 	}
+	free(snd->blep.delta);
+	free(snd->mono_buffer);
 	free(snd);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+// Mixing and sample format conversion.  These are kept as simple loops over
+// contiguous arrays, built as kernels (see simd.h).  Float to 16-bit
+// conversion, the most common case, is explicitly vectorised where SSE2 or
+// NEON are available.  All conversions saturate, as gain can be > 1.0.
+
+// Shares the kernels' optimisation options so that once inlined it can be
+// turned into min/max rather than branches.
+
+static inline SIMD_KERNEL_OPTIMIZE float clamp_sample(float v) {
+	return (v < -1.0f) ? -1.0f : ((v > 1.0f) ? 1.0f : v);
+}
+
+SIMD_KERNEL void convert_u8(uint8_t *dst, const float *src, int nsamples) {
+	for (int i = 0; i < nsamples; i++) {
+		dst[i] = (uint8_t)(clamp_sample(src[i]) * 0x7f + 0x80);
+	}
+}
+
+SIMD_KERNEL void convert_s8(int8_t *dst, const float *src, int nsamples) {
+	for (int i = 0; i < nsamples; i++) {
+		dst[i] = (int8_t)(clamp_sample(src[i]) * 0x7f);
+	}
+}
+
+static void convert_s16(int16_t *dst, const float *src, int nsamples) {
+	int i = 0;
+#if defined(__SSE2__)
+	const __m128 lo = _mm_set1_ps(-1.0f);
+	const __m128 hi = _mm_set1_ps(1.0f);
+	const __m128 scale = _mm_set1_ps(0x7fff);
+	for ( ; i + 8 <= nsamples; i += 8) {
+		__m128 a = _mm_loadu_ps(src + i);
+		__m128 b = _mm_loadu_ps(src + i + 4);
+		a = _mm_mul_ps(_mm_min_ps(_mm_max_ps(a, lo), hi), scale);
+		b = _mm_mul_ps(_mm_min_ps(_mm_max_ps(b, lo), hi), scale);
+		__m128i v = _mm_packs_epi32(_mm_cvttps_epi32(a), _mm_cvttps_epi32(b));
+		_mm_storeu_si128((__m128i *)(dst + i), v);
+	}
+#elif defined(__ARM_NEON)
+	const float32x4_t lo = vdupq_n_f32(-1.0f);
+	const float32x4_t hi = vdupq_n_f32(1.0f);
+	for ( ; i + 8 <= nsamples; i += 8) {
+		float32x4_t a = vld1q_f32(src + i);
+		float32x4_t b = vld1q_f32(src + i + 4);
+		a = vmulq_n_f32(vminq_f32(vmaxq_f32(a, lo), hi), 0x7fff);
+		b = vmulq_n_f32(vminq_f32(vmaxq_f32(b, lo), hi), 0x7fff);
+		int16x8_t v = vcombine_s16(vqmovn_s32(vcvtq_s32_f32(a)), vqmovn_s32(vcvtq_s32_f32(b)));
+		vst1q_s16(dst + i, v);
+	}
+#endif
+	for ( ; i < nsamples; i++) {
+		dst[i] = (int16_t)(clamp_sample(src[i]) * 0x7fff);
+	}
+}
+
+SIMD_KERNEL void swap_s16(uint16_t *buf, int nsamples) {
+	for (int i = 0; i < nsamples; i++) {
+		buf[i] = (uint16_t)((buf[i] << 8) | (buf[i] >> 8));
+	}
+}
+
+// Mix 'count' frames into the output buffer at the current position.  The
+// mono mix is built up a source at a time in mono_buffer, then has external
+// audio and overall gain applied as it's expanded to the output channels.
+// Stepped sources are always processed, even if not 'mixing', so that their
+// state remains current.
+
+SIMD_KERNEL void mix_frames(struct sound_interface_private *snd, int count, bool mixing,
+			     const float *mux_output, const float *non_muxed_output) {
+	float *mono = snd->mono_buffer;
+
+	if (snd->blep.enabled) {
+		// Integrate any pending step increments
+		float *delta = snd->blep.delta + snd->buffer_frame;
+		int nblep = ((int)snd->blep.nactive < count) ? (int)snd->blep.nactive : count;
+		float acc = snd->blep.acc;
+		for (int i = 0; i < nblep; i++) {
+			acc += delta[i];
+			delta[i] = 0.0;
+			mono[i] = acc;
+		}
+		snd->blep.nactive -= nblep;
+		if (nblep > 0 && snd->blep.nactive == 0) {
+			// Steps complete: avoid accumulating rounding errors.
+			acc = snd->blep.level;
+			mono[nblep-1] = acc;
+		}
+		snd->blep.acc = acc;
+		if (!mixing)
+			return;
+		for (int i = nblep; i < count; i++) {
+			mono[i] = acc;
+		}
+		if (mux_output) {
+			float mux_gain = snd->mux_gain;
+			for (int i = 0; i < count; i++) {
+				mono[i] += mux_output[i] * mux_gain;
+			}
+		}
+	} else {
+		if (!mixing)
+			return;
+		float mux_gain = snd->mux_gain;
+		float bus_offset = snd->bus_offset;
+		if (mux_output) {
+			for (int i = 0; i < count; i++) {
+				mono[i] = (mux_output[i] * mux_gain) + bus_offset;
+			}
+		} else {
+			for (int i = 0; i < count; i++) {
+				mono[i] = bus_offset;
+			}
+		}
+	}
+
+	if (non_muxed_output) {
+		for (int i = 0; i < count; i++) {
+			mono[i] += non_muxed_output[i];
+		}
+	}
+
+	float gain = snd->gain;
+	float *ptr = snd->mix_buffer + snd->buffer_frame * snd->output_nchannels;
+	if (snd->output_nchannels == 1) {
+		float external = snd->current.external[0];
+		for (int i = 0; i < count; i++) {
+			ptr[i] = (mono[i] + external) * gain;
+		}
+	} else {
+		float external0 = snd->current.external[0];
+		float external1 = snd->current.external[1];
+		for (int i = 0; i < count; i++) {
+			ptr[i*2] = (mono[i] + external0) * gain;
+			ptr[i*2+1] = (mono[i] + external1) * gain;
+		}
+	}
+}
+
 // convert buffer to desired output format and send it to audio module
 static void send_buffer(struct sound_interface_private *snd) {
 	int nsamples = snd->output_nchannels * snd->buffer_nframes;
-	if (snd->output_buffer && snd->mix_buffer) {
-		float *input = snd->mix_buffer;
+	if (snd->mix_buffer) {
+		DELEGATE_SAFE_CALL(snd->public.capture, snd->buffer_nframes, snd->output_nchannels, snd->mix_buffer);
+	}
+	if (snd->ring) {
+		ring_write(snd);
+	} else if (snd->output_buffer && snd->mix_buffer) {
 		switch (snd->output_fmt) {
-		case SOUND_FMT_U8: {
-			int8_t *output = snd->output_buffer;
-			for (int i = nsamples; i; i--)
-				*(output++) = *(input++) * 0x7f + 0x80;
-		} break;
-		case SOUND_FMT_S8: {
-			uint8_t *output = snd->output_buffer;
-			for (int i = nsamples; i; i--)
-				*(output++) = *(input++) * 0x7f;
-		} break;
-		case SOUND_FMT_S16_HE: {
-			int16_t *output = snd->output_buffer;
-			for (int i = nsamples; i; i--)
-				*(output++) = *(input++) * 0x7fff;
-		} break;
-		case SOUND_FMT_S16_SE: {
-			uint8_t *output = snd->output_buffer;
-			for (int i = nsamples; i; i--) {
-				int16_t v = *(input++) * 0x7fff;
-				*(output++) = *((uint8_t *)&v+1);
-				*(output++) = *(uint8_t *)&v;
-			}
-		} break;
-		case SOUND_FMT_FLOAT: {
+		case SOUND_FMT_U8:
+			convert_u8(snd->output_buffer, snd->mix_buffer, nsamples);
+			break;
+		case SOUND_FMT_S8:
+			convert_s8(snd->output_buffer, snd->mix_buffer, nsamples);
+			break;
+		case SOUND_FMT_S16_HE:
+			convert_s16(snd->output_buffer, snd->mix_buffer, nsamples);
+			break;
+		case SOUND_FMT_S16_SE:
+			convert_s16(snd->output_buffer, snd->mix_buffer, nsamples);
+			swap_s16(snd->output_buffer, nsamples);
+			break;
+		case SOUND_FMT_FLOAT:
 			// For float, mix buffer is pointed directly to output
 			// buffer, as no conversion is necessary.
-		} break;
+			break;
 		default:
 			break;
 		}
 	}
-	snd->output_buffer = DELEGATE_CALL(snd->public.write_buffer, snd->output_buffer);
-	if (snd->output_fmt == SOUND_FMT_FLOAT) {
-		// No need to convert floats, point mix buffer at output buffer.
-		snd->mix_buffer = snd->output_buffer;
+	if (!snd->ring) {
+		snd->output_buffer = DELEGATE_CALL(snd->public.write_buffer, snd->output_buffer);
+		if (snd->output_fmt == SOUND_FMT_FLOAT) {
+			// No need to convert floats, point mix buffer at
+			// output buffer.
+			snd->mix_buffer = snd->output_buffer;
+		}
+	}
+	if (snd->blep.nactive > 0) {
+		// Move pending step increments to start of next buffer
+		float *delta = snd->blep.delta;
+		unsigned nframes = snd->buffer_nframes;
+		for (unsigned i = 0; i <= BLEP_NTAPS; i++) {
+			delta[i] = delta[nframes + i];
+			delta[nframes + i] = 0.0;
+		}
 	}
 	snd->buffer_frame = 0;
 }
@@ -369,9 +580,361 @@ void sound_send_silence(struct sound_interface *sndp) {
 		// No need to convert floats, point mix buffer at output buffer.
 		snd->mix_buffer = snd->output_buffer;
 	}
+	if (snd->blep.nactive > 0) {
+		// Any steps in progress are lost with the buffer
+		for (unsigned i = 0; i < snd->buffer_nframes + BLEP_NTAPS + 1; i++) {
+			snd->blep.delta[i] = 0.0;
+		}
+		snd->blep.acc = snd->blep.level;
+		snd->blep.nactive = 0;
+	}
 	snd->buffer_frame = 0;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+// Audio ring.  The emulator thread is the only writer and the device thread
+// the only reader, so the only shared state is a pair of free-running frame
+// counters.
+//
+// When rate limiting, the emulator waits for the ring to drain to the target
+// latency before queueing each buffer.  The device thread reads at a rate
+// adjusted by up to RING_MAX_DEVIATION according to how far the (smoothed)
+// fill level has drifted from where it should sit, interpolating between
+// frames.  This absorbs small differences between the emulated and device
+// clocks without underruns or creeping latency.
+
+#ifdef HAVE_SOUND_RING
+
+// Maximum deviation of read rate from nominal.
+#define RING_MAX_DEVIATION (0.005)
+
+// Weight given to each new fill level measurement.
+#define RING_FILL_WEIGHT (0.05)
+
+// Frames converted to output format at a time by the reader.
+#define RING_CHUNK_NFRAMES (256)
+
+struct sound_ring {
+	// Interleaved float frames.  Size is a power of two.
+	float *data;
+	unsigned nframes;
+
+	// Frames written (only updated by the emulator thread) and frames read
+	// (only updated by the device thread).
+	atomic_uint head;
+	atomic_uint tail;
+
+	// Emulator waits while fill level exceeds target.  Setpoint is the
+	// resulting average fill level, which rate control aims for.
+	unsigned target_nframes;
+	double setpoint;
+
+	// Longest the emulator will wait for space.
+	unsigned timeout_ms;
+
+	// Device thread state
+	double fill;  // smoothed fill level
+	double frac;  // read position between frame at tail and the next
+	float last[2];  // last frame read, repeated on underrun
+	bool starved;
+
+	// Each counter is only updated by one thread.  Underruns are counted
+	// once per period of starvation.
+	unsigned nunderruns;
+	unsigned noverruns;
+};
+
+static void ring_sleep_ms(unsigned ms) {
+	struct timespec elapsed, tv;
+	elapsed.tv_sec = ms / 1000;
+	elapsed.tv_nsec = (ms % 1000) * 1000000;
+	do {
+		errno = 0;
+		tv.tv_sec = elapsed.tv_sec;
+		tv.tv_nsec = elapsed.tv_nsec;
+	} while (nanosleep(&tv, &elapsed) && errno == EINTR);
+}
+
+bool sound_ring_enable(struct sound_interface *sndp) {
+	struct sound_interface_private *snd = (struct sound_interface_private *)sndp;
+	if (snd->ring)
+		return 1;
+	if (snd->output_fmt == SOUND_FMT_NULL)
+		return 0;
+
+	unsigned target_nframes = 2 * snd->buffer_nframes;
+	if (xroar.cfg.ao.latency_ms > 0) {
+		target_nframes = ((uint64_t)sndp->framerate * xroar.cfg.ao.latency_ms) / 1000;
+	}
+
+	// Leave plenty of room for the reader to fall behind
+	unsigned nframes = 256;
+	while (nframes < 2 * (target_nframes + snd->buffer_nframes))
+		nframes <<= 1;
+
+	struct sound_ring *ring = xzalloc(sizeof(*ring));
+	ring->data = xzalloc(nframes * snd->output_nchannels * sizeof(float));
+	ring->nframes = nframes;
+	atomic_init(&ring->head, 0);
+	atomic_init(&ring->tail, 0);
+	ring->target_nframes = target_nframes;
+	ring->setpoint = target_nframes + snd->buffer_nframes / 2.0;
+	ring->timeout_ms = ((uint64_t)nframes * 1000) / sndp->framerate + 1;
+	ring->fill = ring->setpoint;
+	ring->starved = 1;
+
+	// Ring takes the place of the output buffer.  Floats were previously
+	// mixed straight into the output buffer, so need their own mix buffer.
+	if (snd->output_fmt == SOUND_FMT_FLOAT) {
+		snd->mix_buffer = xmalloc(snd->buffer_nframes * snd->output_nchannels * sizeof(float));
+	}
+	snd->output_buffer = NULL;
+	snd->ring = ring;
+
+	LOG_DEBUG(1, "\tring: %u frames, target latency %u frames (%.1fms)\n", nframes, target_nframes, (float)(target_nframes * 1000) / sndp->framerate);
+	return 1;
+}
+
+static void ring_free(struct sound_interface_private *snd) {
+	struct sound_ring *ring = snd->ring;
+	if (!ring)
+		return;
+	LOG_MOD_DEBUG(2, "sound", "ring: %u underruns, %u overruns\n", ring->nunderruns, ring->noverruns);
+	free(ring->data);
+	free(ring);
+	snd->ring = NULL;
+}
+
+// Queue a full mix buffer.  If rate limiting, waits until the device has
+// caught up.  Data that doesn't fit is dropped.
+
+static void ring_write(struct sound_interface_private *snd) {
+	struct sound_ring *ring = snd->ring;
+	unsigned nframes = snd->buffer_nframes;
+	unsigned nchannels = snd->output_nchannels;
+	unsigned head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+	unsigned tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+
+	if (snd->public.ratelimit) {
+		unsigned waited_ms = 0;
+		while ((head - tail) > ring->target_nframes && waited_ms < ring->timeout_ms) {
+			// Sleep for about as long as the excess takes to play
+			unsigned ms = ((head - tail - ring->target_nframes) * 1000) / snd->public.framerate;
+			if (ms < 1)
+				ms = 1;
+			ring_sleep_ms(ms);
+			waited_ms += ms;
+			tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+		}
+	}
+
+	if ((ring->nframes - (head - tail)) < nframes) {
+		// Not an overrun if we weren't trying to keep up
+		if (snd->public.ratelimit)
+			ring->noverruns++;
+		return;
+	}
+
+	unsigned index = head & (ring->nframes - 1);
+	unsigned count = ring->nframes - index;
+	if (count > nframes)
+		count = nframes;
+	memcpy(ring->data + index * nchannels, snd->mix_buffer, count * nchannels * sizeof(float));
+	if (count < nframes) {
+		memcpy(ring->data, snd->mix_buffer + count * nchannels, (nframes - count) * nchannels * sizeof(float));
+	}
+	atomic_store_explicit(&ring->head, head + nframes, memory_order_release);
+}
+
+// Called from the device thread.
+
+void sound_ring_read(struct sound_interface *sndp, void *buf, unsigned nframes) {
+	struct sound_interface_private *snd = (struct sound_interface_private *)sndp;
+	struct sound_ring *ring = snd->ring;
+	unsigned nchannels = snd->output_nchannels;
+	unsigned mask = ring->nframes - 1;
+	unsigned head = atomic_load_explicit(&ring->head, memory_order_acquire);
+	unsigned tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+	unsigned fill = head - tail;
+
+	// Rate control.  Read faster if the ring is fuller than it should be,
+	// slower if it's emptier.
+	ring->fill += ((double)fill - ring->fill) * RING_FILL_WEIGHT;
+	double error = (ring->fill - ring->setpoint) / ring->setpoint;
+	if (error < -1.0)
+		error = -1.0;
+	else if (error > 1.0)
+		error = 1.0;
+	double step = 1.0 + error * RING_MAX_DEVIATION;
+
+	size_t frame_nbytes;
+	switch (snd->output_fmt) {
+	case SOUND_FMT_U8:
+	case SOUND_FMT_S8:
+		frame_nbytes = nchannels;
+		break;
+	case SOUND_FMT_S16_HE:
+	case SOUND_FMT_S16_SE:
+		frame_nbytes = nchannels * sizeof(int16_t);
+		break;
+	default:
+		frame_nbytes = nchannels * sizeof(float);
+		break;
+	}
+
+	float chunk[RING_CHUNK_NFRAMES * 2];
+	uint8_t *dst = buf;
+	while (nframes > 0) {
+		unsigned count = (nframes < RING_CHUNK_NFRAMES) ? nframes : RING_CHUNK_NFRAMES;
+		float *out = (snd->output_fmt == SOUND_FMT_FLOAT) ? (float *)dst : chunk;
+
+		for (unsigned i = 0; i < count; i++) {
+			if (fill < 2) {
+				// Underrun: hold last value
+				if (!ring->starved) {
+					ring->nunderruns++;
+					ring->starved = 1;
+				}
+				for (unsigned c = 0; c < nchannels; c++) {
+					*(out++) = ring->last[c];
+				}
+				continue;
+			}
+			ring->starved = 0;
+			const float *f0 = ring->data + (tail & mask) * nchannels;
+			const float *f1 = ring->data + ((tail + 1) & mask) * nchannels;
+			float frac = ring->frac;
+			for (unsigned c = 0; c < nchannels; c++) {
+				float v = f0[c] + (f1[c] - f0[c]) * frac;
+				ring->last[c] = v;
+				*(out++) = v;
+			}
+			ring->frac += step;
+			while (ring->frac >= 1.0 && fill > 1) {
+				ring->frac -= 1.0;
+				tail++;
+				fill--;
+			}
+		}
+
+		int nsamples = count * nchannels;
+		switch (snd->output_fmt) {
+		case SOUND_FMT_U8:
+			convert_u8((uint8_t *)dst, chunk, nsamples);
+			break;
+		case SOUND_FMT_S8:
+			convert_s8((int8_t *)dst, chunk, nsamples);
+			break;
+		case SOUND_FMT_S16_HE:
+			convert_s16((int16_t *)dst, chunk, nsamples);
+			break;
+		case SOUND_FMT_S16_SE:
+			convert_s16((int16_t *)dst, chunk, nsamples);
+			swap_s16((uint16_t *)dst, nsamples);
+			break;
+		default:
+			break;
+		}
+		dst += count * frame_nbytes;
+		nframes -= count;
+	}
+
+	atomic_store_explicit(&ring->tail, tail, memory_order_release);
+}
+
+#else
+
+bool sound_ring_enable(struct sound_interface *sndp) {
+	(void)sndp;
+	return 0;
+}
+
+void sound_ring_read(struct sound_interface *sndp, void *buf, unsigned nframes) {
+	(void)sndp;
+	(void)buf;
+	(void)nframes;
+}
+
+static void ring_free(struct sound_interface_private *snd) {
+	(void)snd;
+}
+
+static void ring_write(struct sound_interface_private *snd) {
+	(void)snd;
+}
+
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+// Band-limited step synthesis
+
+// Windowed sinc, cutoff just below Nyquist, Blackman window spanning the
+// kernel.  'x' is in frames relative to the step.
+
+static double blep_impulse(double x) {
+	const double fc = 0.45;
+	const double half = BLEP_NTAPS / 2;
+	if (x <= -half || x >= half)
+		return 0.0;
+	double sinc = (x == 0.0) ? 1.0 : sin(M_PI * 2.0 * fc * x) / (M_PI * 2.0 * fc * x);
+	double w = (x + half) / BLEP_NTAPS;
+	double window = 0.42 - 0.5 * cos(2.0 * M_PI * w) + 0.08 * cos(4.0 * M_PI * w);
+	return 2.0 * fc * sinc * window;
+}
+
+// Each table row covers the frames following a step that occurred 'phase'
+// sub-frames after a frame boundary.  Entry k is the increase in level at the
+// k'th frame after that boundary, integrated numerically from the impulse.
+
+static void blep_init_table(void) {
+	if (blep_table_ready)
+		return;
+	const int nsteps = 64;
+	const double half = BLEP_NTAPS / 2;
+	for (int phase = 0; phase <= BLEP_NPHASES; phase++) {
+		double frac = (double)phase / BLEP_NPHASES;
+		double sum = 0.0;
+		double row[BLEP_NTAPS+1];
+		for (int k = 0; k <= BLEP_NTAPS; k++) {
+			// Frame k+1 after the boundary shows the step as it
+			// was at time (k+1 - half - frac) relative to it.
+			double x1 = (k + 1) - half - frac;
+			double x0 = x1 - 1.0;
+			double area = 0.0;
+			for (int i = 0; i < nsteps; i++) {
+				area += blep_impulse(x0 + (i + 0.5) / nsteps);
+			}
+			row[k] = area / nsteps;
+			sum += row[k];
+		}
+		for (int k = 0; k <= BLEP_NTAPS; k++) {
+			blep_table[phase][k] = row[k] / sum;
+		}
+	}
+	blep_table_ready = 1;
+}
+
+// Insert a step to 'level' at the current time.  The next frame to be written
+// is buffer_frame, and frameerror tracks how far we are past the previous
+// frame boundary.
+
+static void blep_step(struct sound_interface_private *snd, float level) {
+	if (level == snd->blep.level)
+		return;
+	float delta = level - snd->blep.level;
+	snd->blep.level = level;
+	int64_t fe = (int64_t)snd->frameerror * BLEP_NPHASES + EVENT_TICK_RATE / 2;
+	unsigned phase = fe / EVENT_TICK_RATE;
+	const float *table = blep_table[phase];
+	float *dst = snd->blep.delta + snd->buffer_frame;
+	for (int k = 0; k <= BLEP_NTAPS; k++) {
+		dst[k] += delta * table[k];
+	}
+	snd->blep.nactive = BLEP_NTAPS + 1;
+}
+
 // Fill sound buffer to current point in time, sending to audio module when full.
 
 void sound_update(struct sound_interface *sndp) {
@@ -449,6 +1012,13 @@ void sound_update(struct sound_interface *sndp) {
 		DELEGATE_CALL(sndp->get_non_muxed_audio, event_current_tick, nframes, non_muxed_output);
 	}
 
+	// With band-limited step synthesis, DAC & single-bit levels are
+	// handled entirely as steps, so only sampled sources go through the
+	// mux buffer.
+	if (snd->blep.enabled && mux_source == SOURCE_DAC) {
+		mux_source = SOURCE_NONE;
+	}
+
 	// Only fill DAC buffer if it's selected
 	if (mux_source == SOURCE_DAC) {
 		for (unsigned i = 0; i < nframes; i++) {
@@ -460,6 +1030,10 @@ void sound_update(struct sound_interface *sndp) {
 	// Select appropriate mux output, or none
 	float *mux_output = snd->mux_input[mux_source];
 
+	// Mix if there's somewhere for it to go.  Capture may want the mix
+	// even when the audio module has no output buffer.
+	bool mixing = snd->mix_buffer && (snd->output_buffer || snd->ring || DELEGATE_DEFINED(sndp->capture));
+
 	// Mix audio, send when buffer full
 	while (nframes > 0) {
 		int count;
@@ -468,17 +1042,13 @@ void sound_update(struct sound_interface *sndp) {
 		else
 			count = nframes;
 		nframes -= count;
-		if (snd->output_buffer && snd->mix_buffer) {
-			float *ptr = (float *)snd->mix_buffer + snd->buffer_frame * snd->output_nchannels;
-			for (int i = 0; i < count; i++) {
-				float mix_sample = (*(mux_output++) * snd->mux_gain) + snd->bus_offset;
-				if (non_muxed_output) {
-					mix_sample += *(non_muxed_output++);
-				}
-				for (int j = 0; j < snd->output_nchannels; j++) {
-					*(ptr++) = (mix_sample + snd->current.external[j]) * snd->gain;
-				}
-			}
+		mix_frames(snd, count, mixing,
+			   (mux_source != SOURCE_NONE) ? mux_output : NULL, non_muxed_output);
+		if (mux_source != SOURCE_NONE) {
+			mux_output += count;
+		}
+		if (non_muxed_output) {
+			non_muxed_output += count;
 		}
 		snd->buffer_frame += count;
 		if (snd->buffer_frame >= snd->buffer_nframes) {
@@ -526,6 +1096,15 @@ void sound_update(struct sound_interface *sndp) {
 	snd->bus_level = (mux_output_raw * snd->mux_gain) + snd->bus_offset;
 	DELEGATE_SAFE_CALL(snd->public.sbs_feedback, snd->current.sbs_enabled || snd->bus_level >= 0.3);
 
+	// Stepped part of the output: DAC (if selected) and DC offset.
+	if (snd->blep.enabled) {
+		if (snd->current.mux_enabled && snd->current.mux_source == SOURCE_DAC) {
+			blep_step(snd, (snd->mux_input_raw[SOURCE_DAC] * snd->mux_gain) + snd->bus_offset);
+		} else {
+			blep_step(snd, snd->bus_offset);
+		}
+	}
+
 }
 
 // Rate limit control
@@ -45,6 +45,9 @@ struct sound_interface {
 	DELEGATE_T3(float, uint32, int, floatp) get_ay_audio;
 	DELEGATE_T1(voidp, voidp) write_buffer;
 	DELEGATE_T1(voidp, voidp) write_silence;
+	// Optional hook passed each buffer of mixed audio before conversion to
+	// the output format: nframes, nchannels, interleaved float data.
+	DELEGATE_T3(void, int, int, cvoidp) capture;
 };
 
 struct sound_interface *sound_interface_new(void *buf, enum sound_fmt fmt, unsigned rate,
@@ -54,6 +57,18 @@ void sound_interface_free(struct sound_interface *sndp);
 void sound_update(struct sound_interface *sndp);
 void sound_send_silence(struct sound_interface *);
 
+// Audio ring.  An audio module whose device is serviced from another thread
+// (a callback, or a thread making blocking writes) may call sound_ring_enable()
+// after creating the interface.  Completed buffers are then queued in a
+// lock-free single-producer, single-consumer ring instead of being passed to
+// write_buffer, and the device thread calls sound_ring_read() to fetch
+// 'nframes' frames in the output format.  Returns false if the ring is not
+// supported by this build.  The device thread must be stopped before calling
+// sound_interface_free().
+
+bool sound_ring_enable(struct sound_interface *sndp);
+void sound_ring_read(struct sound_interface *sndp, void *buf, unsigned nframes);
+
 // Rate limit control
 void sound_set_ratelimit(struct sound_interface *sndp, bool ratelimit);
 
@@ -55,13 +55,24 @@
 
 struct ser_handle;
 
-enum vdg_render_mode {
-	TCC1014_RENDER_SG,
-	TCC1014_RENDER_CG,
-	TCC1014_RENDER_RG,
-	TCC1014_RENDER_RG2,
+// Each byte of video data is rendered as eight colour "slots", which are
+// then scaled to the current horizontal resolution.  How data maps to slots
+// depends on the mode, and is tabulated per data byte.  Slots contain an
+// index into a per-byte colour map: foreground/background for two-colour
+// modes, else an offset into the palette.
+
+enum gime_slots {
+	GIME_SLOTS_1BPP,  // 1 bit per pixel, 8 pixels
+	GIME_SLOTS_2BPP,  // 2 bits per pixel, 4 pixels
+	GIME_SLOTS_4BPP,  // 4 bits per pixel, 2 pixels
+	GIME_SLOTS_RG2,   // even bits only, 4 pixels
+	GIME_SLOTS_SG,    // lowest 2 bits only, 2 pixels
+	GIME_NUM_SLOTS
 };
 
+static uint8_t slot_index[GIME_NUM_SLOTS][256][8];
+static bool have_slot_index = 0;
+
 // GIME variant constants
 //
 // The horizontal timings vary significantly between the '86 and '87 GIMEs.
@@ -294,6 +305,11 @@ struct TCC1014_private {
 	bool have_vdata_cache;
 	uint8_t vdata_cache;
 
+	// Video data fetched in bulk for the current render_scanline() call
+	uint16_t vram_buf[96];
+	unsigned vram_buf_index;
+	unsigned vram_buf_nwords;
+
 	// Unsafe warning: pixel_data[] *may* need to be 16 elements longer
 	// than a full scanline.  16 is the maximum number of elements rendered
 	// in render_scanline() between index checks.
@@ -513,6 +529,7 @@ static void do_vb_irq(void *);
 static void do_update_timer(void *);
 
 // Render scanline to specified point in time
+static void init_slot_index(void);
 static void render_scanline(struct TCC1014_private *gime, event_ticks t);
 
 // Timer handling
@@ -586,6 +603,8 @@ static struct part *tcc1014_allocate(void) {
 	gime->public.debug.part.get_register_composite = DELEGATE_AS3(int, int, unsigned, uint8p, tcc1014_get_register_composite, gime);
 	gime->public.debug.part.set_register_composite = DELEGATE_AS3(int, int, unsigned, cuint8p, tcc1014_set_register_composite, gime);
 
+	init_slot_index();
+
 	return p;
 }
 
@@ -830,6 +849,38 @@ void tcc1014_mem_cycle(void *sptr, bool RnW, uint16_t A) {
 
 }
 
+// Duration of one CPU cycle at the current rate.
+
+unsigned tcc1014_cycle_ticks(struct TCC1014 *gimep) {
+	struct TCC1014_private *gime = (struct TCC1014_private *)gimep;
+	return gime->R1 ? 8 : 16;
+}
+
+// True if no rising edge on IL0-IL2 awaits detection by the next CPU cycle.
+
+bool tcc1014_il_settled(struct TCC1014 *gimep) {
+	struct TCC1014_private *gime = (struct TCC1014_private *)gimep;
+	return !(gimep->IL0 && !gime->IL0_state) &&
+	       !(gimep->IL1 && !gime->IL1_state) &&
+	       !(gimep->IL2 && !gime->IL2_state);
+}
+
+// If a CPU access to A (below the CRM page) would go only to RAM, sets *Z to
+// the RAM address and returns true.  Used to find plain RAM for bulk
+// transfers.
+
+bool tcc1014_decode_ram(struct TCC1014 *gimep, uint16_t A, unsigned *Z) {
+	struct TCC1014_private *gime = (struct TCC1014_private *)gimep;
+	if (A >= 0xfe00)
+		return 0;
+	unsigned bank = gime->MMUEN ? gime->mmu_bank[gime->TR | (A >> 13)]
+	                            : (0x38 | (A >> 13));
+	if (!gime->TY && bank >= 0x3c)
+		return 0;
+	*Z = (bank << 13) | (A & 0x1fff);
+	return 1;
+}
+
 // Just the address decode from tcc1014_mem_cycle().  Used to verify that a
 // breakpoint refers to ROM.  Unlike SAM equivalent, RnW doesn't affect the
 // result.
@@ -1265,8 +1316,14 @@ static uint8_t fetch_byte_vram(struct TCC1014_private *gime) {
 		r = gime->vdata_cache;
 		gime->have_vdata_cache = 0;
 	} else {
-		// X offset appears to be dynamically added to current video address
-		uint16_t data = DELEGATE_CALL(gime->public.fetch_vram, gime->B + (gime->Xoff & 0xff));
+		uint16_t data;
+		if (gime->vram_buf_index < gime->vram_buf_nwords) {
+			data = gime->vram_buf[gime->vram_buf_index++];
+		} else {
+			// X offset appears to be dynamically added to current
+			// video address
+			data = DELEGATE_CALL(gime->public.fetch_vram, gime->B + (gime->Xoff & 0xff));
+		}
 		gime->Xoff += 2;
 		r = data >> 8;
 		gime->vdata_cache = data;
@@ -1275,6 +1332,63 @@ static uint8_t fetch_byte_vram(struct TCC1014_private *gime) {
 	return r;
 }
 
+// Fetch in one go all the video data that render_scanline() will need to
+// reach the specified point.  Data is still only read as the beam passes, so
+// anything the CPU writes ahead of the beam is seen, as before.  Any data
+// fetched but not consumed is discarded on the next call.  Without a
+// fetch_vram_n delegate, nothing is prefetched, and data is read a word at a
+// time with fetch_vram.
+
+static void prefetch_vram(struct TCC1014_private *gime, unsigned beam_to) {
+	gime->vram_buf_index = gime->vram_buf_nwords = 0;
+	if (!gime->public.fetch_vram_n.func)
+		return;
+
+	unsigned end = beam_to < gime->horizontal.tHS_RB ? beam_to : gime->horizontal.tHS_RB;
+	if (gime->horizontal.npixels >= end)
+		return;
+
+	// Bytes to render, and bytes of data that will consume
+	unsigned ppb = 32 >> gime->resolution;
+	unsigned nbytes = (end - gime->horizontal.npixels + ppb - 1) / ppb;
+	if (!gime->COCO && !gime->BP && (gime->CRES & 1))
+		nbytes *= 2;
+	if (gime->have_vdata_cache)
+		nbytes--;
+
+	unsigned nwords = (nbytes + 1) / 2;
+	if (nwords > ARRAY_N_ELEMENTS(gime->vram_buf))
+		nwords = ARRAY_N_ELEMENTS(gime->vram_buf);
+
+	// Split fetches where the horizontal offset wraps
+	unsigned Xoff = gime->Xoff;
+	for (unsigned i = 0; i < nwords; ) {
+		unsigned x = Xoff & 0xff;
+		unsigned n = (257 - x) / 2;
+		if (n > nwords - i)
+			n = nwords - i;
+		DELEGATE_CALL(gime->public.fetch_vram_n, gime->B + x, n, gime->vram_buf + i);
+		Xoff += n * 2;
+		i += n;
+	}
+	gime->vram_buf_nwords = nwords;
+}
+
+static void init_slot_index(void) {
+	if (have_slot_index)
+		return;
+	for (unsigned d = 0; d < 256; d++) {
+		for (unsigned i = 0; i < 8; i++) {
+			slot_index[GIME_SLOTS_1BPP][d][i] = (d >> (7 - i)) & 1;
+			slot_index[GIME_SLOTS_2BPP][d][i] = (d >> (6 - 2*(i/2))) & 3;
+			slot_index[GIME_SLOTS_4BPP][d][i] = (d >> (4 - 4*(i/4))) & 15;
+			slot_index[GIME_SLOTS_RG2][d][i] = (d >> (6 - 2*(i/2))) & 1;
+			slot_index[GIME_SLOTS_SG][d][i] = (d >> (1 - i/4)) & 1;
+		}
+	}
+	have_slot_index = 1;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 // Render scanline to specified point in time.
@@ -1311,12 +1425,27 @@ static void render_scanline(struct TCC1014_private *gime, event_ticks t) {
 	}
 
 	// Active area
+
+	// Colours are looked up once per call.  Palette changes mid-scanline
+	// call render_scanline() first, so they remain valid throughout.
+	uint8_t pal[16];
+	{
+		// With the "monochrome" bit set, the grey at that intensity is
+		// emitted - but only for composite, so we need to know if
+		// that's what the user is viewing.
+		uint_fast8_t cmask = (!gime->COCO && gime->MOCH && gime->want_composite) ? 0x30 : 0x3f;
+		for (unsigned i = 0; i < 16; i++) {
+			pal[i] = gime->palette_reg[i] & cmask;
+		}
+	}
+
+	prefetch_vram(gime, beam_to);
+
 	while (gime->horizontal.npixels < gime->horizontal.tHS_RB) {
-		enum vdg_render_mode render_mode;
+		enum gime_slots slots;
 		uint_fast8_t gdata;
-		uint_fast8_t fg_colour = 0;
-		uint_fast8_t bg_colour = 0;
-		uint_fast8_t cg_colours = 0;
+		uint8_t fgbg[2];
+		const uint8_t *cmap = fgbg;
 
 		// VRAM fetch and interpretation based on mode
 		if (gime->COCO) {
@@ -1327,18 +1456,17 @@ static void render_scanline(struct TCC1014_private *gime, event_ticks t) {
 			if (gime->VDG.GnA) {
 				// Graphics mode
 				gdata = vdata;
-				fg_colour = gime->VDG.CSS ? TCC1014_RGCSS1_1 : TCC1014_RGCSS0_1;
-				bg_colour = gime->VDG.CSS ? TCC1014_RGCSS1_0 : TCC1014_RGCSS0_0;
-				cg_colours = !gime->VDG.CSS ? TCC1014_GREEN : TCC1014_WHITE;
-				render_mode = gime->VDG.GM0 ? TCC1014_RENDER_RG : TCC1014_RENDER_CG;
+				fgbg[1] = pal[gime->VDG.CSS ? TCC1014_RGCSS1_1 : TCC1014_RGCSS0_1];
+				fgbg[0] = pal[gime->VDG.CSS ? TCC1014_RGCSS1_0 : TCC1014_RGCSS0_0];
 				if (gime->VDG.GM0) {
 					if (gime->resolution || (gime->PIA1B_shadow.pdr & 0x70) == 0x70) {
-						render_mode = TCC1014_RENDER_RG;
+						slots = GIME_SLOTS_1BPP;
 					} else {
-						render_mode = TCC1014_RENDER_RG2;
+						slots = GIME_SLOTS_RG2;
 					}
 				} else {
-					render_mode = TCC1014_RENDER_CG;
+					slots = GIME_SLOTS_2BPP;
+					cmap = pal + (!gime->VDG.CSS ? TCC1014_GREEN : TCC1014_WHITE);
 				}
 			} else {
 				if (SnA) {
@@ -1348,9 +1476,9 @@ static void render_scanline(struct TCC1014_private *gime, event_ticks t) {
 					} else {
 						gdata = vdata;
 					}
-					fg_colour = (vdata >> 4) & 7;
-					bg_colour = TCC1014_RGCSS0_0;
-					render_mode = TCC1014_RENDER_SG;
+					fgbg[1] = pal[(vdata >> 4) & 7];
+					fgbg[0] = pal[TCC1014_RGCSS0_0];
+					slots = GIME_SLOTS_SG;
 				} else {
 					// Alphanumeric
 					bool INV = vdata & 0x40;
@@ -1367,9 +1495,9 @@ static void render_scanline(struct TCC1014_private *gime, event_ticks t) {
 					// Handle UI-specified inverse text mode:
 					if (INV ^ gime->inverted_text)
 						gdata = ~gdata;
-					fg_colour = gime->VDG.CSS ? TCC1014_BRIGHT_ORANGE : TCC1014_BRIGHT_GREEN;
-					bg_colour = gime->VDG.CSS ? TCC1014_DARK_ORANGE : TCC1014_DARK_GREEN;
-					render_mode = TCC1014_RENDER_RG;
+					fgbg[1] = pal[gime->VDG.CSS ? TCC1014_BRIGHT_ORANGE : TCC1014_BRIGHT_GREEN];
+					fgbg[0] = pal[gime->VDG.CSS ? TCC1014_DARK_ORANGE : TCC1014_DARK_GREEN];
+					slots = GIME_SLOTS_1BPP;
 				}
 			}
 
@@ -1388,145 +1516,82 @@ static void render_scanline(struct TCC1014_private *gime, event_ticks t) {
 				if (gime->HRES == 0 && gime->CRES >= 2) {
 					gime->vdata_cache = 0;
 				}
+				cmap = pal;
+				switch (gime->CRES) {
+				case 0: default:
+					slots = GIME_SLOTS_1BPP;
+					break;
+				case 1:
+					slots = GIME_SLOTS_2BPP;
+					break;
+				case 2: case 3:
+					slots = GIME_SLOTS_4BPP;
+					break;
+				}
 			} else {
 				// CoCo 3 text
 				int c = vdata & 0x7f;
 				gdata = font_gime[c*12+font_row];
 				if (gime->CRES & 1) {
 					uint_fast8_t attr = fetch_byte_vram(gime);
-					fg_colour = 8 | ((attr >> 3) & 7);
-					bg_colour = attr & 7;
+					uint_fast8_t fg_colour = 8 | ((attr >> 3) & 7);
+					uint_fast8_t bg_colour = attr & 7;
 					if ((attr & 0x80) && gime->blink)
 						fg_colour = bg_colour;
 					if ((attr & 0x40) && ((font_row & gime->rowmask) == gime->rowmask))
 						gdata = 0xff;
+					fgbg[1] = pal[fg_colour];
+					fgbg[0] = pal[bg_colour];
 				} else {
-					fg_colour = 1;
-					bg_colour = 0;
+					fgbg[1] = pal[1];
+					fgbg[0] = pal[0];
 				}
+				slots = GIME_SLOTS_1BPP;
 			}
-			render_mode = TCC1014_RENDER_RG;
 		}
 
-		// Consider 4 bits at a time, twice.
-		for (int i = 2; i; --i) {
-			uint_fast8_t c0, c1, c2, c3;
+		// Data is considered as 4 bits at a time, twice, giving eight
+		// colour "slots" per byte.  The slot table maps each to an
+		// index into the colour map for this byte.
 
-			if (gime->COCO) {
-				// VDG compatible mode
-				switch (render_mode) {
-				case TCC1014_RENDER_SG: default:
-					c0 = c1 = c2 = c3 = gime->palette_reg[(gdata&0x02) ? fg_colour : bg_colour];
-					gdata <<= 1;
-					break;
-				case TCC1014_RENDER_CG:
-					c0 = c1 = gime->palette_reg[cg_colours + ((gdata >> 6) & 3)];
-					c2 = c3 = gime->palette_reg[cg_colours + ((gdata >> 4) & 3)];
-					gdata <<= 4;
-					break;
-				case TCC1014_RENDER_RG:
-					c0 = gime->palette_reg[(gdata&0x80) ? fg_colour : bg_colour];
-					c1 = gime->palette_reg[(gdata&0x40) ? fg_colour : bg_colour];
-					c2 = gime->palette_reg[(gdata&0x20) ? fg_colour : bg_colour];
-					c3 = gime->palette_reg[(gdata&0x10) ? fg_colour : bg_colour];
-					gdata <<= 4;
-					break;
-				case TCC1014_RENDER_RG2:
-					c0 = c1 = gime->palette_reg[(gdata&0x40) ? fg_colour : bg_colour];
-					c2 = c3 = gime->palette_reg[(gdata&0x10) ? fg_colour : bg_colour];
-					gdata <<= 4;
-					break;
-				}
-
-			} else {
-				// CoCo 3 modes
-
-				// With the "monochrome" bit set, the grey at
-				// that intensity is emitted - but only for
-				// composite, so we need to know if that's what
-				// the user is viewing.
-				uint_fast8_t cmask = (gime->MOCH && gime->want_composite) ? 0x30 : 0x3f;
-
-				if (gime->BP) {
-					switch (gime->CRES) {
-					case 0: default:
-						c0 = gime->palette_reg[(gdata>>7)&1] & cmask;
-						c1 = gime->palette_reg[(gdata>>6)&1] & cmask;
-						c2 = gime->palette_reg[(gdata>>5)&1] & cmask;
-						c3 = gime->palette_reg[(gdata>>4)&1] & cmask;
-						break;
-
-					case 1:
-						c0 = c1 = gime->palette_reg[(gdata>>6)&3] & cmask;
-						c2 = c3 = gime->palette_reg[(gdata>>4)&3] & cmask;
-						break;
-
-					case 2: case 3:
-						c0 = c1 = c2 = c3 = gime->palette_reg[(gdata>>4)&15] & cmask;
-						break;
-					}
+		const uint8_t *slot = slot_index[slots][gdata & 0xff];
+		uint8_t c[8];
+		for (int i = 0; i < 8; i++) {
+			c[i] = cmap[slot[i]];
+		}
 
-				} else {
-					c0 = gime->palette_reg[(gdata&0x80)?fg_colour:bg_colour] & cmask;
-					c1 = gime->palette_reg[(gdata&0x40)?fg_colour:bg_colour] & cmask;
-					c2 = gime->palette_reg[(gdata&0x20)?fg_colour:bg_colour] & cmask;
-					c3 = gime->palette_reg[(gdata&0x10)?fg_colour:bg_colour] & cmask;
-				}
-				gdata <<= 4;
+		// Render appropriate number of pixels
+		switch (gime->resolution) {
+		case 0:
+			for (int i = 0; i < 8; i++) {
+				memset(pixel, c[i], 4);
+				pixel += 4;
 			}
+			gime->horizontal.npixels += 32;
+			break;
 
-			// Render appropriate number of pixels
-			switch (gime->resolution) {
-			case 0:
-				*(pixel) = c0;
-				*(pixel+1) = c0;
-				*(pixel+2) = c0;
-				*(pixel+3) = c0;
-				*(pixel+4) = c1;
-				*(pixel+5) = c1;
-				*(pixel+6) = c1;
-				*(pixel+7) = c1;
-				*(pixel+8) = c2;
-				*(pixel+9) = c2;
-				*(pixel+10) = c2;
-				*(pixel+11) = c2;
-				*(pixel+12) = c3;
-				*(pixel+13) = c3;
-				*(pixel+14) = c3;
-				*(pixel+15) = c3;
-				pixel += 16;
-				gime->horizontal.npixels += 16;
-				break;
-
-			case 1:
-				*(pixel) = c0;
-				*(pixel+1) = c0;
-				*(pixel+2) = c1;
-				*(pixel+3) = c1;
-				*(pixel+4) = c2;
-				*(pixel+5) = c2;
-				*(pixel+6) = c3;
-				*(pixel+7) = c3;
-				pixel += 8;
-				gime->horizontal.npixels += 8;
-				break;
-
-			case 2:
-				*(pixel) = c0;
-				*(pixel+1) = c1;
-				*(pixel+2) = c2;
-				*(pixel+3) = c3;
-				pixel += 4;
-				gime->horizontal.npixels += 4;
-				break;
-
-			case 3:
-				*(pixel) = c0;
-				*(pixel+1) = c2;
-				pixel += 2;
-				gime->horizontal.npixels += 2;
-				break;
+		case 1:
+			for (int i = 0; i < 8; i++) {
+				*(pixel++) = c[i];
+				*(pixel++) = c[i];
 			}
+			gime->horizontal.npixels += 16;
+			break;
+
+		case 2:
+			memcpy(pixel, c, 8);
+			pixel += 8;
+			gime->horizontal.npixels += 8;
+			break;
+
+		case 3:
+			*(pixel) = c[0];
+			*(pixel+1) = c[2];
+			*(pixel+2) = c[4];
+			*(pixel+3) = c[6];
+			pixel += 4;
+			gime->horizontal.npixels += 4;
+			break;
 		}
 
 		if (gime->horizontal.npixels >= beam_to)
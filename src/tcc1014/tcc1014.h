@@ -61,6 +61,9 @@ struct TCC1014 {
 
 	DELEGATE_T3(void, int, bool, uint16) cpu_cycle;
 	DELEGATE_T1(uint16, uint32) fetch_vram;
+	// Fetch a run of 16-bit words of video data (address, count, dest).
+	// Optional: if unset, fetch_vram is used for every word.
+	DELEGATE_T3(void, uint32, int, uint16p) fetch_vram_n;
 
 	// Report geometry
 	//
@@ -89,6 +92,9 @@ struct TCC1014 {
 
 void tcc1014_reset(struct TCC1014 *gimep);
 void tcc1014_mem_cycle(void *sptr, bool RnW, uint16_t A);
+unsigned tcc1014_cycle_ticks(struct TCC1014 *gimep);
+bool tcc1014_il_settled(struct TCC1014 *gimep);
+bool tcc1014_decode_ram(struct TCC1014 *gimep, uint16_t A, unsigned *Z);
 
 unsigned tcc1014_decode(struct TCC1014 *, uint16_t A);
 void tcc1014_set_sam_register(struct TCC1014 *gimep, unsigned val);
@@ -276,9 +276,9 @@ enum ui_tag {
 	// which accepts -179 to +180.  Handled in vr_render.c.
 
 	ui_tag_frameskip,
-	// Set frameskip.  Value 0-1000, default is no frameskip (0).  Handled
-	// in xroar.c, but the result is used per-machine.  TODO: consider
-	// moving.
+	// Set frameskip.  Value 0-1000, default is no frameskip (0), or
+	// UI_AUTO to skip frames only while the host is behind.  Range
+	// checked in xroar.c, acted on in vo.c.
 
 	ui_tag_zoom,
 	// value = UI_PREV zooms out
@@ -18,12 +18,17 @@
 
 #include "top-config.h"
 
+// for gettimeofday
+#define _POSIX_C_SOURCE 200112L
+
 #include <assert.h>
 #include <stdlib.h>
+#include <sys/time.h>
 
 #include "delegate.h"
 #include "xalloc.h"
 
+#include "events.h"
 #include "messenger.h"
 #include "module.h"
 #include "ui.h"
@@ -62,6 +67,8 @@ static void vo_ui_set_vsync(void *, int tag, void *smsg);
 static void vo_ui_set_fullscreen(void *, int tag, void *smsg);
 static void vo_ui_set_menubar(void *, int tag, void *smsg);
 static void vo_ui_set_zoom(void *, int tag, void *smsg);
+static void vo_ui_set_frameskip(void *, int tag, void *smsg);
+static void vo_ui_set_ratelimit(void *, int tag, void *smsg);
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
@@ -85,6 +92,8 @@ void vo_interface_init(struct vo_interface *vo) {
 	ui_messenger_preempt_group(vo->msgr_client_id, ui_tag_fullscreen, MESSENGER_NOTIFY_DELEGATE(vo_ui_set_fullscreen, vo));
 	ui_messenger_preempt_group(vo->msgr_client_id, ui_tag_menubar, MESSENGER_NOTIFY_DELEGATE(vo_ui_set_menubar, vo));
 	ui_messenger_preempt_group(vo->msgr_client_id, ui_tag_zoom, MESSENGER_NOTIFY_DELEGATE(vo_ui_set_zoom, vo));
+	ui_messenger_join_group(vo->msgr_client_id, ui_tag_frameskip, MESSENGER_NOTIFY_DELEGATE(vo_ui_set_frameskip, vo));
+	ui_messenger_join_group(vo->msgr_client_id, ui_tag_ratelimit, MESSENGER_NOTIFY_DELEGATE(vo_ui_set_ratelimit, vo));
 }
 
 // Calls free() delegate then frees structure
@@ -116,6 +125,7 @@ void vo_set_renderer(struct vo_interface *vo, struct vo_render *vr) {
 
 	// Used by machine to render video
 	vo->render_line = DELEGATE_AS3(void, unsigned, unsigned, uint8cp, vr->render_cmp_palette, vr);
+	vo->render_line = vo_render_thread_line(vr, vo->render_line);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -127,36 +137,40 @@ static void update_render_parameters(struct vo_interface *vo) {
 	if (!vr)
 		return;
 
-	// RGB is always palette-based
+	// Finish any queued lines.  Lines cached by the previous renderer are
+	// no longer valid.
+	vo_render_sync(vr);
+	vo_render_invalidate(vr);
+
 	if (vo->signal == VO_SIGNAL_RGB) {
+		// RGB is always palette-based
 		vo->render_line = DELEGATE_AS3(void, unsigned, unsigned, uint8cp, vr->render_rgb_palette, vr);
-		return;
-	}
-
-	// As is S-Video, though it uses the composite palette
-	if (vo->signal == VO_SIGNAL_SVIDEO) {
+	} else if (vo->signal == VO_SIGNAL_SVIDEO) {
+		// As is S-Video, though it uses the composite palette
 		vo->render_line = DELEGATE_AS3(void, unsigned, unsigned, uint8cp, vr->render_cmp_palette, vr);
-		return;
+	} else {
+		// Composite video has more options
+		switch (vo->cmp_ccr) {
+		case VO_CMP_CCR_PALETTE:
+			vo->render_line = DELEGATE_AS3(void, unsigned, unsigned, uint8cp, vr->render_cmp_palette, vr);
+			break;
+		case VO_CMP_CCR_2BIT:
+			vo->render_line = DELEGATE_AS3(void, unsigned, unsigned, uint8cp, vr->render_cmp_2bit, vr);
+			break;
+		case VO_CMP_CCR_5BIT:
+			vo->render_line = DELEGATE_AS3(void, unsigned, unsigned, uint8cp, vr->render_cmp_5bit, vr);
+			break;
+		case VO_CMP_CCR_PARTIAL:
+			vo->render_line = DELEGATE_AS3(void, unsigned, unsigned, uint8cp, vo_render_cmp_partial, vr);
+			break;
+		case VO_CMP_CCR_SIMULATED:
+			vo->render_line = DELEGATE_AS3(void, unsigned, unsigned, uint8cp, vo_render_cmp_simulated, vr);
+			break;
+		}
 	}
 
-	// Composite video has more options
-	switch (vo->cmp_ccr) {
-	case VO_CMP_CCR_PALETTE:
-		vo->render_line = DELEGATE_AS3(void, unsigned, unsigned, uint8cp, vr->render_cmp_palette, vr);
-		break;
-	case VO_CMP_CCR_2BIT:
-		vo->render_line = DELEGATE_AS3(void, unsigned, unsigned, uint8cp, vr->render_cmp_2bit, vr);
-		break;
-	case VO_CMP_CCR_5BIT:
-		vo->render_line = DELEGATE_AS3(void, unsigned, unsigned, uint8cp, vr->render_cmp_5bit, vr);
-		break;
-	case VO_CMP_CCR_PARTIAL:
-		vo->render_line = DELEGATE_AS3(void, unsigned, unsigned, uint8cp, vo_render_cmp_partial, vr);
-		break;
-	case VO_CMP_CCR_SIMULATED:
-		vo->render_line = DELEGATE_AS3(void, unsigned, unsigned, uint8cp, vo_render_cmp_simulated, vr);
-		break;
-	}
+	// Queue lines for the render thread, if enabled
+	vo->render_line = vo_render_thread_line(vr, vo->render_line);
 }
 
 // Select input signal
@@ -215,7 +229,92 @@ void vo_set_draw_area(struct vo_interface *vo, int x, int y, int w, int h) {
 	}
 }
 
-extern inline void vo_vsync(struct vo_interface *vo, bool draw);
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+// Frameskip
+//
+// Frames to be skipped are not rendered or drawn (see vo_render_line()).
+//
+// With a fixed frameskip of N, one frame in every N+1 is rendered.  Running
+// without rate limiting ("turbo") always uses a fixed frameskip of
+// TURBO_FRAMESKIP, so that fast-forwarding spends its time emulating.
+//
+// Automatic frameskip compares host time elapsed since the last vertical sync
+// against the emulated time elapsed.  The running difference says how far
+// behind real time we are.  Rendering and drawing make up most of the
+// per-frame cost, so once we are more than a frame behind, stop rendering
+// frames until we have caught up again.  At least one frame in every
+// AUTO_FRAMESKIP_MAX + 1 is always rendered.
+//
+// When running ahead, rate limiting (in the audio module) absorbs the
+// difference, so lag only accrues credit of up to one frame.  Likewise, once
+// the audio module is holding us back again, any remaining lag is forgiven.
+// A long gap between frames (pause, file requester, debugger, machine reset)
+// is not counted at all.
+
+#define TURBO_FRAMESKIP (10)
+#define AUTO_FRAMESKIP_MAX (10)
+#define AUTO_FRAMESKIP_STALL_US (250000)
+
+static int64_t host_time_us(void) {
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return (int64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+// Restart frameskip timing.  Whether the current frame is skipped is left
+// alone: it may be partly rendered, and only vo_vsync() changes that.
+
+static void frameskip_reset(struct vo_interface *vo) {
+	vo->frameskip.nskipped = 0;
+	vo->frameskip.last_tick = event_current_tick;
+	vo->frameskip.last_us = host_time_us();
+	vo->frameskip.lag_us = 0;
+}
+
+static bool auto_frameskip(struct vo_interface *vo) {
+	int64_t now = host_time_us();
+	int64_t host_us = now - vo->frameskip.last_us;
+	int64_t ticks = event_tick_delta(event_current_tick, vo->frameskip.last_tick);
+	int64_t frame_us = (ticks * 1000000) / (int64_t)EVENT_TICK_RATE;
+	vo->frameskip.last_us = now;
+	vo->frameskip.last_tick = event_current_tick;
+
+	if (host_us < 0 || host_us > AUTO_FRAMESKIP_STALL_US ||
+	    frame_us <= 0 || frame_us > AUTO_FRAMESKIP_STALL_US) {
+		vo->frameskip.lag_us = 0;
+	} else {
+		int64_t lag = vo->frameskip.lag_us + host_us - frame_us;
+		vo->frameskip.lag_us = (lag < -frame_us) ? -frame_us : lag;
+	}
+
+	if (vo->frameskip.skip) {
+		// A skipped frame that still took (nearly) real time was held
+		// back by rate limiting, so we are as caught up as we can get.
+		if (host_us >= frame_us - frame_us / 8 && vo->frameskip.lag_us > 0) {
+			vo->frameskip.lag_us = 0;
+		}
+		// Keep skipping until caught up
+		return vo->frameskip.lag_us > 0 && vo->frameskip.nskipped < AUTO_FRAMESKIP_MAX;
+	}
+	return vo->frameskip.lag_us > frame_us;
+}
+
+void vo_frameskip_update(struct vo_interface *vo) {
+	bool skip;
+	if (vo->frameskip.turbo) {
+		skip = vo->frameskip.nskipped < TURBO_FRAMESKIP;
+	} else if (vo->frameskip.frames == UI_AUTO) {
+		skip = auto_frameskip(vo);
+	} else {
+		skip = vo->frameskip.nskipped < (unsigned)vo->frameskip.frames;
+	}
+	vo->frameskip.skip = skip;
+	vo->frameskip.nskipped = skip ? vo->frameskip.nskipped + 1 : 0;
+}
+
+extern inline void vo_render_line(struct vo_interface *vo, unsigned burst, unsigned npixels, uint8_t const *data);
+extern inline void vo_vsync(struct vo_interface *vo);
 extern inline void vo_refresh(struct vo_interface *vo);
 
 // Helper function to parse geometry string
@@ -323,6 +422,28 @@ static void vo_ui_set_menubar(void *sptr, int tag, void *smsg) {
 					UI_ADJUST_FLAG_CYCLE);
 }
 
+// Frameskip value is range checked in xroar.c
+
+static void vo_ui_set_frameskip(void *sptr, int tag, void *smsg) {
+	struct vo_interface *vo = sptr;
+	struct ui_state_message *uimsg = smsg;
+	assert(tag == ui_tag_frameskip);
+
+	vo->frameskip.frames = uimsg->value;
+	frameskip_reset(vo);
+}
+
+// Skip most frames while not rate limited
+
+static void vo_ui_set_ratelimit(void *sptr, int tag, void *smsg) {
+	struct vo_interface *vo = sptr;
+	struct ui_state_message *uimsg = smsg;
+	assert(tag == ui_tag_ratelimit);
+
+	vo->frameskip.turbo = !uimsg->value;
+	frameskip_reset(vo);
+}
+
 // Zoom helpers
 
 static void vo_ui_set_zoom(void *sptr, int tag, void *smsg) {
@@ -90,6 +90,8 @@ extern struct xconfig_enum vo_gl_filter_list[];
 struct vo_cfg {
 	char *geometry;
 	int pixel_fmt;
+	bool render_thread;
+	int ntsc_lut_kib;
 };
 
 // Window Area is the obvious top level.  Defined in host screen pixels, and
@@ -157,6 +159,19 @@ struct vo_interface {
 		bool button[3];
 	} mouse;
 
+	// Frameskip.  'skip' is only ever changed by vo_vsync(), so that a
+	// frame is rendered either completely or not at all.
+	struct {
+		int frames;          // configured frameskip, or UI_AUTO
+		bool turbo;          // running without rate limit
+		bool skip;           // current frame is not being rendered
+		unsigned nskipped;   // consecutive frames skipped
+		// Automatic frameskip
+		uint64_t last_tick;  // emulated time at last vsync
+		int64_t last_us;     // host time at last vsync
+		int64_t lag_us;      // how far host time is behind emulated time
+	} frameskip;
+
 	// Called by vo_free before freeing the struct to handle
 	// module-specific allocations
 	DELEGATE_T0(void) free;
@@ -221,6 +236,10 @@ struct vo_interface {
 
 	// Draw the current buffer.  Called by vo_vsync() and vo_refresh().
 	DELEGATE_T0(void) draw;
+
+	// Optional hook called by vo_vsync() once a frame is complete, eg to
+	// capture it.  Passed true if the frame was skipped.
+	DELEGATE_T1(void, bool) capture_frame;
 };
 
 // Geometry handling
@@ -270,20 +289,36 @@ void vo_set_viewport(struct vo_interface *vo, int picture);
 
 void vo_set_draw_area(struct vo_interface *, int x, int y, int w, int h);
 
-// Vertical sync.  Calls any module-specific draw function if requested, then
-// vo_render_vsync().  Called with draw=0 during frameskip, as we still want to
-// count scanlines.
+// Called by vo_vsync() to decide whether the next frame is to be skipped
+
+void vo_frameskip_update(struct vo_interface *vo);
+
+// Render a scanline.  While skipping a frame, the line is passed on as a
+// dummy, so the renderer counts it without doing any work.  The machine still
+// runs its video timing and VRAM fetches as normal.
+
+inline void vo_render_line(struct vo_interface *vo, unsigned burst, unsigned npixels, uint8_t const *data) {
+	DELEGATE_CALL(vo->render_line, burst, npixels, vo->frameskip.skip ? NULL : data);
+}
+
+// Vertical sync.  Calls any module-specific draw function unless this frame
+// was skipped, and any capture hook, then vo_render_vsync().  Decides whether
+// to skip the next frame.
 
-inline void vo_vsync(struct vo_interface *vo, bool draw) {
-	if (draw)
+inline void vo_vsync(struct vo_interface *vo) {
+	vo_render_sync(vo->renderer);
+	if (!vo->frameskip.skip)
 		DELEGATE_SAFE_CALL(vo->draw);
+	DELEGATE_SAFE_CALL(vo->capture_frame, vo->frameskip.skip);
 	vo_render_vsync(vo->renderer);
+	vo_frameskip_update(vo);
 }
 
 // Refresh the display by calling draw().  Useful while single-stepping, where
 // the usual render functions won't be called.
 
 inline void vo_refresh(struct vo_interface *vo) {
+	vo_render_sync(vo->renderer);
 	DELEGATE_SAFE_CALL(vo->draw);
 }
 
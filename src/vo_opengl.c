@@ -162,6 +162,8 @@ bool vo_opengl_configure(struct vo_opengl_interface *vogl, struct vo_cfg *cfg) {
 	}
 
 	struct vo_render *vr = vo_render_new(cfg->pixel_fmt);
+	vo_render_set_threaded(vr, cfg->render_thread);
+	vo_render_set_ntsc_lut(vr, cfg->ntsc_lut_kib);
 	vo_set_renderer(vo, vr);
 
 	vo->free = DELEGATE_AS0(void, vo_opengl_free, vo);
@@ -228,6 +230,8 @@ static void update_viewport(struct vo_opengl_interface *vogl) {
 			vogl->texture.buf_format, vogl->texture.buf_type, vogl->texture.pixels);
 
 	vr->buffer_pitch = vp_w;
+	// New texture needs all lines uploading
+	vo_render_set_dirty(vr);
 }
 
 void vo_opengl_update_gl_filter(struct vo_opengl_interface *vogl) {
@@ -257,10 +261,18 @@ void vo_opengl_draw(void *sptr) {
 
 	glClear(GL_COLOR_BUFFER_BIT);
 
+	// Upload only lines that have changed
 	glBindTexture(GL_TEXTURE_2D, vogl->texture.num);
-	glTexSubImage2D(GL_TEXTURE_2D, 0,
-			0, 0, vr->viewport.w, vr->viewport.h,
-			vogl->texture.buf_format, vogl->texture.buf_type, vogl->texture.pixels);
+	int pitch = vr->viewport.w * vogl->texture.pixel_size;
+	int y = 0, h;
+	while ((y = vo_render_next_dirty(vr, y, &h)) >= 0) {
+		glTexSubImage2D(GL_TEXTURE_2D, 0,
+				0, y, vr->viewport.w, h,
+				vogl->texture.buf_format, vogl->texture.buf_type,
+				(uint8_t *)vogl->texture.pixels + y * pitch);
+		y += h;
+	}
+	vo_render_clear_dirty(vr);
 
 	glBindFramebuffer(GL_READ_FRAMEBUFFER, vogl->blit_fbo);
 	glBlitFramebuffer(0, vr->viewport.h, vr->viewport.w, 0,
@@ -26,6 +26,11 @@
 #include <math.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
+
+#ifdef HAVE_PTHREADS
+#include <pthread.h>
+#endif
 
 #ifndef M_PI
 # define M_PI 3.14159265358979323846
@@ -34,10 +39,12 @@
 #include "delegate.h"
 #include "intfuncs.h"
 #include "pl-endian.h"
+#include "simd.h"
 #include "xalloc.h"
 
 #include "colourspace.h"
 #include "filter.h"
+#include "logging.h"
 #include "messenger.h"
 #include "ntsc.h"
 #include "vo_render.h"
@@ -170,6 +177,153 @@ static const uint8_t cmp_lut_5bit[2][32][3] = {
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+// Scanline cache
+//
+// Each line of the output buffer within the viewport has a record of the
+// renderer and input that produced it.  If a line is presented again with the
+// same input, its rendered output is still in the buffer, and the renderer
+// can just advance to the next line.
+//
+// Input data is compared directly rather than hashed, so a hit is never a
+// false positive.  Anything else that changes output (palette, burst tables,
+// viewport, etc.) increments a generation counter, invalidating all records.
+//
+// As every line within the viewport passes through here, this is also where
+// lines are flagged dirty for the video module: any line that is not a hit.
+
+enum {
+	LINE_CACHE_CMP_PALETTE = 1,
+	LINE_CACHE_CMP_MONO_PALETTE,
+	LINE_CACHE_RGB_PALETTE,
+	LINE_CACHE_RGB_MONO_PALETTE,
+	LINE_CACHE_CMP_2BIT,
+	LINE_CACHE_CMP_5BIT,
+	LINE_CACHE_CMP_PARTIAL,
+	LINE_CACHE_CMP_SIMULATED,
+};
+
+struct vo_render_cached_line {
+	// Generation in which record was made; never valid if zero
+	unsigned generation;
+
+	// Renderer and parameters used
+	int renderer;
+	unsigned burstn;
+	unsigned t;
+	int vswitch;
+
+	// Input data, from x0 to x1
+	unsigned x0, x1;
+	uint8_t data[1024];
+
+	// Filtered chroma (U then V), for renderers that carry it over to the
+	// next line.  Allocated on first use.
+	int *chroma;
+	bool chroma_valid;
+};
+
+// Flag a line within the viewport as needing upload.
+
+static void mark_dirty(struct vo_render *vr, int lno) {
+	if (lno >= 0 && lno < vr->dirty.nwords * 32) {
+		vr->dirty.map[lno >> 5] |= (uint32_t)1 << (lno & 31);
+	}
+}
+
+// Flag the whole viewport as needing upload, resizing the map if necessary.
+
+static void mark_all_dirty(struct vo_render *vr) {
+	int nwords = (vr->viewport.h + 31) / 32;
+	if (nwords > vr->dirty.nwords) {
+		vr->dirty.map = xrealloc(vr->dirty.map, nwords * sizeof(*vr->dirty.map));
+		vr->dirty.nwords = nwords;
+	}
+	memset(vr->dirty.map, 0xff, vr->dirty.nwords * sizeof(*vr->dirty.map));
+}
+
+// Find the record for the current line.  Returns NULL if the line can't be
+// cached.  If the record matches the supplied parameters, sets *hit and the
+// line needn't be rendered.  Otherwise, updates the record to describe the new
+// input, which the caller must then render.
+//
+// If 'chained' is true, the result also depends on state left by the previous
+// line, and can only be a hit if that is known to be unchanged.
+
+static struct vo_render_cached_line *line_cache_lookup(struct vo_render *vr, int renderer,
+						       unsigned burstn, unsigned t, int vswitch,
+						       bool chained, unsigned x0, unsigned x1,
+						       uint8_t const *data, bool *hit) {
+	*hit = 0;
+
+	int lno = vr->scanline - vr->viewport.y;
+	if (lno < 0 || lno >= vr->viewport.h || x0 > x1 || (x1 - x0) > 1024) {
+		mark_dirty(vr, lno);
+		vr->line_cache.chain = 0;
+		return NULL;
+	}
+	if (lno >= vr->line_cache.nlines) {
+		int nlines = vr->viewport.h;
+		vr->line_cache.line = xrealloc(vr->line_cache.line, nlines * sizeof(*vr->line_cache.line));
+		memset(vr->line_cache.line + vr->line_cache.nlines, 0,
+		       (nlines - vr->line_cache.nlines) * sizeof(*vr->line_cache.line));
+		vr->line_cache.nlines = nlines;
+	}
+
+	struct vo_render_cached_line *l = &vr->line_cache.line[lno];
+	if (l->generation == vr->line_cache.generation &&
+	    l->renderer == renderer && l->burstn == burstn &&
+	    l->t == t && l->vswitch == vswitch &&
+	    l->x0 == x0 && l->x1 == x1 &&
+	    (!chained || vr->line_cache.chain) &&
+	    memcmp(l->data, data + x0, x1 - x0) == 0) {
+		vr->line_cache.hits++;
+		vr->line_cache.chain = 1;
+		*hit = 1;
+		return l;
+	}
+
+	vr->line_cache.misses++;
+	mark_dirty(vr, lno);
+	vr->line_cache.chain = 0;
+	l->generation = vr->line_cache.generation;
+	l->renderer = renderer;
+	l->burstn = burstn;
+	l->t = t;
+	l->vswitch = vswitch;
+	l->x0 = x0;
+	l->x1 = x1;
+	memcpy(l->data, data + x0, x1 - x0);
+	return l;
+}
+
+// Record filtered chroma after rendering a line.  If it is unchanged from
+// the previous record, following lines remain valid.
+
+static void line_cache_store_chroma(struct vo_render *vr, struct vo_render_cached_line *l,
+				    int const *fubuf, int const *fvbuf, unsigned x, unsigned w) {
+	if (!l->chroma) {
+		l->chroma = xmalloc(2 * 1024 * sizeof(int));
+	}
+	size_t size = w * sizeof(int);
+	vr->line_cache.chain = l->chroma_valid &&
+		memcmp(l->chroma, fubuf + x, size) == 0 &&
+		memcmp(l->chroma + 1024, fvbuf + x, size) == 0;
+	memcpy(l->chroma, fubuf + x, size);
+	memcpy(l->chroma + 1024, fvbuf + x, size);
+	l->chroma_valid = 1;
+}
+
+// Restore filtered chroma on a cache hit.
+
+static void line_cache_load_chroma(struct vo_render_cached_line *l,
+				   int *fubuf, int *fvbuf, unsigned x, unsigned w) {
+	size_t size = w * sizeof(int);
+	memcpy(fubuf + x, l->chroma, size);
+	memcpy(fvbuf + x, l->chroma + 1024, size);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
 #define VR_PTYPE uint8_t
 #define VR_SUFFIX uint8
 #include "vo_render_tmpl.c"
@@ -329,7 +483,11 @@ struct vo_render *vo_render_new(int fmt) {
 // Free renderer
 
 void vo_render_free(struct vo_render *vr) {
+	vo_render_set_threaded(vr, 0);
 	messenger_client_unregister(vr->msgr_client_id);
+	for (unsigned i = 0; i < vr->cmp.nbursts; i++) {
+		free(vr->cmp.burst[i].ntsc_lut);
+	}
 	free(vr->cmp.burst);
 	if (vr->cmp.mod.ufilter.coeff) {
 		free(vr->cmp.mod.ufilter.coeff - MAX_FILTER_ORDER);
@@ -346,13 +504,258 @@ void vo_render_free(struct vo_render *vr) {
 	if (vr->cmp.demod.vfilter.coeff) {
 		free(vr->cmp.demod.vfilter.coeff - MAX_FILTER_ORDER);
 	}
+	if (vr->line_cache.hits || vr->line_cache.misses) {
+		LOG_DEBUG(1, "vo_render: scanline cache: %u hits, %u misses\n",
+			  vr->line_cache.hits, vr->line_cache.misses);
+	}
+	for (int i = 0; i < vr->line_cache.nlines; i++) {
+		free(vr->line_cache.line[i].chroma);
+	}
+	free(vr->line_cache.line);
+	free(vr->dirty.map);
 	free(vr);
 }
 
+// Discard scanline cache
+
+void vo_render_invalidate(struct vo_render *vr) {
+	// Zero never matches a valid record
+	if (++vr->line_cache.generation == 0)
+		vr->line_cache.generation = 1;
+	vr->line_cache.chain = 0;
+	// Output may differ from whatever was last uploaded
+	mark_all_dirty(vr);
+}
+
+// Dirty line tracking.  Bands separated by only a few clean lines are merged,
+// as each upload has a fixed cost.
+
+#define DIRTY_MERGE_GAP (4)
+
+static bool is_dirty(struct vo_render *vr, int lno) {
+	return vr->dirty.map[lno >> 5] & ((uint32_t)1 << (lno & 31));
+}
+
+int vo_render_next_dirty(struct vo_render *vr, int y, int *h) {
+	vo_render_sync(vr);
+	int nlines = vr->viewport.h;
+	if (nlines > vr->dirty.nwords * 32)
+		nlines = vr->dirty.nwords * 32;
+	if (y < 0)
+		y = 0;
+
+	// Find start of band, skipping clean words quickly
+	while (y < nlines && !is_dirty(vr, y)) {
+		if (!(y & 31) && !vr->dirty.map[y >> 5])
+			y += 32;
+		else
+			y++;
+	}
+	if (y >= nlines)
+		return -1;
+
+	// Find end of band
+	int y0 = y;
+	int gap = 0;
+	for (y++; y < nlines && gap <= DIRTY_MERGE_GAP; y++) {
+		gap = is_dirty(vr, y) ? 0 : gap + 1;
+	}
+	*h = y - gap - y0;
+	return y0;
+}
+
+void vo_render_clear_dirty(struct vo_render *vr) {
+	vo_render_sync(vr);
+	if (vr->dirty.map)
+		memset(vr->dirty.map, 0, vr->dirty.nwords * sizeof(*vr->dirty.map));
+}
+
+void vo_render_set_dirty(struct vo_render *vr) {
+	vo_render_sync(vr);
+	mark_all_dirty(vr);
+}
+
 extern inline void vo_render_set_buffer(struct vo_render *vr, void *buffer);
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+// Threaded rendering
+//
+// When enabled, the render_line delegate only copies each line into a queue.
+// A worker thread runs the real line renderer.  Lines must be rendered in
+// order, as renderers carry state from one to the next (time 't', PAL chroma
+// delay, scanline cache), so there is just the one worker.
+//
+// Anything else that touches renderer state or the output buffer must first
+// call vo_render_sync() to wait for the queue to drain.  All the entry points
+// in this file do so, as does vo_vsync() before drawing.
+
+#ifdef HAVE_PTHREADS
+
+// Enough to hold a full frame
+#define RENDER_QUEUE_SIZE (512)
+
+struct vo_render_queued_line {
+	unsigned burstn;
+	unsigned npixels;
+	bool dummy;  // no data
+	uint8_t data[1024];
+};
+
+struct vo_render_thread {
+	pthread_t thread;
+	pthread_mutex_t mt;
+	pthread_cond_t cv;
+
+	// Line renderer the worker calls
+	DELEGATE_T3(void, unsigned, unsigned, uint8cp) render_line;
+
+	// Lines are added at 'head' and rendered from 'tail'
+	unsigned head;
+	unsigned tail;
+	bool quit;
+
+	// Set while either side is blocked, so the other knows to signal
+	bool worker_waiting;
+	bool producer_waiting;
+
+	struct vo_render_queued_line line[RENDER_QUEUE_SIZE];
+};
+
+static void *render_thread(void *sptr) {
+	struct vo_render_thread *rt = sptr;
+	pthread_mutex_lock(&rt->mt);
+	for (;;) {
+		while (rt->tail == rt->head && !rt->quit) {
+			rt->worker_waiting = 1;
+			pthread_cond_wait(&rt->cv, &rt->mt);
+			rt->worker_waiting = 0;
+		}
+		if (rt->tail == rt->head) {
+			break;
+		}
+		struct vo_render_queued_line *l = &rt->line[rt->tail % RENDER_QUEUE_SIZE];
+		pthread_mutex_unlock(&rt->mt);
+		DELEGATE_CALL(rt->render_line, l->burstn, l->npixels, l->dummy ? NULL : l->data);
+		pthread_mutex_lock(&rt->mt);
+		rt->tail++;
+		if (rt->producer_waiting) {
+			pthread_cond_broadcast(&rt->cv);
+		}
+	}
+	pthread_mutex_unlock(&rt->mt);
+	return NULL;
+}
+
+// Queue a line for the worker thread.  Blocks only if the queue is full.
+
+static void render_queue_line(void *sptr, unsigned burstn, unsigned npixels, uint8_t const *data) {
+	struct vo_render *vr = sptr;
+	struct vo_render_thread *rt = vr->thread;
+
+	pthread_mutex_lock(&rt->mt);
+	while ((rt->head - rt->tail) >= RENDER_QUEUE_SIZE) {
+		rt->producer_waiting = 1;
+		pthread_cond_wait(&rt->cv, &rt->mt);
+		rt->producer_waiting = 0;
+	}
+	pthread_mutex_unlock(&rt->mt);
+
+	// Slot at 'head' is not visible to the worker until 'head' advances
+	struct vo_render_queued_line *l = &rt->line[rt->head % RENDER_QUEUE_SIZE];
+	l->burstn = burstn;
+	l->npixels = npixels;
+	l->dummy = !data;
+	if (data) {
+		memcpy(l->data, data, (npixels < sizeof(l->data)) ? npixels : sizeof(l->data));
+	}
+
+	pthread_mutex_lock(&rt->mt);
+	rt->head++;
+	if (rt->worker_waiting) {
+		pthread_cond_broadcast(&rt->cv);
+	}
+	pthread_mutex_unlock(&rt->mt);
+}
+
+#endif
+
+// Enable or disable threaded rendering
+
+void vo_render_set_threaded(struct vo_render *vr, bool threaded) {
+#ifdef HAVE_PTHREADS
+	if (threaded == (vr->thread != NULL))
+		return;
+
+	if (!threaded) {
+		struct vo_render_thread *rt = vr->thread;
+		pthread_mutex_lock(&rt->mt);
+		rt->quit = 1;
+		pthread_cond_broadcast(&rt->cv);
+		pthread_mutex_unlock(&rt->mt);
+		pthread_join(rt->thread, NULL);
+		pthread_cond_destroy(&rt->cv);
+		pthread_mutex_destroy(&rt->mt);
+		vr->thread = NULL;
+		free(rt);
+		return;
+	}
+
+	struct vo_render_thread *rt = xzalloc(sizeof(*rt));
+	pthread_mutex_init(&rt->mt, NULL);
+	pthread_cond_init(&rt->cv, NULL);
+	if (pthread_create(&rt->thread, NULL, render_thread, rt) != 0) {
+		LOG_WARN("vo_render: failed to create render thread\n");
+		pthread_cond_destroy(&rt->cv);
+		pthread_mutex_destroy(&rt->mt);
+		free(rt);
+		return;
+	}
+	vr->thread = rt;
+#else
+	if (threaded) {
+		LOG_WARN("vo_render: threaded rendering not supported in this build\n");
+	}
+	(void)vr;
+#endif
+}
+
+// Interpose the queue between the machine and the selected line renderer.
+// Returns the delegate the machine should call.
+
+DELEGATE_T3(void, unsigned, unsigned, uint8cp) vo_render_thread_line(struct vo_render *vr, DELEGATE_T3(void, unsigned, unsigned, uint8cp) render_line) {
+#ifdef HAVE_PTHREADS
+	if (vr->thread) {
+		vr->thread->render_line = render_line;
+		return DELEGATE_AS3(void, unsigned, unsigned, uint8cp, render_queue_line, vr);
+	}
+#else
+	(void)vr;
+#endif
+	return render_line;
+}
+
+// Wait for the worker to finish all queued lines
+
+void vo_render_sync(struct vo_render *vr) {
+#ifdef HAVE_PTHREADS
+	if (!vr || !vr->thread)
+		return;
+	struct vo_render_thread *rt = vr->thread;
+	pthread_mutex_lock(&rt->mt);
+	while (rt->tail != rt->head) {
+		rt->producer_waiting = 1;
+		pthread_cond_wait(&rt->cv, &rt->mt);
+		rt->producer_waiting = 0;
+	}
+	pthread_mutex_unlock(&rt->mt);
+#else
+	(void)vr;
+#endif
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
 // Pack R,G,B into a particular pixel format
 
 static uint32_t map_rgba8(int R, int G, int B) {
@@ -480,6 +883,7 @@ static int display_luma_u8(struct vo_render *vr, float y) {
 // Update a composite palette entry, applying brightness & contrast
 
 static void update_cmp_palette(struct vo_render *vr, uint8_t c) {
+	vo_render_invalidate(vr);
 	double y = vr->cmp.colour[c].y;
 	double b_y = vr->cmp.colour[c].pb;
 	double r_y = vr->cmp.colour[c].pr;
@@ -550,6 +954,7 @@ static void update_cmp_palette(struct vo_render *vr, uint8_t c) {
 // Update an RGB palette entry, applying brightness & contrast
 
 static void update_rgb_palette(struct vo_render *vr, uint8_t c) {
+	vo_render_invalidate(vr);
 	float r = vr->rgb.colour[c].r;
 	float g = vr->rgb.colour[c].g;
 	float b = vr->rgb.colour[c].b;
@@ -580,6 +985,7 @@ static void update_rgb_palette(struct vo_render *vr, uint8_t c) {
 // Update gamma LUT
 
 static void update_gamma_table(struct vo_render *vr) {
+	vo_render_invalidate(vr);
 	// Tweak default brightness/contrast a little
 	float brightness = (float)(vr->brightness + 1 - 50) / 50.;
 	float contrast = (float)(vr->contrast + 11) / 50.;
@@ -598,6 +1004,7 @@ static void update_gamma_table(struct vo_render *vr) {
 // tables.
 
 static void update_cmp_burst(struct vo_render *vr, unsigned burstn) {
+	vo_render_invalidate(vr);
 	struct vo_render_burst *burst = &vr->cmp.burst[burstn];
 
 	unsigned tmax = f_ratios[vr->cmp.fs][vr->cmp.fsc].tmax;
@@ -631,10 +1038,21 @@ static void update_cmp_burst(struct vo_render *vr, unsigned burstn) {
 		}
 	}
 
+	// Extend tables by repeating the cycle
+	for (unsigned t = tmax; t < VO_RENDER_BURST_TABLE_LEN; t++) {
+		burst->mod.u[t] = burst->mod.u[t - tmax];
+		burst->mod.v[0][t] = burst->mod.v[0][t - tmax];
+		burst->mod.v[1][t] = burst->mod.v[1][t - tmax];
+		burst->demod.u[t] = burst->demod.u[t - tmax];
+		burst->demod.v[0][t] = burst->demod.v[0][t - tmax];
+		burst->demod.v[1][t] = burst->demod.v[1][t - tmax];
+	}
+
 	ntsc_burst_set(vr, burstn);
 }
 
 static void update_phase_offset(struct vo_render *vr) {
+	vo_render_invalidate(vr);
 	for (unsigned i = 0; i < 256; i++) {
 		ntsc_palette_set_ybr(vr, i);
 	}
@@ -670,6 +1088,7 @@ static void set_lp_filter(struct vo_render_filter *f, double fc, int order) {
 }
 
 static void update_cmp_system(struct vo_render *vr) {
+	vo_render_invalidate(vr);
 	vr->tmax = f_ratios[vr->cmp.fs][vr->cmp.fsc].tmax;
 	assert(vr->tmax <= VO_RENDER_MAX_T);  // sanity check
 	vr->t = 0;
@@ -758,6 +1177,7 @@ static void update_cmp_system(struct vo_render *vr) {
 // Update viewport offset based on viewport dimensions and active area
 
 static void update_viewport(struct vo_render *vr) {
+	vo_render_invalidate(vr);
 	vr->viewport.new_x = vr->active_area.x - (vr->viewport.w - vr->active_area.w) / 2;
 	vr->viewport.new_y = vr->active_area.y - (vr->viewport.h - vr->active_area.h) / 2;
 }
@@ -770,6 +1190,7 @@ static void update_viewport(struct vo_render *vr) {
 //     int w, h;  // dimensions
 
 void vo_render_set_viewport(struct vo_render *vr, int w, int h) {
+	vo_render_sync(vr);
 	vr->viewport.w = w;
 	vr->viewport.h = h;
 	update_viewport(vr);
@@ -781,6 +1202,7 @@ void vo_render_set_viewport(struct vo_render *vr, int w, int h) {
 static void vr_ui_set_ntsc_scaling(void *sptr, int tag, void *smsg) {
 	struct vo_render *vr = sptr;
 	struct ui_state_message *uimsg = smsg;
+	vo_render_sync(vr);
 	assert(tag == ui_tag_ntsc_scaling);
 
 	vr->ntsc_scaling = ui_msg_adjust_value_range(uimsg, vr->ntsc_scaling, 0, 0, 1,
@@ -793,6 +1215,7 @@ static void vr_ui_set_ntsc_scaling(void *sptr, int tag, void *smsg) {
 static void vr_ui_set_brightness(void *sptr, int tag, void *smsg) {
 	struct vo_render *vr = sptr;
 	struct ui_state_message *uimsg = smsg;
+	vo_render_sync(vr);
 	assert(tag == ui_tag_brightness);
 
 	vr->brightness = ui_msg_adjust_value_range(uimsg, vr->brightness, 50, 0, 100, 0);
@@ -809,6 +1232,7 @@ static void vr_ui_set_brightness(void *sptr, int tag, void *smsg) {
 static void vr_ui_set_contrast(void *sptr, int tag, void *smsg) {
 	struct vo_render *vr = sptr;
 	struct ui_state_message *uimsg = smsg;
+	vo_render_sync(vr);
 	assert(tag == ui_tag_contrast);
 
 	vr->contrast = ui_msg_adjust_value_range(uimsg, vr->contrast, 50, 0, 100, 0);
@@ -825,6 +1249,7 @@ static void vr_ui_set_contrast(void *sptr, int tag, void *smsg) {
 static void vr_ui_set_saturation(void *sptr, int tag, void *smsg) {
 	struct vo_render *vr = sptr;
 	struct ui_state_message *uimsg = smsg;
+	vo_render_sync(vr);
 	assert(tag == ui_tag_saturation);
 
 	vr->saturation = ui_msg_adjust_value_range(uimsg, vr->saturation, 50, 0, 100, 0);
@@ -840,6 +1265,7 @@ static void vr_ui_set_saturation(void *sptr, int tag, void *smsg) {
 static void vr_ui_set_hue(void *sptr, int tag, void *smsg) {
 	struct vo_render *vr = sptr;
 	struct ui_state_message *uimsg = smsg;
+	vo_render_sync(vr);
 	assert(tag == ui_tag_hue);
 
 	vr->hue = ui_msg_adjust_value_range(uimsg, vr->hue, 0, -179, 180,
@@ -857,6 +1283,7 @@ static void vr_ui_set_hue(void *sptr, int tag, void *smsg) {
 
 void vo_render_set_cmp_phase(void *sptr, int value) {
 	struct vo_render *vr = sptr;
+	vo_render_sync(vr);
 	vr->cmp.phase = value;
 	update_phase_offset(vr);
 }
@@ -871,6 +1298,7 @@ void vo_render_set_cmp_phase(void *sptr, int value) {
 
 void vo_render_set_active_area(void *sptr, int x, int y, int w, int h) {
 	struct vo_render *vr = sptr;
+	vo_render_sync(vr);
 	vr->active_area.x = x;
 	vr->active_area.y = y;
 	vr->active_area.w = w;
@@ -884,6 +1312,7 @@ void vo_render_set_active_area(void *sptr, int x, int y, int w, int h) {
 static void vr_ui_set_cmp_fs(void *sptr, int tag, void *smsg) {
 	struct vo_render *vr = sptr;
 	struct ui_state_message *uimsg = smsg;
+	vo_render_sync(vr);
 	assert(tag == ui_tag_cmp_fs);
 
 	vr->cmp.fs = ui_msg_adjust_value_range(uimsg, vr->cmp.fs, VO_RENDER_FS_14_31818,
@@ -897,6 +1326,7 @@ static void vr_ui_set_cmp_fs(void *sptr, int tag, void *smsg) {
 static void vr_ui_set_cmp_fsc(void *sptr, int tag, void *smsg) {
 	struct vo_render *vr = sptr;
 	struct ui_state_message *uimsg = smsg;
+	vo_render_sync(vr);
 	assert(tag == ui_tag_cmp_fsc);
 
 	vr->cmp.fsc = ui_msg_adjust_value_range(uimsg, vr->cmp.fsc, VO_RENDER_FSC_4_43361875,
@@ -911,6 +1341,7 @@ static void vr_ui_set_cmp_fsc(void *sptr, int tag, void *smsg) {
 static void vr_ui_set_cmp_system(void *sptr, int tag, void *smsg) {
 	struct vo_render *vr = sptr;
 	struct ui_state_message *uimsg = smsg;
+	vo_render_sync(vr);
 	assert(tag == ui_tag_cmp_system);
 
 	vr->cmp.system = ui_msg_adjust_value_range(uimsg, vr->cmp.system,
@@ -926,6 +1357,7 @@ static void vr_ui_set_cmp_system(void *sptr, int tag, void *smsg) {
 static void vr_ui_set_monochrome(void *sptr, int tag, void *smsg) {
 	struct vo_render *vr = sptr;
 	struct ui_state_message *uimsg = smsg;
+	vo_render_sync(vr);
 	assert(tag == ui_tag_monochrome);
 
 	vr->monochrome = ui_msg_adjust_value_range(uimsg, vr->monochrome, 0, 0, 1,
@@ -939,10 +1371,12 @@ static void vr_ui_set_monochrome(void *sptr, int tag, void *smsg) {
 static void vr_ui_set_cmp_colour_killer(void *sptr, int tag, void *smsg) {
 	struct vo_render *vr = sptr;
 	struct ui_state_message *uimsg = smsg;
+	vo_render_sync(vr);
 	assert(tag == ui_tag_cmp_colour_killer);
 
 	vr->cmp.colour_killer = ui_msg_adjust_value_range(uimsg, vr->cmp.colour_killer, 0,
 							  0, 1, UI_ADJUST_FLAG_CYCLE);
+	vo_render_invalidate(vr);
 }
 
 // Set how the chroma components relate to each other (in degrees)
@@ -951,6 +1385,7 @@ static void vr_ui_set_cmp_colour_killer(void *sptr, int tag, void *smsg) {
 
 void vo_render_set_cmp_lead_lag(void *sptr, float chb_phase, float cha_phase) {
 	struct vo_render *vr = sptr;
+	vo_render_sync(vr);
 	(void)chb_phase;
 	vr->cmp.cha_phase = (cha_phase * 2. * M_PI) / 360.;
 	for (unsigned c = 0; c < 256; c++) {
@@ -962,6 +1397,7 @@ void vo_render_set_cmp_lead_lag(void *sptr, float chb_phase, float cha_phase) {
 
 void vo_render_set_cmp_palette(void *sptr, uint8_t c, float y, float pb, float pr) {
 	struct vo_render *vr = sptr;
+	vo_render_sync(vr);
 	vr->cmp.colour[c].y = y;
 	vr->cmp.colour[c].pb = pb;
 	vr->cmp.colour[c].pr = pr;
@@ -972,6 +1408,7 @@ void vo_render_set_cmp_palette(void *sptr, uint8_t c, float y, float pb, float p
 
 void vo_render_set_rgb_palette(void *sptr, uint8_t c, float r, float g, float b) {
 	struct vo_render *vr = sptr;
+	vo_render_sync(vr);
         vr->rgb.colour[c].r = r;
         vr->rgb.colour[c].g = g;
         vr->rgb.colour[c].b = b;
@@ -984,6 +1421,7 @@ void vo_render_set_rgb_palette(void *sptr, uint8_t c, float r, float g, float b)
 
 void vo_render_set_cmp_burst(void *sptr, unsigned burstn, int offset) {
 	struct vo_render *vr = sptr;
+	vo_render_sync(vr);
 	if (burstn >= vr->cmp.nbursts) {
 		unsigned nbursts = burstn + 1;
 		vr->cmp.burst = xrealloc(vr->cmp.burst, nbursts * sizeof(*(vr->cmp.burst)));
@@ -1000,6 +1438,7 @@ void vo_render_set_cmp_burst(void *sptr, unsigned burstn, int offset) {
 
 void vo_render_set_cmp_burst_br(void *sptr, unsigned burstn, float b_y, float r_y) {
 	struct vo_render *vr = sptr;
+	vo_render_sync(vr);
 
 	// Adjust according to chroma phase configuration
 	double mu = b_y - (r_y / tan(vr->cmp.cha_phase));
@@ -1016,6 +1455,7 @@ void vo_render_set_cmp_burst_br(void *sptr, unsigned burstn, float b_y, float r_
 
 void vo_render_set_cmp_phase_offset(void *sptr, int offset) {
 	struct vo_render *vr = sptr;
+	vo_render_sync(vr);
 	vr->cmp.phase_offset = offset;
 	update_phase_offset(vr);
 }
@@ -1030,6 +1470,7 @@ void vo_render_vsync(void *sptr) {
 	struct vo_render *vr = sptr;
 	if (!vr)
 		return;
+	vo_render_sync(vr);
 	vr->pixel = vr->buffer;
 
 	bool is_60hz = vr->ntsc_scaling && (vr->scanline < 288);
@@ -1039,8 +1480,11 @@ void vo_render_vsync(void *sptr) {
 	}
 
 	vr->scanline = 0;
-	vr->viewport.x = vr->viewport.new_x;
-	vr->viewport.y = vr->viewport.new_y;
+	if (vr->viewport.x != vr->viewport.new_x || vr->viewport.y != vr->viewport.new_y) {
+		vr->viewport.x = vr->viewport.new_x;
+		vr->viewport.y = vr->viewport.new_y;
+		vo_render_invalidate(vr);
+	}
 	vr->cmp.vswitch = !(vr->cmp.system == VO_RENDER_SYSTEM_NTSC || vr->cmp.phase == 0);
 }
 
@@ -1050,24 +1494,88 @@ void vo_render_vsync(void *sptr) {
 //
 // Time 't' not kept accurate, as scanlines are all aligned to chroma.
 
+// Get NTSC decode table for a burst, (re)building it if renderer state has
+// changed since it was last used.  Returns NULL if the table would exceed the
+// configured memory budget, in which case the caller decodes directly.
+
+static struct ntsc_lut *get_ntsc_lut(struct vo_render *vr, unsigned burstn) {
+	struct vo_render_burst *burst = &vr->cmp.burst[burstn];
+	if (!burst->ntsc_lut) {
+		if ((burstn + 1) * sizeof(struct ntsc_lut) > vr->cmp.ntsc_lut_budget)
+			return NULL;
+		burst->ntsc_lut = xmalloc(sizeof(*burst->ntsc_lut));
+		burst->ntsc_lut_generation = vr->line_cache.generation - 1;
+	}
+	if (burst->ntsc_lut_generation != vr->line_cache.generation) {
+		ntsc_lut_set(vr, burstn, burst->ntsc_lut);
+		burst->ntsc_lut_generation = vr->line_cache.generation;
+	}
+	return burst->ntsc_lut;
+}
+
+// Set NTSC decode table memory budget.  Any tables that no longer fit are
+// freed.
+
+void vo_render_set_ntsc_lut(struct vo_render *vr, int kib) {
+	vo_render_sync(vr);
+	vr->cmp.ntsc_lut_budget = (kib > 0) ? (size_t)kib * 1024 : 0;
+	for (unsigned i = 0; i < vr->cmp.nbursts; i++) {
+		struct vo_render_burst *burst = &vr->cmp.burst[i];
+		if ((i + 1) * sizeof(struct ntsc_lut) > vr->cmp.ntsc_lut_budget) {
+			free(burst->ntsc_lut);
+			burst->ntsc_lut = NULL;
+		}
+	}
+}
+
 void vo_render_cmp_partial(void *sptr, unsigned burstn, unsigned npixels, uint8_t const *data) {
 	struct vo_render *vr = sptr;
 	(void)npixels;
 
-	if (!data ||
-	    vr->scanline < vr->viewport.y ||
+	if (vr->scanline < vr->viewport.y ||
 	    vr->scanline >= (vr->viewport.y + vr->viewport.h)) {
 		vr->scanline++;
 		return;
 	}
+	if (!data) {
+		// Skipped frame: leave this line in the buffer as it was
+		vr->next_line(vr, npixels);
+		return;
+	}
 
 	if (!burstn && !vr->cmp.colour_killer)
 		burstn = 1;
 	bool decode_chroma = burstn && !vr->monochrome;
 
+	// Input is read from 3 pixels either side of the viewport.  Phase is
+	// derived from absolute position, so output doesn't depend on 't'.
+	bool hit;
+	(void)line_cache_lookup(vr, LINE_CACHE_CMP_PARTIAL, burstn, 0, 0, 0,
+				vr->viewport.x - 3, vr->viewport.x + vr->viewport.w + 3,
+				data, &hit);
+	if (hit) {
+		vr->next_line(vr, npixels);
+		return;
+	}
+
 	struct ntsc_burst *burst = &vr->cmp.burst[burstn].ntsc_burst;
 	const unsigned tmax = NTSC_NPHASES;
 
+	int_xyz rgb[912];
+	int_xyz *idest = rgb;
+
+	// Table-driven decode skips the separate encode pass
+	struct ntsc_lut *lut = decode_chroma ? get_ntsc_lut(vr, burstn) : NULL;
+	if (lut) {
+		uint8_t const *src = data + vr->viewport.x - 3;
+		for (int i = vr->viewport.x; i < (vr->viewport.x + vr->viewport.w); i++) {
+			*(idest++) = ntsc_decode_lut(lut, src++, i);
+		}
+		vr->render_rgb(vr, rgb, vr->pixel, vr->viewport.w);
+		vr->next_line(vr, npixels);
+		return;
+	}
+
 	// Encode NTSC
 	// Reuse a convenient buffer from other renderer
 	uint8_t *ntsc_dest = (uint8_t *)vr->cmp.demod.fubuf[0];
@@ -1079,8 +1587,6 @@ void vo_render_cmp_partial(void *sptr, unsigned burstn, unsigned npixels, uint8_
 
 	// Decode into intermediate RGB buffer
 	uint8_t const *src = (uint8_t *)vr->cmp.demod.fubuf[0];
-	int_xyz rgb[912];
-	int_xyz *idest = rgb;
 	if (decode_chroma) {
 		for (int i = vr->viewport.x; i < (vr->viewport.x + vr->viewport.w); i++) {
 			*(idest++) = ntsc_decode(burst, src++, i);
@@ -1096,6 +1602,93 @@ void vo_render_cmp_partial(void *sptr, unsigned burstn, unsigned npixels, uint8_
 	vr->next_line(vr, npixels);
 }
 
+// Composite kernels
+//
+// Nearly all the time spent simulating composite video goes on the per-pixel
+// arithmetic below.  Each stage is written as a simple loop over whole-line
+// arrays (filters are applied one tap at a time across the line) so that the
+// compiler can vectorise it (see simd.h).  Only integer arithmetic is used,
+// so results do not depend on vector width.
+
+// Filter 'n' values from 'in' (which must be valid from -order to n+order) to
+// 'out', shifting the result right by 'shift'.
+
+SIMD_KERNEL void cmp_fir(int *restrict out, int const *restrict in,
+			const struct vo_render_filter *f, int order,
+			int shift, unsigned n) {
+	for (unsigned i = 0; i < n; i++) {
+		out[i] = 0;
+	}
+	for (int ft = -order; ft <= order; ft++) {
+		int c = f->coeff[ft];
+		int const *restrict inft = in + ft;
+		for (unsigned i = 0; i < n; i++) {
+			out[i] += c * inft[i];
+		}
+	}
+	for (unsigned i = 0; i < n; i++) {
+		out[i] >>= shift;
+	}
+}
+
+// Y' + U sin(ωt) + V cos(ωt)
+
+SIMD_KERNEL void cmp_modulate(int *restrict mbuf, int const *restrict py,
+			     int const *restrict fu, int const *restrict fv,
+			     int const *restrict mod_u, int const *restrict mod_v,
+			     unsigned n) {
+	for (unsigned i = 0; i < n; i++) {
+		int fu_sin_wt = (fu[i] * mod_u[i]) >> 9;
+		int fv_cos_wt = (fv[i] * mod_v[i]) >> 9;
+		mbuf[i] = py[i] + fu_sin_wt + fv_cos_wt;
+	}
+}
+
+// Multiply signal by 2sin(ωt) or 2cos(ωt), preempting demodulation
+
+SIMD_KERNEL void cmp_demodulate(int *restrict out, int const *restrict mbuf,
+			       int const *restrict demod, unsigned n) {
+	for (unsigned i = 0; i < n; i++) {
+		out[i] = (mbuf[i] * demod[i]) >> 9;
+	}
+}
+
+// Average filtered chroma with the previous line's (which may be the same
+// buffer if not averaging), apply saturation & limits, and convert to R'G'B'.
+
+SIMD_KERNEL void cmp_yuv_to_rgb(struct vo_render *vr, int_xyz *restrict rgb,
+			       int const *restrict fybuf,
+			       int const *fubuf0, int const *fvbuf0,
+			       int const *fubuf1, int const *fvbuf1,
+			       unsigned n) {
+	int saturation = vr->cmp.demod.saturation;
+	int ulower = vr->cmp.demod.ulimit.lower;
+	int uupper = vr->cmp.demod.ulimit.upper;
+	int vlower = vr->cmp.demod.vlimit.lower;
+	int vupper = vr->cmp.demod.vlimit.upper;
+	int rumul = vr->cmp.demod.rconv.umul, rvmul = vr->cmp.demod.rconv.vmul;
+	int gumul = vr->cmp.demod.gconv.umul, gvmul = vr->cmp.demod.gconv.vmul;
+	int bumul = vr->cmp.demod.bconv.umul, bvmul = vr->cmp.demod.bconv.vmul;
+
+	for (unsigned i = 0; i < n; i++) {
+		int fy = fybuf[i];
+		int fu = (fubuf0[i] + fubuf1[i]) >> 1;
+		int fv = (fvbuf0[i] + fvbuf1[i]) >> 1;
+
+		// Apply saturation control
+		int ru = (fu * saturation) >> 9;
+		int rv = (fv * saturation) >> 9;
+
+		// Limits on chroma values
+		ru = (ru < ulower) ? ulower : ((ru > uupper) ? uupper : ru);
+		rv = (rv < vlower) ? vlower : ((rv > vupper) ? vupper : rv);
+
+		rgb[i].x = (fy + ru*rumul + rv*rvmul) >> 10;
+		rgb[i].y = (fy + ru*gumul + rv*gvmul) >> 10;
+		rgb[i].z = (fy + ru*bumul + rv*bvmul) >> 10;
+	}
+}
+
 // Fully simulated composite video
 //
 // Uses render_rgb(), so doesn't need to be duplicated per-type
@@ -1103,18 +1696,28 @@ void vo_render_cmp_partial(void *sptr, unsigned burstn, unsigned npixels, uint8_
 void vo_render_cmp_simulated(void *sptr, unsigned burstn, unsigned npixels, uint8_t const *data) {
 	struct vo_render *vr = sptr;
 
-	if (!data ||
-	    vr->scanline < vr->viewport.y ||
+	if (vr->scanline < vr->viewport.y ||
 	    vr->scanline >= (vr->viewport.y + vr->viewport.h)) {
 		vr->t = (vr->t + npixels) % vr->tmax;
 		vr->scanline++;
 		return;
 	}
+	if (!data) {
+		// Skipped frame: leave this line in the buffer as it was
+		vr->next_line(vr, npixels);
+		return;
+	}
 
 	// Temporary buffers
-	int mbuf[1024];  // Y' + U sin(ωt) + V cos(ωt), U/V optionally lowpassed
-	int ubuf[1024];  // mbuf * 2 sin(ωt) (lowpass to recover U)
-	int vbuf[1024];  // mbuf * 2 cos(ωt) (lowpass to recover V)
+	int pybuf[1024];  // Y'
+	int pubuf[1024];  // U, before optional lowpass
+	int pvbuf[1024];  // V, before optional lowpass
+	int fubuf[1024];  // U, optionally lowpassed
+	int fvbuf[1024];  // V, optionally lowpassed
+	int mbuf[1024];   // Y' + U sin(ωt) + V cos(ωt), U/V optionally lowpassed
+	int ubuf[1024];   // mbuf * 2 sin(ωt) (lowpass to recover U)
+	int vbuf[1024];   // mbuf * 2 cos(ωt) (lowpass to recover V)
+	int fybuf[1024];  // lowpassed mbuf, recovers Y'
 
 	if (!burstn && !vr->cmp.colour_killer)
 		burstn = 1;
@@ -1128,97 +1731,80 @@ void vo_render_cmp_simulated(void *sptr, unsigned burstn, unsigned npixels, uint
 	if (vr->cmp.average_chroma)
 		vr->cmp.vswitch = !vswitch;
 
-	// Optionally apply lowpass filters to U and V.  Modulate results.
-	for (unsigned i = vr->viewport.x - vr->cmp.demod.morder; i < (unsigned)(vr->viewport.x + vr->viewport.w + vr->cmp.demod.morder); i++) {
-		int c = data[i];
-		int py = vr->cmp.palette.y[c];
-
-		int fu, fv;
-		if (vr->cmp.mod.corder) {
-			fu = fv = 0;
-			for (int ft = -vr->cmp.mod.corder; ft <= vr->cmp.mod.corder; ft++) {
-				int ct = data[i+ft];
-				fu += vr->cmp.palette.u[ct] * vr->cmp.mod.ufilter.coeff[ft];
-				fv += vr->cmp.palette.v[ct] * vr->cmp.mod.vfilter.coeff[ft];
-			}
-			fu >>= 15;
-			fv >>= 15;
-		} else {
-			fu = vr->cmp.palette.u[c];
-			fv = vr->cmp.palette.v[c];
-		}
-
-		int fu_sin_wt = (fu * burst->mod.u[(i+t) % tmax]) >> 9;
-		int fv_cos_wt = (fv * burst->mod.v[vswitch][(i+t) % tmax]) >> 9;
-
-		mbuf[i] = py + fu_sin_wt + fv_cos_wt;
-
-		// Multiply results by 2sin(wt)/2cos(wt), preempting
-		// demodulation:
-		if (decode_chroma) {
-			ubuf[i] = (mbuf[i] * burst->demod.u[(i+t) % tmax]) >> 9;
-			vbuf[i] = (mbuf[i] * burst->demod.v[vswitch][(i+t) % tmax]) >> 9;
-		}
-	}
+	unsigned x = vr->viewport.x;
+	unsigned w = vr->viewport.w;
 
 	int *fubuf0 = vr->cmp.demod.fubuf[vswitch];
 	int *fvbuf0 = vr->cmp.demod.fvbuf[vswitch];
 	int *fubuf1 = vr->cmp.demod.fubuf[vr->cmp.vswitch];
 	int *fvbuf1 = vr->cmp.demod.fvbuf[vr->cmp.vswitch];
 
+	// Modulate enough either side of the viewport to feed the demodulation
+	// filters
+	unsigned x0 = vr->viewport.x - vr->cmp.demod.morder;
+	unsigned x1 = vr->viewport.x + vr->viewport.w + vr->cmp.demod.morder;
+	unsigned mcorder = vr->cmp.mod.corder;
+
+	// With chroma averaging, each line depends on the one before
+	bool hit;
+	struct vo_render_cached_line *cl = line_cache_lookup(vr, LINE_CACHE_CMP_SIMULATED,
+							     burstn, t, vswitch,
+							     vr->cmp.average_chroma,
+							     x0 - mcorder, x1 + mcorder,
+							     data, &hit);
+	if (hit) {
+		if (vr->cmp.average_chroma)
+			line_cache_load_chroma(cl, fubuf0, fvbuf0, x, w);
+		vr->next_line(vr, npixels);
+		return;
+	}
+
+	for (unsigned i = x0 - mcorder; i < x1 + mcorder; i++) {
+		int c = data[i];
+		pybuf[i] = vr->cmp.palette.y[c];
+		pubuf[i] = vr->cmp.palette.u[c];
+		pvbuf[i] = vr->cmp.palette.v[c];
+	}
+
+	// Optionally apply lowpass filters to U and V.  Modulate results.
+	int *fu = pubuf, *fv = pvbuf;
+	if (mcorder) {
+		cmp_fir(fubuf + x0, pubuf + x0, &vr->cmp.mod.ufilter, mcorder, 15, x1 - x0);
+		cmp_fir(fvbuf + x0, pvbuf + x0, &vr->cmp.mod.vfilter, mcorder, 15, x1 - x0);
+		fu = fubuf;
+		fv = fvbuf;
+	}
+	cmp_modulate(mbuf + x0, pybuf + x0, fu + x0, fv + x0,
+		     burst->mod.u + t + x0, burst->mod.v[vswitch] + t + x0,
+		     x1 - x0);
+
+	// fy won't be multiplied by [rgb]_conv
+	cmp_fir(fybuf + x, mbuf + x, &vr->cmp.demod.yfilter, vr->cmp.demod.yfilter.order, 15-9, w);
+
 	int_xyz rgb[1024];
 
-	for (unsigned i = vr->viewport.x; i < (unsigned)(vr->viewport.x + vr->viewport.w); i++) {
-		int fy = 0;
-		int yorder = vr->cmp.demod.yfilter.order;
-		for (int ft = -yorder; ft <= yorder; ft++) {
-			fy += vr->cmp.demod.yfilter.coeff[ft] * mbuf[i+ft];
-		}
-		fy >>= (15-9);  // fy won't be multiplied by [rgb]_conv
-
-		int fu0 = 0, fv0 = 0;
-		if (decode_chroma) {
-			int corder = vr->cmp.demod.corder;
-			for (int ft = -corder; ft <= corder; ft++) {
-				fu0 += vr->cmp.demod.ufilter.coeff[ft] * ubuf[i+ft];
-				fv0 += vr->cmp.demod.vfilter.coeff[ft] * vbuf[i+ft];
-			}
-			fu0 >>= 15;
-			fv0 >>= 15;
-		}
-		fubuf0[i] = fu0;
-		fvbuf0[i] = fv0;
-		if (!decode_chroma) {
-			fubuf1[i] = 0;
-			fvbuf1[i] = 0;
-			int y = fy >> 10;
+	if (decode_chroma) {
+		cmp_demodulate(ubuf + x0, mbuf + x0, burst->demod.u + t + x0, x1 - x0);
+		cmp_demodulate(vbuf + x0, mbuf + x0, burst->demod.v[vswitch] + t + x0, x1 - x0);
+		int corder = vr->cmp.demod.corder;
+		cmp_fir(fubuf0 + x, ubuf + x, &vr->cmp.demod.ufilter, corder, 15, w);
+		cmp_fir(fvbuf0 + x, vbuf + x, &vr->cmp.demod.vfilter, corder, 15, w);
+		cmp_yuv_to_rgb(vr, rgb + x, fybuf + x, fubuf0 + x, fvbuf0 + x,
+			       fubuf1 + x, fvbuf1 + x, w);
+	} else {
+		for (unsigned i = x; i < x + w; i++) {
+			fubuf0[i] = fvbuf0[i] = 0;
+			fubuf1[i] = fvbuf1[i] = 0;
+			int y = fybuf[i] >> 10;
 			rgb[i].x = y;
 			rgb[i].y = y;
 			rgb[i].z = y;
-			continue;
 		}
-
-		int fu1 = fubuf1[i];
-		int fu = (fu0 + fu1) >> 1;
-		int fv1 = fvbuf1[i];
-		int fv = (fv0 + fv1) >> 1;
-
-		// Apply saturation control
-		int ru = (fu * vr->cmp.demod.saturation) >> 9;
-                int rv = (fv * vr->cmp.demod.saturation) >> 9;
-
-		// Limits on chroma values
-		if (ru < vr->cmp.demod.ulimit.lower) ru = vr->cmp.demod.ulimit.lower;
-		if (ru > vr->cmp.demod.ulimit.upper) ru = vr->cmp.demod.ulimit.upper;
-		if (rv < vr->cmp.demod.vlimit.lower) rv = vr->cmp.demod.vlimit.lower;
-		if (rv > vr->cmp.demod.vlimit.upper) rv = vr->cmp.demod.vlimit.upper;
-
-		// Convert to R'G'B' in supplied output buffer
-		rgb[i].x = (fy + ru*vr->cmp.demod.rconv.umul + rv*vr->cmp.demod.rconv.vmul) >> 10;
-		rgb[i].y = (fy + ru*vr->cmp.demod.gconv.umul + rv*vr->cmp.demod.gconv.vmul) >> 10;
-		rgb[i].z = (fy + ru*vr->cmp.demod.bconv.umul + rv*vr->cmp.demod.bconv.vmul) >> 10;
 	}
 
+	if (cl && vr->cmp.average_chroma)
+		line_cache_store_chroma(vr, cl, fubuf0, fvbuf0, x, w);
+
 	// Render from intermediate RGB buffer
 	vr->render_rgb(vr, rgb + vr->viewport.x, vr->pixel, vr->viewport.w);
 	vr->next_line(vr, npixels);
@@ -153,6 +153,12 @@ extern struct xconfig_enum vo_render_system_list[];
 // Largest value of 'tmax' (and thus 't')
 #define VO_RENDER_MAX_T (228)
 
+// Modulation and demodulation tables continue beyond 'tmax' by repeating the
+// cycle, so that the composite renderer can index them as [t+i] for a whole
+// scanline (up to 1024 samples) without wrapping.
+
+#define VO_RENDER_BURST_TABLE_LEN (VO_RENDER_MAX_T + 1024)
+
 // Composite Video simulation
 //
 // The supported signals are defined as:
@@ -181,19 +187,24 @@ struct vo_render_burst {
 
 	// Values to multiply U and V at time 't' when modulating
 	struct {
-		int u[VO_RENDER_MAX_T];     // typically  sin ωt
-		int v[2][VO_RENDER_MAX_T];  // typically ±cos ωt
+		int u[VO_RENDER_BURST_TABLE_LEN];     // typically  sin ωt
+		int v[2][VO_RENDER_BURST_TABLE_LEN];  // typically ±cos ωt
 	} mod;
 
 	// Multiplied against signal and then low-pass filtered to
 	// extract U and V
 	struct {
-		int u[VO_RENDER_MAX_T];     // typically  2 sin ωt
-		int v[2][VO_RENDER_MAX_T];  // typically ±2 cos ωt
+		int u[VO_RENDER_BURST_TABLE_LEN];     // typically  2 sin ωt
+		int v[2][VO_RENDER_BURST_TABLE_LEN];  // typically ±2 cos ωt
 	} demod;
 
 	// Data for the 'partial' renderer
 	struct ntsc_burst ntsc_burst;
+
+	// Decode table for the 'partial' renderer, if within memory budget.
+	// Rebuilt when renderer generation changes.
+	struct ntsc_lut *ntsc_lut;
+	unsigned ntsc_lut_generation;
 };
 
 // Filter definition.  'coeff' actually points to the centre value, so can be
@@ -204,6 +215,11 @@ struct vo_render_filter {
 	int *coeff;
 };
 
+// Private to vo_render.c
+
+struct vo_render_cached_line;
+struct vo_render_thread;
+
 struct vo_render {
 	struct {
 		// Record values for recalculation
@@ -294,6 +310,9 @@ struct vo_render {
 		unsigned nbursts;
 		struct vo_render_burst *burst;
 
+		// Memory budget in bytes for NTSC decode tables
+		size_t ntsc_lut_budget;
+
 		// Machine defined default cross-colour phase
 		int phase_offset;
 
@@ -308,6 +327,37 @@ struct vo_render {
 		} colour[256];
 	} rgb;
 
+	// Scanline cache.  Renderers record the input that produced each line
+	// of the output buffer, and skip rendering when identical input
+	// recurs.
+	struct {
+		// Incremented whenever anything that affects output changes
+		unsigned generation;
+
+		// Records, indexed by line within viewport
+		int nlines;
+		struct vo_render_cached_line *line;
+
+		// Whether state carried into the next line (eg, PAL chroma
+		// delay) is known to match what it was when that line's
+		// record was made
+		bool chain;
+
+		// Statistics
+		unsigned hits;
+		unsigned misses;
+	} line_cache;
+
+	// Lines within the viewport that have been rendered with new output
+	// since the video module last uploaded them.  One bit per line.
+	struct {
+		int nwords;
+		uint32_t *map;
+	} dirty;
+
+	// Render thread, if enabled
+	struct vo_render_thread *thread;
+
 	// Messenger client id
 	int msgr_client_id;
 
@@ -398,9 +448,43 @@ struct vo_render *vo_render_new(int fmt);
 
 void vo_render_free(struct vo_render *vr);
 
+// Discard scanline cache.  Call if anything other than the renderer may have
+// modified the output buffer.
+
+void vo_render_invalidate(struct vo_render *vr);
+
+// Dirty line tracking.  Video modules upload only the bands of lines that
+// have changed, then clear the record.  vo_render_next_dirty() returns the
+// first line of the next dirty band at or after line y, and sets *h to its
+// height, or returns -1 if there are no more.  Call vo_render_set_dirty() if
+// the module needs the whole viewport uploaded again (eg, new texture).
+
+int vo_render_next_dirty(struct vo_render *vr, int y, int *h);
+void vo_render_clear_dirty(struct vo_render *vr);
+void vo_render_set_dirty(struct vo_render *vr);
+
+// Enable or disable rendering lines in a separate thread.  The vo module
+// routes render_line through vo_render_thread_line() so that lines are
+// queued for the thread.
+
+void vo_render_set_threaded(struct vo_render *vr, bool threaded);
+DELEGATE_T3(void, unsigned, unsigned, uint8cp) vo_render_thread_line(struct vo_render *vr, DELEGATE_T3(void, unsigned, unsigned, uint8cp) render_line);
+
+// Set memory budget in KiB for the 'partial' renderer's NTSC decode tables.
+// Bursts whose table would exceed it are decoded directly.  0 disables.
+
+void vo_render_set_ntsc_lut(struct vo_render *vr, int kib);
+
+// Wait for any queued lines to be rendered.  Call before reading the output
+// buffer or modifying renderer state from outside vo_render.c.
+
+void vo_render_sync(struct vo_render *vr);
+
 // Set buffer to render into
 inline void vo_render_set_buffer(struct vo_render *vr, void *buffer) {
+	vo_render_sync(vr);
 	vr->pixel = vr->buffer = buffer;
+	vo_render_invalidate(vr);
 }
 
 // Used by UI to adjust viewing parameters
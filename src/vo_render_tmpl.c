@@ -138,16 +138,29 @@ static void TNAME(set_palette_entry)(void *sptr, int palette, int index,
 // Render line using a palette
 
 static void TNAME(do_render_palette)(struct TNAME(vo_render) *vrt, unsigned npixels,
-				     VR_PTYPE *palette, uint8_t const *data) {
+				     int renderer, VR_PTYPE *palette, uint8_t const *data) {
 	struct vo_render *vr = &vrt->generic;
 
-	if (!data ||
-	    vr->scanline < vr->viewport.y ||
+	if (vr->scanline < vr->viewport.y ||
 	    vr->scanline >= (vr->viewport.y + vr->viewport.h)) {
 		vr->t = (vr->t + npixels) % vr->tmax;
 		vr->scanline++;
 		return;
 	}
+	if (!data) {
+		// Skipped frame: leave this line in the buffer as it was
+		TNAME(next_line)(vr, npixels);
+		return;
+	}
+
+	bool hit;
+	(void)line_cache_lookup(vr, renderer, 0, 0, 0, 0,
+				vr->viewport.x, vr->viewport.x + vr->viewport.w,
+				data, &hit);
+	if (hit) {
+		TNAME(next_line)(vr, npixels);
+		return;
+	}
 
 	uint8_t const *src = data + vr->viewport.x;
 	VR_PTYPE *dest = vr->pixel;
@@ -177,9 +190,13 @@ static void TNAME(render_cmp_palette)(void *sptr, unsigned burstn, unsigned npix
 	struct vo_render *vr = &vrt->generic;
 	if (!burstn && !vr->cmp.colour_killer)
 		burstn = 1;
-	VR_PTYPE *palette = (vr->monochrome || !burstn) ?
-	                         vrt->cmp.mono_palette : vrt->cmp.palette;
-	TNAME(do_render_palette)(vrt, npixels, palette, data);
+	if (vr->monochrome || !burstn) {
+		TNAME(do_render_palette)(vrt, npixels, LINE_CACHE_CMP_MONO_PALETTE,
+					 vrt->cmp.mono_palette, data);
+	} else {
+		TNAME(do_render_palette)(vrt, npixels, LINE_CACHE_CMP_PALETTE,
+					 vrt->cmp.palette, data);
+	}
 }
 
 // Render line using RGB palette
@@ -188,8 +205,13 @@ static void TNAME(render_rgb_palette)(void *sptr, unsigned burstn, unsigned npix
 	struct TNAME(vo_render) *vrt = sptr;
 	struct vo_render *vr = &vrt->generic;
 	(void)burstn;
-	VR_PTYPE *palette = vr->monochrome ? vrt->rgb.mono_palette : vrt->rgb.palette;
-	TNAME(do_render_palette)(vrt, npixels, palette, data);
+	if (vr->monochrome) {
+		TNAME(do_render_palette)(vrt, npixels, LINE_CACHE_RGB_MONO_PALETTE,
+					 vrt->rgb.mono_palette, data);
+	} else {
+		TNAME(do_render_palette)(vrt, npixels, LINE_CACHE_RGB_PALETTE,
+					 vrt->rgb.palette, data);
+	}
 }
 
 // Render artefact colours using simple 2-bit LUT.
@@ -203,13 +225,27 @@ static void TNAME(render_cmp_2bit)(void *sptr, unsigned burstn, unsigned npixels
 		return;
 	}
 
-	if (!data ||
-	    vr->scanline < vr->viewport.y ||
+	if (vr->scanline < vr->viewport.y ||
 	    vr->scanline >= (vr->viewport.y + vr->viewport.h)) {
 		vr->t = (vr->t + npixels) % vr->tmax;
 		vr->scanline++;
 		return;
 	}
+	if (!data) {
+		// Skipped frame: leave this line in the buffer as it was
+		TNAME(next_line)(vr, npixels);
+		return;
+	}
+
+	// Output doesn't depend on time 't'.
+	bool hit;
+	(void)line_cache_lookup(vr, LINE_CACHE_CMP_2BIT, burstn, 0, 0, 0,
+				vr->viewport.x, vr->viewport.x + vr->viewport.w,
+				data, &hit);
+	if (hit) {
+		TNAME(next_line)(vr, npixels);
+		return;
+	}
 
 	uint8_t const *src = data + vr->viewport.x;
 	VR_PTYPE *dest = vr->pixel;
@@ -253,13 +289,28 @@ static void TNAME(render_cmp_5bit)(void *sptr, unsigned burstn, unsigned npixels
 		return;
 	}
 
-	if (!data ||
-	    vr->scanline < vr->viewport.y ||
+	if (vr->scanline < vr->viewport.y ||
 	    vr->scanline >= (vr->viewport.y + vr->viewport.h)) {
 		vr->t = (vr->t + npixels) % vr->tmax;
 		vr->scanline++;
 		return;
 	}
+	if (!data) {
+		// Skipped frame: leave this line in the buffer as it was
+		TNAME(next_line)(vr, npixels);
+		return;
+	}
+
+	// Input is read from 6 pixels left of the viewport to 2 right of it.
+	// Output doesn't depend on time 't'.
+	bool hit;
+	(void)line_cache_lookup(vr, LINE_CACHE_CMP_5BIT, burstn, 0, 0, 0,
+				vr->viewport.x - 6, vr->viewport.x + vr->viewport.w + 3,
+				data, &hit);
+	if (hit) {
+		TNAME(next_line)(vr, npixels);
+		return;
+	}
 
 	uint8_t const *src = data + vr->viewport.x;
 	VR_PTYPE *dest = vr->pixel;
@@ -190,7 +190,7 @@ static void finish_init(void *sptr) {
 	// During initialisation, the UI event list is used to reschedule
 	// things that failed due to needing incomplete file transfers.
 	// Process it without checking against scheduled time.
-	while (UI_EVENT_LIST->events) {
+	while (UI_EVENT_LIST->nevents) {
 		event_dispatch_next(UI_EVENT_LIST);
 	}
 
@@ -54,6 +54,7 @@
 #include "ao.h"
 #include "auto_kbd.h"
 #include "becker.h"
+#include "capture.h"
 #include "cart.h"
 #include "crclist.h"
 #include "dkbd.h"
@@ -95,6 +96,7 @@ struct xroar xroar = {
 	// Configuration directives
 	.cfg = {
 		.ao.fragments = -1,
+		.ao.blep = 1,
 		.tape.pan = 0.5,
 		.tape.hysteresis = 1.0,
 		.tape.rewrite_gap_ms = 500,
@@ -258,6 +260,13 @@ struct private_cfg {
 		double gain;
 	} ao;
 
+	// Capture
+	struct {
+		char *video;
+		int video_fmt;
+		char *audio;
+	} capture;
+
 	// Joysticks
 	struct {
 #ifdef HAVE_WASM
@@ -335,6 +344,7 @@ static struct ui_cfg xroar_ui_cfg = {
 #else
 		.pixel_fmt = VO_RENDER_FMT_BGRA32,
 #endif
+		.ntsc_lut_kib = 1024,
 	},
 };
 
@@ -356,6 +366,7 @@ static unsigned autorun_media_slot = media_slot_none;
 /* Helper functions used by configuration */
 static void set_default_machine(const char *name);
 static void set_machine(const char *name);
+static void set_frameskip(const char *value);
 static void apply_cart_options(void);
 static void set_cart(const char *name);
 static void add_load(const char *arg);
@@ -1252,6 +1263,15 @@ struct ui_interface *xroar_init(int argc, char **argv) {
 		ui_update_state(-1, ui_tag_gain, 0, &gain_f);
 	}
 
+	// Capture
+
+	if (private_cfg.capture.video || private_cfg.capture.audio) {
+		xroar.capture = capture_new(xroar.vo_interface, private_cfg.capture.video,
+					    private_cfg.capture.video_fmt,
+					    xroar.ao_interface->sound_interface,
+					    private_cfg.capture.audio);
+	}
+
 	// Default joystick mapping
 	{
 		struct joystick_config *dfl_jc0 = NULL;
@@ -1309,6 +1329,7 @@ struct ui_interface *xroar_init(int argc, char **argv) {
 	ui_update_state(-1, ui_tag_vsync, private_cfg.vo.vsync, NULL);
 	ui_update_state(-1, ui_tag_picture, private_cfg.vo.picture, NULL);
 	ui_update_state(-1, ui_tag_fullscreen, private_cfg.vo.fullscreen, NULL);
+	ui_update_state(-1, ui_tag_frameskip, private_cfg.vo.frameskip, NULL);
 	ui_update_state(-1, ui_tag_ntsc_scaling, private_cfg.vo.ntsc_scaling, NULL);
 	ui_update_state(-1, ui_tag_brightness, private_cfg.vo.brightness, NULL);
 	ui_update_state(-1, ui_tag_contrast, private_cfg.vo.contrast, NULL);
@@ -1483,6 +1504,10 @@ void xroar_shutdown(void) {
 	machine_config_remove_all();
 	rom_meta_remove_all();
 	xroar.machine_config = NULL;
+	if (xroar.capture) {
+		capture_free(xroar.capture);
+		xroar.capture = NULL;
+	}
 	if (xroar.ao_interface) {
 		DELEGATE_SAFE_CALL(xroar.ao_interface->free);
 	}
@@ -1760,28 +1785,13 @@ void xroar_load_disk(const char *filename, int drive, bool autorun) {
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 struct xroar_timeout {
-	int seconds;
-	int cycles;
 	struct event event;
 };
 
 static void handle_timeout_event(void *sptr) {
 	struct xroar_timeout *timeout = sptr;
-	if (timeout->seconds == 0) {
-		free(timeout);
-		xroar_quit();
-	}
-	timeout->seconds--;
-	if (timeout->seconds) {
-		timeout->event.at_tick = event_current_tick + EVENT_S(1);
-	} else {
-		if (timeout->cycles == 0) {
-			free(timeout);
-			xroar_quit();
-		}
-		timeout->event.at_tick = event_current_tick + timeout->cycles;
-	}
-	event_queue(&timeout->event);
+	free(timeout);
+	xroar_quit();
 }
 
 /* Configure a timeout (period after which emulator will exit). */
@@ -1791,12 +1801,13 @@ struct xroar_timeout *xroar_set_timeout(char const *timestring) {
 	double t = strtod(timestring, NULL);
 	if (t >= 0.0) {
 		timeout = xmalloc(sizeof(*timeout));
-		timeout->seconds = (int)t;
-		timeout->cycles = EVENT_S(t - timeout->seconds);
+		int seconds = (int)t;
+		event_ticks ticks = EVENT_S(seconds) + (event_ticks)EVENT_S(t - seconds);
 		event_init(&timeout->event, MACHINE_EVENT_LIST, DELEGATE_AS0(void, handle_timeout_event, timeout));
-		/* handler can set up the first call for us... */
-		timeout->seconds++;
-		handle_timeout_event(timeout);
+		if (ticks == 0) {
+			handle_timeout_event(timeout);
+		}
+		event_queue_dt(&timeout->event, ticks);
 	}
 	return timeout;
 }
@@ -2074,7 +2085,7 @@ static void xroar_ui_set_frameskip(void *sptr, int tag, void *smsg) {
 	struct xroar *emu = sptr;
 	struct ui_state_message *uimsg = smsg;
 	assert(tag == ui_tag_frameskip);
-	if (uimsg->value < 0) {
+	if (uimsg->value < 0 && uimsg->value != UI_AUTO) {
 		uimsg->value = 0;
 	} else if (uimsg->value > 1000) {
 		uimsg->value = 1000;
@@ -2470,6 +2481,16 @@ void xroar_screenshot(void) {
 
 /* Helper functions used by configuration */
 
+// Frameskip is either a number of frames or "auto"
+
+static void set_frameskip(const char *value) {
+	if (0 == c_strcasecmp(value, "auto")) {
+		private_cfg.vo.frameskip = UI_AUTO;
+	} else {
+		private_cfg.vo.frameskip = strtol(value, NULL, 0);
+	}
+}
+
 static void set_default_machine(const char *name) {
 	free(private_cfg.default_machine);
 	private_cfg.default_machine = xstrdup(name);
@@ -3277,11 +3298,13 @@ static struct xconfig_option const xroar_options[] = {
 
 	/* Video: */
 	{ XC_SET_BOOL("fs", &private_cfg.vo.fullscreen) },
-	{ XC_SET_INT("fskip", &private_cfg.vo.frameskip) },
+	{ XC_CALL_STRING("fskip", &set_frameskip) },
 	{ XC_SET_ENUM("ccr", &private_cfg.vo.ccr, vo_cmp_ccr_list) },
 	{ XC_SET_ENUM("gl-filter", &private_cfg.vo.gl_filter, vo_gl_filter_list) },
 	{ XC_SET_BOOL("vo-vsync", &private_cfg.vo.vsync) },
 	{ XC_SET_ENUM("vo-pixel-fmt", &xroar_ui_cfg.vo_cfg.pixel_fmt, vo_pixel_fmt_list) },
+	{ XC_SET_BOOL("vo-render-thread", &xroar_ui_cfg.vo_cfg.render_thread) },
+	{ XC_SET_INT("vo-ntsc-lut", &xroar_ui_cfg.vo_cfg.ntsc_lut_kib) },
 	{ XC_SET_STRING("geometry", &xroar_ui_cfg.vo_cfg.geometry) },
 	{ XC_SET_STRING("g", &xroar_ui_cfg.vo_cfg.geometry) },
 	{ XC_SET_ENUM("vo-picture", &private_cfg.vo.picture, vo_viewport_list) },
@@ -3307,6 +3330,8 @@ static struct xconfig_option const xroar_options[] = {
 	{ XC_SET_INT("ao-fragment-frames", &xroar.cfg.ao.fragment_nframes) },
 	{ XC_SET_INT("ao-buffer-ms", &xroar.cfg.ao.buffer_ms) },
 	{ XC_SET_INT("ao-buffer-frames", &xroar.cfg.ao.buffer_nframes) },
+	{ XC_SET_INT("ao-latency-ms", &xroar.cfg.ao.latency_ms) },
+	{ XC_SET_BOOL("ao-blep", &xroar.cfg.ao.blep) },
 	{ XC_CALL_DOUBLE("ao-gain", &set_gain) },
 	{ XC_SET_INT("ao-volume", &private_cfg.ao.volume) },
 	/* Deliberately undocumented: */
@@ -3315,6 +3340,11 @@ static struct xconfig_option const xroar_options[] = {
 	{ XC_SET_INT("ao-buffer-samples", &xroar.cfg.ao.buffer_nframes), .deprecated = 1 },
 	{ XC_SET_NONE("fast-sound"), .deprecated = 1 },
 
+	/* Capture: */
+	{ XC_SET_STRING_NE("capture-video", &private_cfg.capture.video) },
+	{ XC_SET_ENUM("capture-video-fmt", &private_cfg.capture.video_fmt, capture_video_fmt_list) },
+	{ XC_SET_STRING_NE("capture-audio", &private_cfg.capture.audio) },
+
 	/* Keyboard: */
 	{ XC_SET_ENUM("kbd-layout", &private_cfg.kbd.layout, hkbd_layout_list) },
 	{ XC_SET_ENUM("kbd-lang", &private_cfg.kbd.lang, hkbd_lang_list) },
@@ -3341,6 +3371,7 @@ static struct xconfig_option const xroar_options[] = {
 
 	/* Emulator actions: */
 	{ XC_SET_BOOL("ratelimit", &private_cfg.debug.ratelimit) },
+	{ XC_SET_BOOL("idle-skip", &xroar.cfg.idle_skip) },
 	{ XC_SET_STRING_LIST("type", &private_cfg.kbd.type_list) },
 
 	/* Debugging: */
@@ -3535,11 +3566,13 @@ static void helptext(void) {
 
 " Video:\n"
 "  -fs                   start emulator full-screen if possible\n"
-"  -fskip FRAMES         frameskip (default: 0)\n"
+"  -fskip FRAMES         frameskip, or 'auto' to adapt to host speed (default: 0)\n"
 "  -ccr RENDERER         cross-colour renderer (-ccr help for list)\n"
 "  -gl-filter FILTER     OpenGL texture filter (-gl-filter help for list)\n"
 "  -vo-vsync             start with vsync enabled\n"
 "  -vo-pixel-fmt FMT     pixel format (-vo-pixel-fmt help for list)\n"
+"  -vo-render-thread     render video in a separate thread\n"
+"  -vo-ntsc-lut KIB      memory for 'partial' NTSC decode tables [1024]\n"
 "  -geometry WxH+X+Y     initial emulator geometry\n"
 "  -vo-picture P         initial picture area (-vo-picture help for list)\n"
 "  -no-vo-scale-60hz     disable vertical scaling for 60Hz video\n"
@@ -3563,10 +3596,19 @@ static void helptext(void) {
 "  -ao-fragment-frames N set audio fragment size in samples (if supported)\n"
 "  -ao-buffer-ms MS      set total audio buffer size in ms (if supported)\n"
 "  -ao-buffer-frames N   set total audio buffer size in samples (if supported)\n"
+"  -ao-latency-ms MS     set target latency of audio queue in ms (if supported)\n"
+"  -no-ao-blep           disable band-limited synthesis of DAC & single-bit sound\n"
 "  -ao-gain DB           audio gain in dB relative to 0 dBFS [-3.0]\n"
 "  -ao-volume VOLUME     older way to specify audio volume, linear (0-100)\n"
 "\n"
 
+" Capture:\n"
+"  -capture-video FILE   stream video to FILE (or named pipe)\n"
+"  -capture-video-fmt FMT\n"
+"                        video capture format (-capture-video-fmt help for list)\n"
+"  -capture-audio FILE   write audio to FILE as WAV\n"
+"\n"
+
 " Debugging:\n"
 #ifdef WANT_GDB_TARGET
 "  -gdb                  enable GDB target\n"
@@ -3575,6 +3617,7 @@ static void helptext(void) {
 "  -gdb-pseudo-regs      enable pseudo-registers (e.g. SAM, PIA) for GDB\n"
 #endif
 "  -no-ratelimit         run cpu as fast as possible\n"
+"  -idle-skip            fast-forward recognised guest idle loops\n"
 #ifdef TRACE
 "  -trace                start with trace mode on\n"
 "  -trace-timing         print timings in trace mode\n"
@@ -3734,11 +3777,17 @@ static void config_print_all(FILE *f, bool all) {
 
 	fputs("# Video\n", f);
 	xroar_cfg_print_bool(f, all, "fs", private_cfg.vo.fullscreen, 0);
-	xroar_cfg_print_int_nz(f, all, "fskip", private_cfg.vo.frameskip);
+	if (private_cfg.vo.frameskip == UI_AUTO) {
+		xroar_cfg_print_string(f, all, "fskip", "auto", NULL);
+	} else {
+		xroar_cfg_print_int_nz(f, all, "fskip", private_cfg.vo.frameskip);
+	}
 	xroar_cfg_print_enum(f, all, "ccr", private_cfg.vo.ccr, VO_CMP_CCR_5BIT, vo_cmp_ccr_list);
 	xroar_cfg_print_enum(f, all, "gl-filter", private_cfg.vo.gl_filter, ANY_AUTO, vo_gl_filter_list);
 	xroar_cfg_print_bool(f, all, "vo-vsync", private_cfg.vo.vsync, 0);
 	xroar_cfg_print_enum(f, all, "vo-pixel-fmt", xroar_ui_cfg.vo_cfg.pixel_fmt, ANY_AUTO, vo_pixel_fmt_list);
+	xroar_cfg_print_bool(f, all, "vo-render-thread", xroar_ui_cfg.vo_cfg.render_thread, 0);
+	xroar_cfg_print_int(f, all, "vo-ntsc-lut", xroar_ui_cfg.vo_cfg.ntsc_lut_kib, 1024);
 	xroar_cfg_print_string(f, all, "geometry", xroar_ui_cfg.vo_cfg.geometry, NULL);
 	xroar_cfg_print_enum(f, all, "vo-picture", private_cfg.vo.picture, UI_AUTO, vo_viewport_list);
 	xroar_cfg_print_bool(f, all, "vo-scale-60hz", private_cfg.vo.ntsc_scaling, 1);
@@ -3762,10 +3811,18 @@ static void config_print_all(FILE *f, bool all) {
 	xroar_cfg_print_int_nz(f, all, "ao-fragment-frames", xroar.cfg.ao.fragment_nframes);
 	xroar_cfg_print_int_nz(f, all, "ao-buffer-ms", xroar.cfg.ao.buffer_ms);
 	xroar_cfg_print_int_nz(f, all, "ao-buffer-frames", xroar.cfg.ao.buffer_nframes);
+	xroar_cfg_print_int_nz(f, all, "ao-latency-ms", xroar.cfg.ao.latency_ms);
+	xroar_cfg_print_bool(f, all, "ao-blep", xroar.cfg.ao.blep, 1);
 	xroar_cfg_print_double(f, all, "ao-gain", private_cfg.ao.gain, -3.0);
 	xroar_cfg_print_int(f, all, "ao-volume", private_cfg.ao.volume, -1);
 	fputs("\n", f);
 
+	fputs("# Capture\n", f);
+	xroar_cfg_print_string(f, all, "capture-video", private_cfg.capture.video, NULL);
+	xroar_cfg_print_enum(f, all, "capture-video-fmt", private_cfg.capture.video_fmt, CAPTURE_VIDEO_Y4M, capture_video_fmt_list);
+	xroar_cfg_print_string(f, all, "capture-audio", private_cfg.capture.audio, NULL);
+	fputs("\n", f);
+
 	fputs("# Keyboard\n", f);
 	xroar_cfg_print_enum(f, all, "kbd-layout", private_cfg.kbd.layout, hk_layout_auto, hkbd_layout_list);
 	xroar_cfg_print_enum(f, all, "kbd-lang", private_cfg.kbd.lang, hk_lang_auto, hkbd_lang_list);
@@ -3791,6 +3848,7 @@ static void config_print_all(FILE *f, bool all) {
 	xroar_cfg_print_string(f, all, "gdb-port", xroar.cfg.debug.gdb_port, GDB_PORT_DEFAULT);
 	// Not emitting "trace" (startup-only, assumed command-line only)
 	xroar_cfg_print_bool(f, all, "ratelimit", private_cfg.debug.ratelimit, 1);
+	xroar_cfg_print_bool(f, all, "idle-skip", xroar.cfg.idle_skip, 0);
 	xroar_cfg_print_bool(f, all, "trace-timing", logging.trace_cpu_timing, 0);
 	xroar_cfg_print_flags(f, all, "debug-fdc", logging.debug_fdc);
 	xroar_cfg_print_flags(f, all, "debug-file", logging.debug_file);
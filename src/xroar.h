@@ -28,6 +28,7 @@
 #include "xconfig.h"
 
 struct ao_interface;
+struct capture;
 struct cart;
 struct event_list;
 struct machine_config;
@@ -94,6 +95,8 @@ struct xroar_cfg {
 		int fragment_nframes;
 		int buffer_ms;
 		int buffer_nframes;
+		int latency_ms;
+		bool blep;
 	} ao;
 
 	// Keyboard
@@ -132,6 +135,9 @@ struct xroar_cfg {
 	// XXX this might make more sense as a per-machine option
 	bool force_crc_match;
 
+	// Fast-forward recognised guest idle loops
+	bool idle_skip;
+
 	// Debugging
 	struct {
 		bool gdb;
@@ -154,6 +160,7 @@ struct xroar {
 	struct ui_interface *ui_interface;
 	struct vo_interface *vo_interface;
 	struct ao_interface *ao_interface;
+	struct capture *capture;
 
 	struct machine_config *machine_config;
 	struct machine *machine;
@@ -169,7 +176,7 @@ struct xroar {
 	struct {
 		struct {
 			int picture;
-			bool frameskip;
+			int frameskip;
 		} vo;
 
 		bool ratelimit_latch;
@@ -0,0 +1,342 @@
+/** \file
+ *
+ *  \brief Check and benchmark AY-3-891x audio generation.
+ *
+ *  \copyright Copyright 2026 agent
+ *
+ *  \licenseblock This file is part of XRoar, a Dragon/Tandy CoCo emulator.
+ *
+ *  XRoar is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation, either version 3 of the License, or (at your option) any later
+ *  version.
+ *
+ *  See COPYING.GPL for redistribution conditions.
+ *
+ *  \endlicenseblock
+ *
+ *  ay891x_get_audio() generates audio in runs of constant output.  Here, two
+ *  chips are fed the same register writes at the same times, and audio is
+ *  fetched from one with ay891x_get_audio() and from the other with a
+ *  reference that steps every generator and the filter once per reference
+ *  tick.  Samples, returned values and chip state must be identical.
+ *
+ *  Register writes are either entirely random, or music-like: a few tone and
+ *  amplitude changes every 50th of a second.  With "-b", a minute of each is
+ *  also timed against the reference.
+ */
+
+#include "ay891x.c"
+#include "filter.c"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "testlib.h"
+
+#define TICK_RATE (14318180)
+#define FRAME_RATE (48000)
+#define REF_RATE (4000000)
+
+// Audio is fetched whenever a register is written, and at least this often
+#define MAX_FETCH_FRAMES (1024)
+
+#define CHECK_SECONDS (4)
+#define BENCH_SECONDS (60)
+
+struct reg_write {
+	uint32_t at_tick;
+	uint8_t reg;
+	uint8_t D;
+};
+
+static struct reg_write *reg_writes;
+static unsigned nreg_writes;
+static unsigned reg_writes_size;
+
+// Reference: steps noise, tones, envelope and filter every reference tick.
+
+static TEST_REFERENCE float ref_get_audio(void *sptr, uint32_t tick, int nframes, float *buf) {
+	struct AY891X_ *psg_ = sptr;
+
+	int nticks = psg_->nticks + tick_delta(tick, psg_->last_fragment_tick);
+	psg_->last_fragment_tick = tick;
+
+	float output = psg_->filter->output;
+	float new_output = output;
+
+	if (psg_->overrun && nframes > 0) {
+		if (buf) {
+			*(buf++) = output;
+		}
+		nframes--;
+		psg_->overrun = 0;
+	}
+
+	while (nticks > 0) {
+		psg_->frameerror += psg_->framerate;
+		if (psg_->frameerror >= psg_->refrate) {
+			psg_->frameerror -= psg_->refrate;
+			if (nframes > 0) {
+				if (buf) {
+					*(buf++) = output;
+				}
+				nframes--;
+			} else {
+				psg_->overrun = 1;
+			}
+		}
+
+		psg_->tickerror += psg_->tickrate;
+		int dtick = psg_->tickerror / psg_->refrate;
+		if (dtick > 0) {
+			nticks -= dtick;
+			psg_->tickerror -= (dtick * psg_->refrate);
+		}
+
+		psg_->noise_counter--;
+		if (psg_->noise_counter <= 0) {
+			psg_->noise_counter = psg_->noise_period;
+			unsigned shift_in = ((psg_->noise_lfsr ^ (psg_->noise_lfsr >> 3)) & 1) << 16;
+			psg_->noise_lfsr = shift_in | (psg_->noise_lfsr >> 1);
+			psg_->noise_state = psg_->noise_lfsr & 1;
+		}
+
+		for (int c = 0; c < 3; c++) {
+			if (--psg_->tone_counter[c] == 0) {
+				psg_->tone_counter[c] = psg_->tone_period[c];
+				psg_->tone_state[c] = !psg_->tone_state[c];
+			}
+			bool state = (psg_->tone_enable[c] && psg_->tone_state[c]) ||
+			              (psg_->noise_state && psg_->noise_enable[c]);
+			if (psg_->envelope_mode[c]) {
+				unsigned level = state ? psg_->envelope_level : 0;
+				psg_->level[c] = amplitude[level];
+			} else {
+				psg_->level[c] = psg_->amplitude[c][state];
+			}
+		}
+
+		psg_->envelope_counter--;
+		if (psg_->envelope_counter <= 0) {
+			psg_->envelope_counter = psg_->envelope_period;
+			envelope_step(psg_);
+		}
+
+		new_output = psg_->level[0] + psg_->level[1] + psg_->level[2];
+		output = filter_iir_apply(psg_->filter, new_output);
+	}
+
+	psg_->nticks = nticks;
+
+	if (buf) {
+		while (nframes > 0) {
+			*(buf++) = output;
+			nframes--;
+		}
+	}
+
+	return new_output;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+static void add_write(uint32_t at_tick, unsigned reg, unsigned D) {
+	if (nreg_writes >= reg_writes_size) {
+		reg_writes_size = reg_writes_size ? reg_writes_size * 2 : 1024;
+		reg_writes = xrealloc(reg_writes, reg_writes_size * sizeof(*reg_writes));
+	}
+	reg_writes[nreg_writes++] = (struct reg_write){ .at_tick = at_tick, .reg = reg, .D = D };
+}
+
+// Any register, at intervals from a few ticks to a few milliseconds.
+
+static void make_random_writes(unsigned seconds) {
+	nreg_writes = 0;
+	uint32_t t = 0;
+	while (t < (uint32_t)seconds * TICK_RATE) {
+		unsigned r = test_rand();
+		t += (r & 1) ? (r >> 8) % 256 : (r >> 8) % 65536;
+		add_write(t, (r >> 1) & 15, test_rand() >> 8);
+	}
+}
+
+// Three channels of tones, every 50th of a second changing a note or volume
+// on some of them.  Noise and envelope are occasionally enabled.
+
+static void make_music_writes(unsigned seconds) {
+	nreg_writes = 0;
+	add_write(1, 7, 0xf8);
+	add_write(2, 6, 0x08);
+	add_write(3, 11, 0x00);
+	add_write(4, 12, 0x10);
+	unsigned nframes = seconds * 50;
+	for (unsigned f = 0; f < nframes; f++) {
+		uint32_t t = 16 + f * (TICK_RATE / 50);
+		for (int c = 0; c < 3; c++) {
+			unsigned r = test_rand();
+			if ((r & 3) == 0) {
+				unsigned period = 0x40 + (r >> 8) % 0x400;
+				add_write(t++, c * 2, period & 0xff);
+				add_write(t++, c * 2 + 1, period >> 8);
+			}
+			if ((r & 0x30) == 0) {
+				add_write(t++, 8 + c, (r >> 20) & 15);
+			}
+		}
+		unsigned r = test_rand();
+		if ((r & 0x1f) == 0) {
+			// Noise on channel C for a while
+			add_write(t++, 7, (r & 0x100) ? 0xd8 : 0xf8);
+		}
+		if ((r & 0x3e0) == 0) {
+			// Enveloped note on channel A
+			add_write(t++, 8, (r & 0x400) ? 0x10 : 0x0f);
+			add_write(t++, 13, (r >> 12) & 15);
+		}
+	}
+}
+
+// Play the register writes to a chip, fetching audio with 'get_audio'.  If
+// 'out' is non-NULL, all fetched samples are written there, and returned
+// values to 'ret'.  Returns the number of fetches.
+
+typedef float (*get_audio_func)(void *, uint32_t, int, float *);
+
+static unsigned play(struct AY891X *psg, get_audio_func get_audio, float *out, float *ret) {
+	float buf[MAX_FETCH_FRAMES + 2];
+	uint32_t tick = 0;
+	uint64_t frame_acc = 0;
+	unsigned nfetch = 0;
+	unsigned w = 0;
+	uint32_t end_tick = nreg_writes ? reg_writes[nreg_writes-1].at_tick + 1000 : 0;
+	uint32_t max_dt = (uint64_t)MAX_FETCH_FRAMES * TICK_RATE / FRAME_RATE;
+	while (tick < end_tick) {
+		uint32_t next = (end_tick - tick < max_dt) ? end_tick : tick + max_dt;
+		if (w < nreg_writes && reg_writes[w].at_tick < next)
+			next = reg_writes[w].at_tick;
+		// Frames due since the last fetch, as sound.c would ask for
+		frame_acc += (uint64_t)(next - tick) * FRAME_RATE;
+		int nframes = frame_acc / TICK_RATE;
+		frame_acc %= TICK_RATE;
+		tick = next;
+		float r = get_audio(psg, tick, nframes, buf);
+		if (out) {
+			memcpy(out, buf, nframes * sizeof(float));
+			out += nframes;
+			ret[nfetch] = r;
+		}
+		nfetch++;
+		while (w < nreg_writes && reg_writes[w].at_tick == tick) {
+			uint8_t D = reg_writes[w].reg;
+			ay891x_cycle(psg, 1, 1, &D);
+			D = reg_writes[w].D;
+			ay891x_cycle(psg, 1, 0, &D);
+			w++;
+		}
+	}
+	return nfetch;
+}
+
+static struct AY891X *new_chip(void) {
+	struct part *p = ay891x_allocate();
+	ay891x_initialise(p, NULL);
+	ay891x_configure((struct AY891X *)p, REF_RATE, FRAME_RATE, TICK_RATE, 0);
+	ay891x_finish(p);
+	return (struct AY891X *)p;
+}
+
+static void free_chip(struct AY891X *psg) {
+	ay891x_free(&psg->part);
+	free(psg);
+}
+
+static void check_writes(const char *name, uint32_t seed) {
+	uint32_t end_tick = reg_writes[nreg_writes-1].at_tick + 1000;
+	unsigned max_frames = (uint64_t)end_tick * FRAME_RATE / TICK_RATE + 1;
+	unsigned max_fetch = nreg_writes + end_tick / ((uint64_t)MAX_FETCH_FRAMES * TICK_RATE / FRAME_RATE) + 2;
+	float *out[2], *ret[2];
+	struct AY891X *psg[2];
+	for (int i = 0; i < 2; i++) {
+		out[i] = xzalloc(max_frames * sizeof(float));
+		ret[i] = xzalloc(max_fetch * sizeof(float));
+		psg[i] = new_chip();
+	}
+
+	unsigned nfetch = play(psg[0], ay891x_get_audio, out[0], ret[0]);
+	play(psg[1], ref_get_audio, out[1], ret[1]);
+
+	struct AY891X_ *psg_[2] = { (struct AY891X_ *)psg[0], (struct AY891X_ *)psg[1] };
+	for (unsigned i = 0; i < max_frames; i++) {
+		if (out[0][i] != out[1][i]) {
+			test_fail("%s seed %u: sample %u is %.9g, expected %.9g\n", name, (unsigned)seed,
+				  i, out[0][i], out[1][i]);
+			break;
+		}
+	}
+	for (unsigned i = 0; i < nfetch; i++) {
+		if (ret[0][i] != ret[1][i]) {
+			test_fail("%s seed %u: fetch %u returned %.9g, expected %.9g\n", name, (unsigned)seed,
+				  i, ret[0][i], ret[1][i]);
+			break;
+		}
+	}
+	if (psg_[0]->noise_lfsr != psg_[1]->noise_lfsr ||
+	    psg_[0]->noise_counter != psg_[1]->noise_counter ||
+	    psg_[0]->envelope_counter != psg_[1]->envelope_counter ||
+	    psg_[0]->envelope_level != psg_[1]->envelope_level ||
+	    memcmp(psg_[0]->tone_counter, psg_[1]->tone_counter, sizeof(psg_[0]->tone_counter)) != 0 ||
+	    memcmp(psg_[0]->tone_state, psg_[1]->tone_state, sizeof(psg_[0]->tone_state)) != 0 ||
+	    psg_[0]->nticks != psg_[1]->nticks ||
+	    psg_[0]->tickerror != psg_[1]->tickerror ||
+	    psg_[0]->frameerror != psg_[1]->frameerror) {
+		test_fail("%s seed %u: final chip state differs\n", name, (unsigned)seed);
+	}
+
+	for (int i = 0; i < 2; i++) {
+		free(out[i]);
+		free(ret[i]);
+		free_chip(psg[i]);
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+static void bench_writes(const char *name) {
+	char label[40];
+	for (int i = 0; i < 2; i++) {
+		struct AY891X *psg = new_chip();
+		double t0 = test_time();
+		play(psg, i ? ref_get_audio : ay891x_get_audio, NULL, NULL);
+		double t = test_time() - t0;
+		snprintf(label, sizeof(label), "%s%s", i ? "ref_" : "", name);
+		printf("%-24s %8.3f s per %d s of audio\n", label, t, BENCH_SECONDS);
+		free_chip(psg);
+	}
+}
+
+static void bench(void) {
+	test_srand(1);
+	make_random_writes(BENCH_SECONDS);
+	bench_writes("random");
+	make_music_writes(BENCH_SECONDS);
+	bench_writes("music");
+}
+
+int main(int argc, char **argv) {
+	bool do_bench = (argc > 1 && strcmp(argv[1], "-b") == 0);
+
+	for (uint32_t seed = 1; seed <= 8; seed++) {
+		test_srand(seed);
+		make_random_writes(CHECK_SECONDS);
+		check_writes("random", seed);
+		make_music_writes(CHECK_SECONDS);
+		check_writes("music", seed);
+	}
+	if (test_failures() > 0)
+		return 1;
+	if (do_bench)
+		bench();
+	free(reg_writes);
+	return 0;
+}
@@ -0,0 +1,336 @@
+/** \file
+ *
+ *  \brief Check and benchmark simulated composite video rendering.
+ *
+ *  \copyright Copyright 2026 agent
+ *
+ *  \licenseblock This file is part of XRoar, a Dragon/Tandy CoCo emulator.
+ *
+ *  XRoar is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation, either version 3 of the License, or (at your option) any later
+ *  version.
+ *
+ *  See COPYING.GPL for redistribution conditions.
+ *
+ *  \endlicenseblock
+ *
+ *  vo_render_cmp_simulated() processes a scanline in whole-line kernels that
+ *  the compiler vectorises.  Here, two renderers are configured identically
+ *  and fed the same random frames: one with vo_render_cmp_simulated(), the
+ *  other with a reference that filters, modulates and demodulates a pixel at
+ *  a time.  Rendered output must be identical.
+ *
+ *  Each colour system is checked in colour and monochrome, with and without
+ *  the colour killer, and with PAL chroma phase switching.  Frames repeat in
+ *  part, so the scanline cache is also exercised.  With "-b", rendering is
+ *  timed against the reference.
+ *
+ *  Only the kernel variant selected for the machine running the test is
+ *  checked.  Where function clones are built (see simd.h), that is likely to
+ *  be the AVX2 one.
+ */
+
+#include "vo_render.c"
+#include "colourspace.c"
+#include "filter.c"
+#include "ntsc.c"
+
+#include <stdio.h>
+
+#include "array.h"
+
+#include "testlib.h"
+
+#define NFRAMES (4)
+#define NLINES (312)
+#define LINE_PIXELS (912)
+#define NCOLOURS (16)
+
+#define BENCH_FRAMES (100)
+
+static uint8_t frames[NFRAMES][NLINES][1024];
+static unsigned bursts[NFRAMES][NLINES];
+
+// Reference: the per-pixel renderer the kernels replaced.  The scanline cache
+// is not used.
+
+static TEST_REFERENCE void ref_cmp_simulated(void *sptr, unsigned burstn, unsigned npixels, uint8_t const *data) {
+	struct vo_render *vr = sptr;
+
+	if (vr->scanline < vr->viewport.y ||
+	    vr->scanline >= (vr->viewport.y + vr->viewport.h)) {
+		vr->t = (vr->t + npixels) % vr->tmax;
+		vr->scanline++;
+		return;
+	}
+
+	int mbuf[1024];
+	int ubuf[1024];
+	int vbuf[1024];
+
+	if (!burstn && !vr->cmp.colour_killer)
+		burstn = 1;
+	bool decode_chroma = burstn && !vr->monochrome;
+
+	struct vo_render_burst *burst = &vr->cmp.burst[burstn];
+	unsigned tmax = vr->tmax;
+	unsigned t = vr->t % tmax;
+
+	int vswitch = vr->cmp.vswitch;
+	if (vr->cmp.average_chroma)
+		vr->cmp.vswitch = !vswitch;
+
+	for (unsigned i = vr->viewport.x - vr->cmp.demod.morder; i < (unsigned)(vr->viewport.x + vr->viewport.w + vr->cmp.demod.morder); i++) {
+		int c = data[i];
+		int py = vr->cmp.palette.y[c];
+
+		int fu, fv;
+		if (vr->cmp.mod.corder) {
+			fu = fv = 0;
+			for (int ft = -vr->cmp.mod.corder; ft <= vr->cmp.mod.corder; ft++) {
+				int ct = data[i+ft];
+				fu += vr->cmp.palette.u[ct] * vr->cmp.mod.ufilter.coeff[ft];
+				fv += vr->cmp.palette.v[ct] * vr->cmp.mod.vfilter.coeff[ft];
+			}
+			fu >>= 15;
+			fv >>= 15;
+		} else {
+			fu = vr->cmp.palette.u[c];
+			fv = vr->cmp.palette.v[c];
+		}
+
+		int fu_sin_wt = (fu * burst->mod.u[(i+t) % tmax]) >> 9;
+		int fv_cos_wt = (fv * burst->mod.v[vswitch][(i+t) % tmax]) >> 9;
+
+		mbuf[i] = py + fu_sin_wt + fv_cos_wt;
+
+		if (decode_chroma) {
+			ubuf[i] = (mbuf[i] * burst->demod.u[(i+t) % tmax]) >> 9;
+			vbuf[i] = (mbuf[i] * burst->demod.v[vswitch][(i+t) % tmax]) >> 9;
+		}
+	}
+
+	int *fubuf0 = vr->cmp.demod.fubuf[vswitch];
+	int *fvbuf0 = vr->cmp.demod.fvbuf[vswitch];
+	int *fubuf1 = vr->cmp.demod.fubuf[vr->cmp.vswitch];
+	int *fvbuf1 = vr->cmp.demod.fvbuf[vr->cmp.vswitch];
+
+	int_xyz rgb[1024];
+
+	for (unsigned i = vr->viewport.x; i < (unsigned)(vr->viewport.x + vr->viewport.w); i++) {
+		int fy = 0;
+		int yorder = vr->cmp.demod.yfilter.order;
+		for (int ft = -yorder; ft <= yorder; ft++) {
+			fy += vr->cmp.demod.yfilter.coeff[ft] * mbuf[i+ft];
+		}
+		fy >>= (15-9);
+
+		int fu0 = 0, fv0 = 0;
+		if (decode_chroma) {
+			int corder = vr->cmp.demod.corder;
+			for (int ft = -corder; ft <= corder; ft++) {
+				fu0 += vr->cmp.demod.ufilter.coeff[ft] * ubuf[i+ft];
+				fv0 += vr->cmp.demod.vfilter.coeff[ft] * vbuf[i+ft];
+			}
+			fu0 >>= 15;
+			fv0 >>= 15;
+		}
+		fubuf0[i] = fu0;
+		fvbuf0[i] = fv0;
+		if (!decode_chroma) {
+			fubuf1[i] = 0;
+			fvbuf1[i] = 0;
+			int y = fy >> 10;
+			rgb[i].x = y;
+			rgb[i].y = y;
+			rgb[i].z = y;
+			continue;
+		}
+
+		int fu = (fu0 + fubuf1[i]) >> 1;
+		int fv = (fv0 + fvbuf1[i]) >> 1;
+
+		int ru = (fu * vr->cmp.demod.saturation) >> 9;
+		int rv = (fv * vr->cmp.demod.saturation) >> 9;
+
+		if (ru < vr->cmp.demod.ulimit.lower) ru = vr->cmp.demod.ulimit.lower;
+		if (ru > vr->cmp.demod.ulimit.upper) ru = vr->cmp.demod.ulimit.upper;
+		if (rv < vr->cmp.demod.vlimit.lower) rv = vr->cmp.demod.vlimit.lower;
+		if (rv > vr->cmp.demod.vlimit.upper) rv = vr->cmp.demod.vlimit.upper;
+
+		rgb[i].x = (fy + ru*vr->cmp.demod.rconv.umul + rv*vr->cmp.demod.rconv.vmul) >> 10;
+		rgb[i].y = (fy + ru*vr->cmp.demod.gconv.umul + rv*vr->cmp.demod.gconv.vmul) >> 10;
+		rgb[i].z = (fy + ru*vr->cmp.demod.bconv.umul + rv*vr->cmp.demod.bconv.vmul) >> 10;
+	}
+
+	vr->render_rgb(vr, rgb + vr->viewport.x, vr->pixel, vr->viewport.w);
+	vr->next_line(vr, npixels);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+struct config {
+	int fs;
+	int fsc;
+	int system;
+	bool monochrome;
+	bool colour_killer;
+	int phase;
+};
+
+// Palette and frames are random.  The second frame repeats the first, so
+// every line hits the scanline cache, and later frames repeat some lines.
+
+static void make_frames(uint32_t seed) {
+	test_srand(seed);
+	for (unsigned f = 0; f < NFRAMES; f++) {
+		for (unsigned l = 0; l < NLINES; l++) {
+			if ((f == 1) || (f > 1 && (test_rand() & 3) == 0)) {
+				memcpy(frames[f][l], frames[f-1][l], sizeof(frames[f][l]));
+				bursts[f][l] = bursts[f-1][l];
+				continue;
+			}
+			// Runs of colours, as from real video
+			unsigned c = 0;
+			for (unsigned i = 0; i < 1024; i++) {
+				if ((test_rand() & 7) == 0)
+					c = test_rand() % NCOLOURS;
+				frames[f][l][i] = c;
+			}
+			bursts[f][l] = test_rand() % 3;
+		}
+	}
+}
+
+static struct vo_render *new_renderer(const struct config *cfg, uint32_t *buffer) {
+	struct vo_render *vr = vo_render_new(VO_RENDER_FMT_RGBA8);
+	vr->buffer_pitch = vr->viewport.w;
+	vo_render_set_buffer(vr, buffer);
+	vo_render_set_active_area(vr, 190, 38, 512, 192);
+
+	vr->cmp.fs = cfg->fs;
+	vr->cmp.fsc = cfg->fsc;
+	vr->cmp.system = cfg->system;
+	vr->monochrome = cfg->monochrome;
+	vr->cmp.colour_killer = cfg->colour_killer;
+	vr->saturation = 50;
+	vr->cmp.demod.saturation = (int)(((double)vr->saturation * 512.) / 100.);
+	update_cmp_system(vr);
+
+	vo_render_set_cmp_burst(vr, 0, 0);
+	vo_render_set_cmp_burst(vr, 1, 0);
+	vo_render_set_cmp_burst(vr, 2, 180);
+	vo_render_set_cmp_phase(vr, cfg->phase);
+
+	test_srand(cfg->fs * 9 + cfg->fsc * 3 + cfg->system);
+	for (unsigned c = 0; c < NCOLOURS; c++) {
+		float y = test_randf(0.0f, 1.0f);
+		float pb = test_randf(-0.5f, 0.5f);
+		float pr = test_randf(-0.5f, 0.5f);
+		vo_render_set_cmp_palette(vr, c, y, pb, pr);
+	}
+	return vr;
+}
+
+typedef void (*render_line_func)(void *, unsigned, unsigned, uint8_t const *);
+
+static void render_frame(struct vo_render *vr, render_line_func render_line, unsigned f) {
+	vo_render_vsync(vr);
+	for (unsigned l = 0; l < NLINES; l++) {
+		render_line(vr, bursts[f][l], LINE_PIXELS, frames[f][l]);
+	}
+	vo_render_sync(vr);
+}
+
+static void check_config(const struct config *cfg, uint32_t seed) {
+	size_t buffer_size = 640 * 240;
+	uint32_t *buffer[2];
+	struct vo_render *vr[2];
+	for (int i = 0; i < 2; i++) {
+		buffer[i] = xzalloc(buffer_size * sizeof(uint32_t));
+		vr[i] = new_renderer(cfg, buffer[i]);
+	}
+
+	make_frames(seed);
+	for (unsigned f = 0; f < NFRAMES; f++) {
+		render_frame(vr[0], vo_render_cmp_simulated, f);
+		render_frame(vr[1], ref_cmp_simulated, f);
+		for (size_t i = 0; i < buffer_size; i++) {
+			if (buffer[0][i] != buffer[1][i]) {
+				test_fail("fs %d fsc %d system %d mono %d killer %d phase %d seed %u: "
+					  "frame %u pixel (%zu,%zu) is %08x, expected %08x\n",
+					  cfg->fs, cfg->fsc, cfg->system, cfg->monochrome,
+					  cfg->colour_killer, cfg->phase, (unsigned)seed, f,
+					  i % 640, i / 640, buffer[0][i], buffer[1][i]);
+				break;
+			}
+		}
+	}
+
+	for (int i = 0; i < 2; i++) {
+		vo_render_free(vr[i]);
+		free(buffer[i]);
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+static void bench_config(const char *name, const struct config *cfg) {
+	uint32_t *buffer = xzalloc(640 * 240 * sizeof(uint32_t));
+	char label[40];
+	make_frames(1);
+	for (int i = 0; i < 2; i++) {
+		struct vo_render *vr = new_renderer(cfg, buffer);
+		double t0 = test_time();
+		for (unsigned n = 0; n < BENCH_FRAMES; n++) {
+			// Always a new frame, so the scanline cache never hits
+			vo_render_invalidate(vr);
+			render_frame(vr, i ? ref_cmp_simulated : vo_render_cmp_simulated, 0);
+		}
+		double t = test_time() - t0;
+		snprintf(label, sizeof(label), "%s%s", i ? "ref_" : "", name);
+		printf("%-24s %8.3f ms/frame\n", label, t * 1e3 / BENCH_FRAMES);
+		vo_render_free(vr);
+	}
+	free(buffer);
+}
+
+static void bench(void) {
+	bench_config("pal", &(struct config){ VO_RENDER_FS_14_31818, VO_RENDER_FSC_4_43361875, VO_RENDER_SYSTEM_PAL_I, 0, 0, 180 });
+	bench_config("ntsc", &(struct config){ VO_RENDER_FS_14_31818, VO_RENDER_FSC_3_579545, VO_RENDER_SYSTEM_NTSC, 0, 0, 0 });
+}
+
+int main(int argc, char **argv) {
+	bool do_bench = (argc > 1 && strcmp(argv[1], "-b") == 0);
+
+	static const struct {
+		int fs, fsc, system;
+	} systems[] = {
+		{ VO_RENDER_FS_14_31818, VO_RENDER_FSC_4_43361875, VO_RENDER_SYSTEM_PAL_I },
+		{ VO_RENDER_FS_14_31818, VO_RENDER_FSC_3_579545, VO_RENDER_SYSTEM_NTSC },
+		{ VO_RENDER_FS_14_31818, VO_RENDER_FSC_3_579545, VO_RENDER_SYSTEM_PAL_M },
+		{ VO_RENDER_FS_14_218, VO_RENDER_FSC_4_43361875, VO_RENDER_SYSTEM_PAL_I },
+		{ VO_RENDER_FS_14_23753, VO_RENDER_FSC_3_579545, VO_RENDER_SYSTEM_NTSC },
+	};
+
+	uint32_t seed = 1;
+	for (unsigned s = 0; s < ARRAY_N_ELEMENTS(systems); s++) {
+		for (unsigned variant = 0; variant < 4; variant++) {
+			struct config cfg = {
+				.fs = systems[s].fs,
+				.fsc = systems[s].fsc,
+				.system = systems[s].system,
+				.monochrome = (variant == 1),
+				.colour_killer = (variant == 2),
+				.phase = (variant == 3) ? 0 : 180,
+			};
+			check_config(&cfg, seed++);
+		}
+	}
+	if (test_failures() > 0)
+		return 1;
+	if (do_bench)
+		bench();
+	return 0;
+}
@@ -0,0 +1,235 @@
+/** \file
+ *
+ *  \brief Check and benchmark event scheduling.
+ *
+ *  \copyright Copyright 2026 agent
+ *
+ *  \licenseblock This file is part of XRoar, a Dragon/Tandy CoCo emulator.
+ *
+ *  XRoar is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation, either version 3 of the License, or (at your option) any later
+ *  version.
+ *
+ *  See COPYING.GPL for redistribution conditions.
+ *
+ *  \endlicenseblock
+ *
+ *  The event scheduler is already part of the test library, so is exercised
+ *  through its public interface.
+ *
+ *  Events are queued, requeued and dequeued at random, and time advanced in
+ *  random steps, while a simple model tracks what should be queued.  Each
+ *  dispatched event must be the earliest the model has due, with ties going
+ *  to the first queued.  Some events requeue themselves when dispatched.  The
+ *  number queued drifts between a few and several dozen, so that the queue
+ *  changes representation in both directions.
+ *
+ *  With "-b", N events that each reschedule themselves with a different
+ *  period are run for a fixed time, with and without also rescheduling
+ *  another event from each dispatch.
+ */
+
+#include "top-config.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "array.h"
+#include "events.h"
+
+#include "testlib.h"
+
+#define NEVENTS (80)
+#define NSTEPS (1000000)
+
+struct model {
+	bool queued;
+	event_ticks at_tick;
+	uint64_t seq;
+};
+
+static struct event_list list;
+static struct event events[NEVENTS];
+static struct model model[NEVENTS];
+static uint64_t model_seq;
+static unsigned model_nqueued;
+static unsigned requeue_percent;
+
+static void model_queue(int i, event_ticks at_tick) {
+	if (!model[i].queued)
+		model_nqueued++;
+	model[i].queued = 1;
+	model[i].at_tick = at_tick;
+	model[i].seq = model_seq++;
+}
+
+static void model_dequeue(int i) {
+	if (model[i].queued)
+		model_nqueued--;
+	model[i].queued = 0;
+}
+
+// Earliest queued event in the model, or -1 if none.
+
+static int model_first(void) {
+	int first = -1;
+	for (int i = 0; i < NEVENTS; i++) {
+		if (!model[i].queued)
+			continue;
+		if (first < 0 || model[i].at_tick < model[first].at_tick ||
+		    (model[i].at_tick == model[first].at_tick && model[i].seq < model[first].seq)) {
+			first = i;
+		}
+	}
+	return first;
+}
+
+// Ticks from now, biased to small values so that many events fall due
+// together.
+
+static event_ticks random_dt(void) {
+	unsigned r = test_rand();
+	switch (r & 3) {
+	case 0:
+		return (r >> 8) % 4;
+	case 1:
+		return (r >> 8) % 64;
+	default:
+		return (r >> 8) % 4096;
+	}
+}
+
+static void queue_event(int i, event_ticks dt) {
+	event_queue_dt(&events[i], dt);
+	model_queue(i, events[i].at_tick);
+}
+
+static void dispatched(void *sptr) {
+	int i = (int)(intptr_t)sptr;
+	int expect = model_first();
+	if (i != expect) {
+		test_fail("tick %llu: dispatched event %d, expected %d\n",
+			  (unsigned long long)event_current_tick, i, expect);
+	} else if (event_current_tick != model[i].at_tick) {
+		test_fail("event %d: dispatched at tick %llu, expected %llu\n", i,
+			  (unsigned long long)event_current_tick,
+			  (unsigned long long)model[i].at_tick);
+	}
+	if (events[i].queued) {
+		test_fail("event %d: still queued when dispatched\n", i);
+	}
+	model_dequeue(i);
+	if ((test_rand() >> 8) % 100 < requeue_percent) {
+		queue_event(i, random_dt());
+	}
+}
+
+static void check_next_tick(unsigned step) {
+	int first = model_first();
+	event_ticks expect = (first >= 0) ? model[first].at_tick : UINT64_MAX;
+	if (list.nevents != model_nqueued) {
+		test_fail("step %u: %u events queued, expected %u\n", step,
+			  list.nevents, model_nqueued);
+	}
+	if (list.next_tick != expect) {
+		test_fail("step %u: next tick %llu, expected %llu\n", step,
+			  (unsigned long long)list.next_tick, (unsigned long long)expect);
+	}
+}
+
+static void check_queue(void) {
+	static const unsigned targets[] = { 4, 24, NEVENTS - 4, 12, 40, 2 };
+	test_srand(1);
+	event_current_tick = 0;
+	event_list_init(&list);
+	for (int i = 0; i < NEVENTS; i++) {
+		event_init(&events[i], &list, DELEGATE_AS0(void, dispatched, (void *)(intptr_t)i));
+	}
+
+	for (unsigned step = 0; step < NSTEPS; step++) {
+		unsigned target = targets[(step / 2000) % ARRAY_N_ELEMENTS(targets)];
+		requeue_percent = (model_nqueued < target) ? 75 : 25;
+		unsigned r = test_rand();
+		int i = (r >> 8) % NEVENTS;
+		switch (r & 3) {
+		case 0: case 1:
+			// Queue or requeue, more often when below target
+			if (model_nqueued < target || model[i].queued) {
+				queue_event(i, random_dt());
+			}
+			break;
+		case 2:
+			// Dequeue, more often when above target
+			if (model_nqueued > target || !(r & 4)) {
+				event_dequeue(&events[i]);
+				model_dequeue(i);
+			}
+			break;
+		default:
+			event_run_until(&list, event_current_tick + random_dt());
+			break;
+		}
+		check_next_tick(step);
+		if (test_failures() > 10)
+			return;
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#define BENCH_MAX_EVENTS (256)
+#define BENCH_TICKS (1 << 26)
+
+static struct event bench_events[BENCH_MAX_EVENTS];
+static unsigned bench_nevents;
+static unsigned bench_ndispatched;
+static bool bench_reschedule;
+
+static void bench_dispatched(void *sptr) {
+	int i = (int)(intptr_t)sptr;
+	bench_ndispatched++;
+	event_queue_dt(&bench_events[i], 16 * (i + 1));
+	if (bench_reschedule) {
+		// Move another event, as when an interrupt or timer is rescheduled
+		int j = (i * 7 + 1) % bench_nevents;
+		event_queue_dt(&bench_events[j], 16 * (j + 1));
+	}
+}
+
+static void bench(unsigned n, bool reschedule) {
+	struct event_list *blist = event_list_new();
+	event_current_tick = 0;
+	bench_nevents = n;
+	bench_ndispatched = 0;
+	bench_reschedule = reschedule;
+	for (unsigned i = 0; i < n; i++) {
+		event_init(&bench_events[i], blist, DELEGATE_AS0(void, bench_dispatched, (void *)(intptr_t)i));
+		event_queue_dt(&bench_events[i], 16 * (i + 1));
+	}
+	double t0 = test_time();
+	event_run_until(blist, BENCH_TICKS);
+	double t = test_time() - t0;
+	printf("%3u events%-13s %8.3f ns/dispatch\n", n, reschedule ? ", reschedule" : "",
+	       t * 1e9 / bench_ndispatched);
+	for (unsigned i = 0; i < n; i++) {
+		event_dequeue(&bench_events[i]);
+	}
+	free(blist);
+}
+
+int main(int argc, char **argv) {
+	bool do_bench = (argc > 1 && strcmp(argv[1], "-b") == 0);
+
+	check_queue();
+	if (test_failures() > 0)
+		return 1;
+	if (do_bench) {
+		static const unsigned sizes[] = { 4, 8, 16, 24, 32, 48, 64, 256 };
+		for (unsigned i = 0; i < ARRAY_N_ELEMENTS(sizes); i++) {
+			bench(sizes[i], 0);
+			bench(sizes[i], 1);
+		}
+	}
+	return 0;
+}
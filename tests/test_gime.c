@@ -0,0 +1,299 @@
+/** \file
+ *
+ *  \brief Check GIME video data fetching.
+ *
+ *  \copyright Copyright 2026 agent
+ *
+ *  \licenseblock This file is part of XRoar, a Dragon/Tandy CoCo emulator.
+ *
+ *  XRoar is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation, either version 3 of the License, or (at your option) any later
+ *  version.
+ *
+ *  See COPYING.GPL for redistribution conditions.
+ *
+ *  \endlicenseblock
+ *
+ *  Each time it renders, the GIME prefetches all the video data it will need
+ *  to reach the current time, and the CoCo 3 copies that data a RAM row at a
+ *  time with ram_read_row_be16().
+ *
+ *  First, ram_read_row_be16() is checked against byte reads with ram_a8()
+ *  for several RAM organisations.
+ *
+ *  Then, each frame is rendered twice from the same random RAM contents, with
+ *  the same random register writes at the same times.  The first run only
+ *  renders when registers are written and at the end of each line, so
+ *  prefetches long runs of data, fetched as the CoCo 3 does.  The second
+ *  renders at every tick, and has no fetch_vram_n delegate, so never
+ *  prefetches: each word is read with fetch_vram() as it is needed.  Every
+ *  emitted scanline must be identical.
+ */
+
+#include "tcc1014/tcc1014.c"
+#include "tcc1014/font-gime.c"
+
+#include <stdio.h>
+
+#include "ram.h"
+
+#include "testlib.h"
+
+extern inline uint8_t *ram_a8(struct ram *ram, unsigned bank, unsigned row, unsigned col);
+extern inline unsigned ram_read_row_be16(struct ram *ram, unsigned bank, unsigned row, unsigned col,
+					 unsigned nwords, uint16_t *dest);
+
+#define RAM_SIZE (512 * 1024)
+#define NLINES (3 * 262)
+#define MAX_WRITES (4096)
+
+struct reg_write {
+	event_ticks at_tick;
+	uint16_t A;
+	uint8_t D;
+};
+
+struct test_run {
+	struct ram *ram;
+	uint8_t (*lines)[TCC1014_tSL];
+	unsigned nlines;
+};
+
+static uint8_t ram_data[RAM_SIZE];
+static void *ram_banks[1] = { ram_data };
+static struct reg_write reg_writes[MAX_WRITES];
+static unsigned nreg_writes;
+static uint8_t lines[2][NLINES][TCC1014_tSL];
+
+// Set up RAM masks as ram.c does.  A single bank is present.
+
+static void init_ram(struct ram *ram, unsigned organisation) {
+	unsigned row_bits = RAM_ORG_R(organisation);
+	unsigned col_bits = RAM_ORG_A(organisation) - row_bits;
+	unsigned col_shift = RAM_ORG_CS(organisation);
+	*ram = (struct ram){0};
+	ram->d_width = 8;
+	ram->organisation = organisation;
+	ram->nbanks = 1;
+	ram->row_mask = (1 << row_bits) - 1;
+	ram->col_mask = col_bits ? (((1 << col_bits) - 1) << col_shift) : 0;
+	ram->col_shift = row_bits - col_shift;
+	ram->bank_nelems = 1 << RAM_ORG_A(organisation);
+	ram->d = ram_banks;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+static void test_read_row(unsigned organisation) {
+	struct ram ram;
+	init_ram(&ram, organisation);
+
+	for (int iter = 0; iter < 10000; iter++) {
+		unsigned row = (test_rand() >> 8) & ram.row_mask & ~1;
+		unsigned col = test_rand() >> 8;
+		unsigned nwords = (test_rand() >> 8) % 300;
+		uint16_t dest[300];
+
+		unsigned expect_n = ((ram.row_mask + 1) - row) / 2;
+		if (expect_n > nwords)
+			expect_n = nwords;
+		unsigned n = ram_read_row_be16(&ram, 0, row, col, nwords, dest);
+		if (n != expect_n) {
+			test_fail("org %05x row %03x col %03x: read %u words, expected %u\n",
+				  organisation, row, col, n, expect_n);
+			continue;
+		}
+		for (unsigned i = 0; i < n; i++) {
+			uint16_t expect = (*ram_a8(&ram, 0, row + i*2, col) << 8) | *ram_a8(&ram, 0, row + i*2 + 1, col);
+			if (dest[i] != expect) {
+				test_fail("org %05x row %03x col %03x: word %u is %04x, expected %04x\n",
+					  organisation, row, col, i, dest[i], expect);
+				break;
+			}
+		}
+		if (ram_read_row_be16(&ram, 1, row, col, nwords, dest) != 0) {
+			test_fail("org %05x: read from missing bank\n", organisation);
+		}
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+// Fetch video data as coco3.c does: address lines A1-A8 select the row, and
+// A9-A18 the column.
+
+static uint16_t fetch_vram(void *sptr, uint32_t A) {
+	struct test_run *run = sptr;
+	uint8_t *Vp = ram_a8(run->ram, 0, A & ~1, A >> 9);
+	return (*Vp << 8) | *(Vp+1);
+}
+
+static void fetch_vram_n(void *sptr, uint32_t A, int nwords, uint16_t *dest) {
+	struct test_run *run = sptr;
+	while (nwords > 0) {
+		unsigned n = ram_read_row_be16(run->ram, 0, A & ~1, A >> 9, nwords, dest);
+		A += n * 2;
+		dest += n;
+		nwords -= n;
+	}
+}
+
+static void render_line(void *sptr, unsigned burst, unsigned npixels, uint8_t const *data) {
+	struct test_run *run = sptr;
+	(void)burst;
+	if (run->nlines < NLINES) {
+		memcpy(run->lines[run->nlines], data, npixels);
+	}
+	run->nlines++;
+}
+
+// Advance time to 't', dispatching GIME events.  If 'per_tick' is set,
+// render at every tick along the way.
+
+static void advance(struct TCC1014_private *gime, event_ticks t, bool per_tick) {
+	if (!per_tick) {
+		event_run_until(MACHINE_EVENT_LIST, t);
+		event_current_tick = t;
+		return;
+	}
+	while (event_current_tick < t) {
+		event_ticks next = event_current_tick + 1;
+		event_run_until(MACHINE_EVENT_LIST, next);
+		event_current_tick = next;
+		render_scanline(gime, event_current_tick);
+	}
+}
+
+static void write_reg(struct TCC1014_private *gime, uint16_t A, uint8_t D) {
+	uint8_t CPUD = D;
+	gime->public.CPUD = &CPUD;
+	tcc1014_mem_cycle(&gime->public, 0, A);
+	gime->public.CPUD = NULL;
+}
+
+static void run_frames(bool is_1987, bool composite, bool per_tick, struct test_run *run) {
+	event_current_tick = 0;
+
+	struct part *p = tcc1014_allocate();
+	p->partdb = is_1987 ? &tcc1014_1987_part : &tcc1014_1986_part;
+	tcc1014_initialise(p, NULL);
+	struct TCC1014_private *gime = (struct TCC1014_private *)p;
+	gime->public.fetch_vram = DELEGATE_AS1(uint16, uint32, fetch_vram, run);
+	if (!per_tick) {
+		gime->public.fetch_vram_n = DELEGATE_AS3(void, uint32, int, uint16p, fetch_vram_n, run);
+	}
+	gime->public.render_line = DELEGATE_AS3(void, unsigned, unsigned, uint8cp, render_line, run);
+	tcc1014_finish(p);
+	tcc1014_notify_mode(&gime->public);
+	tcc1014_set_composite(&gime->public, composite);
+	tcc1014_reset(&gime->public);
+
+	// Allow the GIME to snoop VDG mode writes to PIA1 port B
+	write_reg(gime, 0xff23, 0x04);
+
+	for (unsigned i = 0; i < nreg_writes; i++) {
+		advance(gime, reg_writes[i].at_tick, per_tick);
+		write_reg(gime, reg_writes[i].A, reg_writes[i].D);
+	}
+	advance(gime, (event_ticks)(NLINES + 1) * TCC1014_tSL + 20, per_tick);
+
+	tcc1014_free(p);
+	free(p);
+}
+
+// Video-related registers, weighted towards those that affect addressing.
+
+static const uint16_t reg_addrs[] = {
+	0xff22, 0xff90, 0xff98, 0xff98, 0xff99, 0xff99, 0xff9a, 0xff9c,
+	0xff9d, 0xff9e, 0xff9f, 0xff9f, 0xff9f,
+};
+
+static void test_frames(uint32_t seed, bool is_1987, bool composite) {
+	test_srand(seed);
+
+	for (unsigned i = 0; i < RAM_SIZE; i++) {
+		ram_data[i] = test_rand() >> 8;
+	}
+
+	// Intervals between writes vary from within a byte to spanning several
+	// lines.  Sometimes a palette or SAM register is written instead.
+	//
+	// The GIME latches a write to PIA1 port B before rendering up to it,
+	// so in the first run, such a write can affect data already due to be
+	// rendered.  These writes are moved to the start of the next line,
+	// before the left border.
+	nreg_writes = 0;
+	event_ticks t = 0;
+	while (nreg_writes < MAX_WRITES) {
+		unsigned r = test_rand();
+		unsigned dt = (r & 1) ? (r >> 8) % 64 : (r >> 8) % 8192;
+		t += dt + 1;
+		uint16_t A;
+		switch ((r >> 1) & 7) {
+		case 0:
+			A = 0xffb0 + ((r >> 4) & 15);
+			break;
+		case 1:
+			A = 0xffc0 + ((r >> 4) & 15);
+			break;
+		default:
+			A = reg_addrs[(r >> 4) % ARRAY_N_ELEMENTS(reg_addrs)];
+			break;
+		}
+		if (A == 0xff22) {
+			// Lines start 10 ticks after reset
+			t = ((t + TCC1014_tSL - 10) / TCC1014_tSL) * TCC1014_tSL + 10 + (r >> 8) % 64;
+		}
+		if (t >= (event_ticks)NLINES * TCC1014_tSL)
+			break;
+		reg_writes[nreg_writes].at_tick = t;
+		reg_writes[nreg_writes].A = A;
+		reg_writes[nreg_writes].D = test_rand() >> 8;
+		nreg_writes++;
+	}
+
+	struct ram ram;
+	init_ram(&ram, RAM_ORG(19, 9, 0));
+
+	struct test_run runs[2];
+	for (int i = 0; i < 2; i++) {
+		runs[i] = (struct test_run){ .ram = &ram, .lines = lines[i] };
+		run_frames(is_1987, composite, i == 1, &runs[i]);
+	}
+
+	if (runs[0].nlines != runs[1].nlines || runs[0].nlines < NLINES) {
+		test_fail("seed %u: emitted %u and %u lines\n", (unsigned)seed,
+			  runs[0].nlines, runs[1].nlines);
+		return;
+	}
+	for (unsigned l = 0; l < NLINES; l++) {
+		for (unsigned x = 0; x < TCC1014_tSL; x++) {
+			if (lines[0][l][x] != lines[1][l][x]) {
+				test_fail("seed %u: line %u differs from pixel %u (%u != %u)\n",
+					  (unsigned)seed, l, x, lines[0][l][x], lines[1][l][x]);
+				break;
+			}
+		}
+	}
+}
+
+int main(int argc, char **argv) {
+	(void)argc;
+	(void)argv;
+
+	test_srand(1);
+	for (unsigned i = 0; i < RAM_SIZE; i++) {
+		ram_data[i] = test_rand() >> 8;
+	}
+	test_read_row(RAM_ORG(19, 9, 0));
+	test_read_row(RAM_ORG(17, 9, 0));
+	test_read_row(RAM_ORG_64Kx1);
+	test_read_row(RAM_ORG_16Kx4);
+
+	xroar.machine_events = event_list_new();
+	for (uint32_t seed = 1; seed <= 32; seed++) {
+		test_frames(seed, seed & 1, seed & 2);
+	}
+	return test_failures() > 0;
+}
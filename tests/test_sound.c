@@ -0,0 +1,224 @@
+/** \file
+ *
+ *  \brief Check and benchmark audio mixing and conversion.
+ *
+ *  \copyright Copyright 2026 agent
+ *
+ *  \licenseblock This file is part of XRoar, a Dragon/Tandy CoCo emulator.
+ *
+ *  XRoar is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation, either version 3 of the License, or (at your option) any later
+ *  version.
+ *
+ *  See COPYING.GPL for redistribution conditions.
+ *
+ *  \endlicenseblock
+ *
+ *  The mixing and sample conversion kernels in sound.c are compared against
+ *  straightforward per-frame implementations over randomised buffers, which
+ *  must produce identical output.  With "-b", each is also timed against its
+ *  reference.
+ */
+
+#include "sound.c"
+
+#include <stdio.h>
+
+#include "testlib.h"
+
+#define MAX_FRAMES (4099)
+
+// Reference implementations
+
+static TEST_REFERENCE float ref_clamp(float v) {
+	return (v < -1.0f) ? -1.0f : ((v > 1.0f) ? 1.0f : v);
+}
+
+static TEST_REFERENCE void ref_convert_u8(uint8_t *dst, const float *src, int nsamples) {
+	for (int i = 0; i < nsamples; i++)
+		dst[i] = (uint8_t)(ref_clamp(src[i]) * 0x7f + 0x80);
+}
+
+static TEST_REFERENCE void ref_convert_s8(int8_t *dst, const float *src, int nsamples) {
+	for (int i = 0; i < nsamples; i++)
+		dst[i] = (int8_t)(ref_clamp(src[i]) * 0x7f);
+}
+
+static TEST_REFERENCE void ref_convert_s16(int16_t *dst, const float *src, int nsamples) {
+	for (int i = 0; i < nsamples; i++)
+		dst[i] = (int16_t)(ref_clamp(src[i]) * 0x7fff);
+}
+
+static TEST_REFERENCE void ref_swap_s16(uint16_t *buf, int nsamples) {
+	for (int i = 0; i < nsamples; i++)
+		buf[i] = (uint16_t)((buf[i] << 8) | (buf[i] >> 8));
+}
+
+// Mixes a frame at a time, integrating band-limited steps as it goes.
+
+static TEST_REFERENCE void ref_mix_frames(struct sound_interface_private *snd, int count,
+					  const float *mux_output, const float *non_muxed_output) {
+	int nch = snd->output_nchannels;
+	float *ptr = snd->mix_buffer + snd->buffer_frame * nch;
+	float *delta = snd->blep.delta + snd->buffer_frame;
+	for (int i = 0; i < count; i++) {
+		float m;
+		if (snd->blep.enabled) {
+			if (snd->blep.nactive > 0) {
+				snd->blep.acc += delta[i];
+				delta[i] = 0.0;
+				if (--snd->blep.nactive == 0)
+					snd->blep.acc = snd->blep.level;
+			}
+			m = snd->blep.acc;
+			if (mux_output)
+				m += mux_output[i] * snd->mux_gain;
+		} else {
+			m = mux_output ? (mux_output[i] * snd->mux_gain) + snd->bus_offset : snd->bus_offset;
+		}
+		if (non_muxed_output)
+			m += non_muxed_output[i];
+		for (int c = 0; c < nch; c++)
+			ptr[i*nch+c] = (m + snd->current.external[c]) * snd->gain;
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+static float src[MAX_FRAMES];
+static float mux[MAX_FRAMES];
+static float nonmux[MAX_FRAMES];
+static float mono[MAX_FRAMES];
+static float delta[2][MAX_FRAMES];
+static float mixed[2][2 * MAX_FRAMES];
+static union { uint8_t u8[2 * MAX_FRAMES]; int8_t s8[2 * MAX_FRAMES]; int16_t s16[MAX_FRAMES]; uint16_t u16[MAX_FRAMES]; } out[2];
+
+static void fill(float *buf, int n, float lo, float hi) {
+	for (int i = 0; i < n; i++)
+		buf[i] = test_randf(lo, hi);
+}
+
+static void check_convert(int n) {
+	// Include out of range samples: conversion must saturate
+	fill(src, n, -1.5f, 1.5f);
+	convert_u8(out[0].u8, src, n);
+	ref_convert_u8(out[1].u8, src, n);
+	if (memcmp(out[0].u8, out[1].u8, n) != 0)
+		test_fail("convert_u8, %d samples\n", n);
+	convert_s8(out[0].s8, src, n);
+	ref_convert_s8(out[1].s8, src, n);
+	if (memcmp(out[0].s8, out[1].s8, n) != 0)
+		test_fail("convert_s8, %d samples\n", n);
+	convert_s16(out[0].s16, src, n);
+	ref_convert_s16(out[1].s16, src, n);
+	if (memcmp(out[0].s16, out[1].s16, n * 2) != 0)
+		test_fail("convert_s16, %d samples\n", n);
+	swap_s16(out[0].u16, n);
+	ref_swap_s16(out[1].u16, n);
+	if (memcmp(out[0].u16, out[1].u16, n * 2) != 0)
+		test_fail("swap_s16, %d samples\n", n);
+}
+
+static void init_snd(struct sound_interface_private *snd, int nch, bool blep, int d) {
+	*snd = (struct sound_interface_private){0};
+	snd->mono_buffer = mono;
+	snd->mix_buffer = mixed[d];
+	snd->output_nchannels = nch;
+	snd->mux_gain = 0.7f;
+	snd->bus_offset = 0.13f;
+	snd->gain = 1.3f;
+	snd->current.external[0] = 0.01f;
+	snd->current.external[1] = -0.02f;
+	snd->blep.enabled = blep;
+	snd->blep.delta = delta[d];
+}
+
+static void check_mix(int n) {
+	fill(mux, n, -0.5f, 0.5f);
+	fill(nonmux, n, -0.5f, 0.5f);
+	for (int nch = 1; nch <= 2; nch++) {
+		for (int variant = 0; variant < 8; variant++) {
+			bool blep = variant & 1;
+			const float *mux_output = (variant & 2) ? mux : NULL;
+			const float *non_muxed_output = (variant & 4) ? nonmux : NULL;
+			struct sound_interface_private snd[2];
+			int nactive = n ? test_rand() % (n + 8) : 0;
+			fill(delta[0], n, -0.1f, 0.1f);
+			memcpy(delta[1], delta[0], n * sizeof(float));
+			for (int d = 0; d < 2; d++) {
+				init_snd(&snd[d], nch, blep, d);
+				snd[d].blep.acc = 0.25f;
+				snd[d].blep.level = 0.5f;
+				snd[d].blep.nactive = nactive;
+			}
+			mix_frames(&snd[0], n, 1, mux_output, non_muxed_output);
+			ref_mix_frames(&snd[1], n, mux_output, non_muxed_output);
+			if (memcmp(mixed[0], mixed[1], n * nch * sizeof(float)) != 0 ||
+			    snd[0].blep.acc != snd[1].blep.acc ||
+			    snd[0].blep.nactive != snd[1].blep.nactive) {
+				test_fail("mix_frames, %d frames, %d channels, variant %d\n", n, nch, variant);
+			}
+		}
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+// Benchmarks process a typical buffer's worth of frames repeatedly.
+
+#define BENCH_FRAMES (1024)
+#define BENCH_PASSES (20000)
+
+#define BENCH(name, stmt) do { \
+		double t0 = test_time(); \
+		for (int pass = 0; pass < BENCH_PASSES; pass++) { \
+			stmt; \
+			__asm__ volatile ("" ::: "memory"); \
+		} \
+		double t = test_time() - t0; \
+		printf("%-24s %8.3f ns/frame\n", name, t * 1e9 / (BENCH_PASSES * (double)BENCH_FRAMES)); \
+	} while (0)
+
+static void bench(void) {
+	struct sound_interface_private snd;
+	fill(src, BENCH_FRAMES, -1.5f, 1.5f);
+	fill(mux, BENCH_FRAMES, -0.5f, 0.5f);
+	fill(nonmux, BENCH_FRAMES, -0.5f, 0.5f);
+
+	BENCH("convert_u8", convert_u8(out[0].u8, src, BENCH_FRAMES));
+	BENCH("ref_convert_u8", ref_convert_u8(out[1].u8, src, BENCH_FRAMES));
+	BENCH("convert_s8", convert_s8(out[0].s8, src, BENCH_FRAMES));
+	BENCH("ref_convert_s8", ref_convert_s8(out[1].s8, src, BENCH_FRAMES));
+	BENCH("convert_s16", convert_s16(out[0].s16, src, BENCH_FRAMES));
+	BENCH("ref_convert_s16", ref_convert_s16(out[1].s16, src, BENCH_FRAMES));
+	BENCH("swap_s16", swap_s16(out[0].u16, BENCH_FRAMES));
+	BENCH("ref_swap_s16", ref_swap_s16(out[1].u16, BENCH_FRAMES));
+
+	// Stereo with both muxed and non-muxed sources is the usual case
+	init_snd(&snd, 2, 0, 0);
+	BENCH("mix_frames", mix_frames(&snd, BENCH_FRAMES, 1, mux, nonmux));
+	init_snd(&snd, 2, 0, 1);
+	BENCH("ref_mix_frames", ref_mix_frames(&snd, BENCH_FRAMES, mux, nonmux));
+	init_snd(&snd, 2, 1, 0);
+	BENCH("mix_frames (blep)", mix_frames(&snd, BENCH_FRAMES, 1, mux, nonmux));
+	init_snd(&snd, 2, 1, 1);
+	BENCH("ref_mix_frames (blep)", ref_mix_frames(&snd, BENCH_FRAMES, mux, nonmux));
+}
+
+int main(int argc, char **argv) {
+	bool do_bench = (argc > 1 && strcmp(argv[1], "-b") == 0);
+
+	test_srand(1);
+	for (int iter = 0; iter < 500; iter++) {
+		// Odd lengths exercise the scalar tails of vector loops
+		int n = test_rand() % MAX_FRAMES;
+		check_convert(n);
+		check_mix(n);
+	}
+	if (test_failures() > 0)
+		return 1;
+	if (do_bench)
+		bench();
+	return 0;
+}
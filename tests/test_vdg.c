@@ -0,0 +1,184 @@
+/** \file
+ *
+ *  \brief Check VDG whole-byte rendering.
+ *
+ *  \copyright Copyright 2026 agent
+ *
+ *  \licenseblock This file is part of XRoar, a Dragon/Tandy CoCo emulator.
+ *
+ *  XRoar is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation, either version 3 of the License, or (at your option) any later
+ *  version.
+ *
+ *  See COPYING.GPL for redistribution conditions.
+ *
+ *  \endlicenseblock
+ *
+ *  The VDG renders a whole byte of active area at once (render_byte()) when
+ *  it is known that no mode change can occur partway through it.  Otherwise,
+ *  it renders two bits at a time.
+ *
+ *  Here, each frame is rendered twice from the same random VRAM contents,
+ *  with the same random mode changes at the same times.  The first run only
+ *  renders when modes change and at the end of each line, so takes the fast
+ *  path wherever it can.  The second updates the VDG every tick, so never
+ *  has a whole byte to render.  Every emitted scanline must be identical.
+ */
+
+#include "mc6847/mc6847.c"
+#include "mc6847/font-6847.c"
+#include "mc6847/font-6847t1.c"
+
+#include <stdio.h>
+
+#include "testlib.h"
+
+#define NFRAMES (3)
+#define NLINES (NFRAMES * VDG_FRAME_DURATION)
+#define MAX_MODE_CHANGES (4096)
+
+struct mode_change {
+	event_ticks at_tick;
+	unsigned mode;
+};
+
+struct test_run {
+	uint16_t *vram;
+	uint8_t (*lines)[VDG_LINE_DURATION];
+	unsigned nlines;
+};
+
+static uint16_t vram[0x10000];
+static struct mode_change mode_changes[MAX_MODE_CHANGES];
+static unsigned nmode_changes;
+static uint8_t lines[2][NLINES][VDG_LINE_DURATION];
+
+static void fetch_data(void *sptr, uint16_t A, int nwords, uint16_t *dest) {
+	struct test_run *run = sptr;
+	for (int i = 0; i < nwords; i++) {
+		dest[i] = run->vram[(uint16_t)(A + i)];
+	}
+}
+
+static void render_line(void *sptr, unsigned burst, unsigned npixels, uint8_t const *data) {
+	struct test_run *run = sptr;
+	(void)burst;
+	if (run->nlines < NLINES) {
+		memcpy(run->lines[run->nlines], data, npixels);
+	}
+	run->nlines++;
+}
+
+// Matches the calculation at the end of mc6847_set_mode().
+
+static bool mode_is_32byte(unsigned mode) {
+	bool nA_G = mode & 0x80;
+	unsigned GM = (mode >> 4) & 7;
+	return !nA_G || !(GM == 0 || ((GM & 1) && GM != 7));
+}
+
+// Advance time to 't', dispatching VDG events.  If 'per_tick' is set, update
+// the VDG at every tick along the way.
+
+static void advance(struct MC6847_private *vdg, event_ticks t, bool per_tick) {
+	if (!per_tick) {
+		event_run_until(MACHINE_EVENT_LIST, t);
+		event_current_tick = t;
+		return;
+	}
+	while (event_current_tick < t) {
+		event_ticks next = event_current_tick + 1;
+		event_run_until(MACHINE_EVENT_LIST, next);
+		event_current_tick = next;
+		mc6847_update(vdg);
+	}
+}
+
+static void run_frames(const char *variant, bool invert, bool per_tick, struct test_run *run) {
+	event_current_tick = 0;
+
+	struct part *p = mc6847_allocate();
+	mc6847_initialise(p, (void *)variant);
+	struct MC6847_private *vdg = (struct MC6847_private *)p;
+	vdg->public.fetch_data = DELEGATE_AS3(void, uint16, int, uint16p, fetch_data, run);
+	vdg->public.render_line = DELEGATE_AS3(void, unsigned, unsigned, uint8cp, render_line, run);
+	mc6847_finish(p);
+	mc6847_set_inverted_text(&vdg->public, invert);
+	mc6847_reset(&vdg->public);
+
+	for (unsigned i = 0; i < nmode_changes; i++) {
+		advance(vdg, mode_changes[i].at_tick, per_tick);
+		mc6847_set_mode(&vdg->public, mode_changes[i].mode);
+	}
+	advance(vdg, (event_ticks)NLINES * VDG_LINE_DURATION + 1, per_tick);
+
+	mc6847_free(p);
+	free(p);
+}
+
+static void test_frames(uint32_t seed, const char *variant, bool invert) {
+	test_srand(seed);
+
+	// Data includes random flag bits (INV, nA_S, EXT)
+	for (unsigned i = 0; i < 0x10000; i++) {
+		vram[i] = test_rand() & 0x7ff;
+	}
+
+	// Intervals between mode changes vary from within a byte to spanning
+	// several lines.  The VDG fetches data for as much of the line as has
+	// elapsed each time it renders, so in the first run, a mid-line switch
+	// between 16 and 32 byte modes changes what is fetched.  Such switches
+	// are moved into the following horizontal blanking period.
+	nmode_changes = 0;
+	event_ticks t = 0;
+	bool was_32byte = 1;
+	while (nmode_changes < MAX_MODE_CHANGES) {
+		unsigned r = test_rand();
+		unsigned dt = (r & 1) ? (r >> 8) % 64 : (r >> 8) % 8192;
+		unsigned mode = (test_rand() >> 8) & 0xf8;
+		t += dt + 1;
+		if (mode_is_32byte(mode) != was_32byte) {
+			t = (t / VDG_LINE_DURATION + 1) * VDG_LINE_DURATION + (r >> 8) % VDG_tHBNK;
+			was_32byte = !was_32byte;
+		}
+		if (t >= (event_ticks)NLINES * VDG_LINE_DURATION)
+			break;
+		mode_changes[nmode_changes].at_tick = t;
+		mode_changes[nmode_changes].mode = mode;
+		nmode_changes++;
+	}
+
+	struct test_run runs[2];
+	for (int i = 0; i < 2; i++) {
+		runs[i] = (struct test_run){ .vram = vram, .lines = lines[i] };
+		run_frames(variant, invert, i == 1, &runs[i]);
+	}
+
+	if (runs[0].nlines != runs[1].nlines || runs[0].nlines < NLINES) {
+		test_fail("%s seed %u: emitted %u and %u lines\n", variant ? variant : "6847",
+			  (unsigned)seed, runs[0].nlines, runs[1].nlines);
+		return;
+	}
+	for (unsigned l = 0; l < NLINES; l++) {
+		for (unsigned x = 0; x < VDG_LINE_DURATION; x++) {
+			if (lines[0][l][x] != lines[1][l][x]) {
+				test_fail("%s seed %u: line %u differs from pixel %u (%u != %u)\n",
+					  variant ? variant : "6847", (unsigned)seed, l, x,
+					  lines[0][l][x], lines[1][l][x]);
+				break;
+			}
+		}
+	}
+}
+
+int main(int argc, char **argv) {
+	(void)argc;
+	(void)argv;
+	xroar.machine_events = event_list_new();
+	for (uint32_t seed = 1; seed <= 32; seed++) {
+		test_frames(seed, NULL, seed & 1);
+		test_frames(seed, "6847T1", seed & 1);
+	}
+	return test_failures() > 0;
+}
@@ -0,0 +1,174 @@
+/** \file
+ *
+ *  \brief Support for test programs.
+ *
+ *  \copyright Copyright 2026 agent
+ *
+ *  \licenseblock This file is part of XRoar, a Dragon/Tandy CoCo emulator.
+ *
+ *  XRoar is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation, either version 3 of the License, or (at your option) any later
+ *  version.
+ *
+ *  See COPYING.GPL for redistribution conditions.
+ *
+ *  \endlicenseblock
+ */
+
+#include "top-config.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "xalloc.h"
+
+#include "debug.h"
+#include "messenger.h"
+#include "part.h"
+#include "serialise.h"
+#include "ui.h"
+#include "xroar.h"
+
+#include "testlib.h"
+
+// The real scheduler, logging and messenger are cheap to build in.
+
+#include "events.c"
+#include "logging.c"
+#include "messenger.c"
+
+struct xroar xroar;
+
+static uint32_t rand_state = 1;
+static int nfailures = 0;
+
+// Parts are created directly by calling their allocate, initialise and finish
+// functions, so need no more than zeroed memory.
+
+void *part_new(size_t psize) {
+	return xzalloc(psize);
+}
+
+// Base types referred to by parts' debug features.
+
+const struct debug_feature_type debug_feature_type_uint8 = {
+	.type = debug_feature_base_type_uint,
+	.id = "uint8",
+	.size = 1,
+};
+
+const struct debug_feature_type debug_feature_type_uint16 = {
+	.type = debug_feature_base_type_uint,
+	.id = "uint16",
+	.size = 2,
+};
+
+// Nothing is serialised.
+
+void ser_write_tag(struct ser_handle *sh, int tag, size_t length) {
+	(void)sh;
+	(void)tag;
+	(void)length;
+	abort();
+}
+
+void ser_write_close_tag(struct ser_handle *sh) {
+	(void)sh;
+	abort();
+}
+
+void ser_write(struct ser_handle *sh, int tag, const void *ptr, size_t size) {
+	(void)sh;
+	(void)tag;
+	(void)ptr;
+	(void)size;
+	abort();
+}
+
+void ser_write_uint8_untagged(struct ser_handle *sh, uint8_t v) {
+	(void)sh;
+	(void)v;
+	abort();
+}
+
+void ser_write_uint16_untagged(struct ser_handle *sh, uint16_t v) {
+	(void)sh;
+	(void)v;
+	abort();
+}
+
+uint8_t ser_read_uint8(struct ser_handle *sh) {
+	(void)sh;
+	abort();
+}
+
+uint16_t ser_read_uint16(struct ser_handle *sh) {
+	(void)sh;
+	abort();
+}
+
+void ser_read(struct ser_handle *sh, void *ptr, size_t size) {
+	(void)sh;
+	(void)ptr;
+	(void)size;
+	abort();
+}
+
+int ui_messenger_preempt_group(int client_id, int tag, messenger_notify_delegate notify) {
+	(void)client_id;
+	(void)tag;
+	(void)notify;
+	return -1;
+}
+
+// UI adjustments are not sent.
+
+int ui_msg_adjust_value_range(struct ui_state_message *uimsg, int cur, int dfl,
+			      int min, int max, unsigned flags) {
+	(void)uimsg;
+	(void)dfl;
+	(void)min;
+	(void)max;
+	(void)flags;
+	return cur;
+}
+
+void test_srand(uint32_t seed) {
+	rand_state = seed ? seed : 1;
+}
+
+// xorshift32
+
+uint32_t test_rand(void) {
+	uint32_t x = rand_state;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	return rand_state = x;
+}
+
+float test_randf(float lo, float hi) {
+	return lo + (hi - lo) * (float)(test_rand() >> 8) / (float)(1 << 24);
+}
+
+double test_time(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+int test_fail(const char *fmt, ...) {
+	va_list ap;
+	va_start(ap, fmt);
+	fputs("FAIL: ", stderr);
+	vfprintf(stderr, fmt, ap);
+	va_end(ap);
+	return ++nfailures;
+}
+
+int test_failures(void) {
+	return nfailures;
+}
@@ -0,0 +1,56 @@
+/** \file
+ *
+ *  \brief Support for test programs.
+ *
+ *  \copyright Copyright 2026 agent
+ *
+ *  \licenseblock This file is part of XRoar, a Dragon/Tandy CoCo emulator.
+ *
+ *  XRoar is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation, either version 3 of the License, or (at your option) any later
+ *  version.
+ *
+ *  See COPYING.GPL for redistribution conditions.
+ *
+ *  \endlicenseblock
+ *
+ *  Test programs build one source file from src directly (by including it, so
+ *  that static functions can be exercised), and link against the real event
+ *  scheduler, logging and messenger plus stubs for the rest of the emulator.
+ */
+
+#ifndef XROAR_TESTS_TESTLIB_H_
+#define XROAR_TESTS_TESTLIB_H_
+
+#include <stdint.h>
+
+// Reference implementations are kept out of line and, where the compiler
+// allows, scalar, so that benchmarks compare like with like.
+
+#if defined(__GNUC__) && !defined(__clang__)
+#define TEST_REFERENCE __attribute__((noinline, optimize("no-tree-vectorize")))
+#else
+#define TEST_REFERENCE __attribute__((noinline))
+#endif
+
+// Deterministic pseudo-random numbers, so that failures are reproducible.
+
+void test_srand(uint32_t seed);
+uint32_t test_rand(void);
+
+// Uniformly distributed float in [lo, hi).
+
+float test_randf(float lo, float hi);
+
+// Monotonic time in seconds, for benchmarks.
+
+double test_time(void);
+
+// Count a failed check, reporting it along with its context.  Returns the
+// running count of failures.
+
+int test_fail(const char *fmt, ...);
+int test_failures(void);
+
+#endif